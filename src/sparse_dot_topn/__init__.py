@@ -2,14 +2,55 @@
 import importlib.metadata
 
 __version__ = importlib.metadata.version("sparse_dot_topn")
-from sparse_dot_topn.api import awesome_cossim_topn, sp_matmul, sp_matmul_topn, zip_sp_matmul_topn
+from sparse_dot_topn.api import (
+    ZipAccumulator,
+    awesome_cossim_topn,
+    sp_matmul,
+    sp_matmul_masked,
+    sp_matmul_pairs,
+    sp_matmul_threshold,
+    sp_matmul_topn,
+    sp_matmul_topn_approx,
+    sp_matmul_topn_chain,
+    sp_matmul_topn_chunked,
+    sp_matmul_topn_components,
+    sp_matmul_topn_coo,
+    sp_matmul_topn_dense,
+    sp_matmul_topn_fields,
+    sp_matmul_topn_hybrid,
+    sp_matmul_topn_mutual,
+    sp_matmul_topn_semiring,
+    sp_matmul_topn_sharded,
+    sp_matmul_topn_update,
+    zip_sp_matmul_topn,
+)
+from sparse_dot_topn.executor import sp_matmul_topn_mp
 from sparse_dot_topn.lib import _sparse_dot_topn_core as _core
 from sparse_dot_topn.lib._sparse_dot_topn_core import _has_openmp_support
+from sparse_dot_topn.vectorizer import NgramTfidfVectorizer
 
 __all__ = [
+    "NgramTfidfVectorizer",
+    "ZipAccumulator",
     "awesome_cossim_topn",
     "sp_matmul",
+    "sp_matmul_masked",
+    "sp_matmul_pairs",
+    "sp_matmul_threshold",
     "sp_matmul_topn",
+    "sp_matmul_topn_approx",
+    "sp_matmul_topn_chain",
+    "sp_matmul_topn_chunked",
+    "sp_matmul_topn_components",
+    "sp_matmul_topn_coo",
+    "sp_matmul_topn_dense",
+    "sp_matmul_topn_fields",
+    "sp_matmul_topn_hybrid",
+    "sp_matmul_topn_mp",
+    "sp_matmul_topn_mutual",
+    "sp_matmul_topn_semiring",
+    "sp_matmul_topn_sharded",
+    "sp_matmul_topn_update",
     "zip_sp_matmul_topn",
     "_core",
     "__version__",
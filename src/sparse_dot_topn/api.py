@@ -1,20 +1,51 @@
 # Copyright (c) 2023 ING Analytics Wholesale Banking
 from __future__ import annotations
 
+import threading
 import warnings
-from typing import TYPE_CHECKING
+from pathlib import Path
+from typing import TYPE_CHECKING, Callable, Sequence
 
 import numpy as np
 import psutil
 from scipy.sparse import coo_matrix, csc_matrix, csr_matrix
 
 from sparse_dot_topn.lib import _sparse_dot_topn_core as _core
-from sparse_dot_topn.types import assert_idx_dtype, assert_supported_dtype, ensure_compatible_dtype
+from sparse_dot_topn.storage import CSRWriter, load_csr_shards
+from sparse_dot_topn.types import (
+    assert_idx_dtype,
+    assert_supported_dtype,
+    ensure_compatible_dtype,
+    is_supported_dtype,
+)
 
 if TYPE_CHECKING:
-    from numpy.types import DTypeLike
+    from os import PathLike
 
-__all__ = ["sp_matmul", "sp_matmul_topn", "awesome_cossim_topn"]
+    from numpy.types import ArrayLike, DTypeLike, NDArray
+
+__all__ = [
+    "ZipAccumulator",
+    "sp_matmul",
+    "sp_matmul_masked",
+    "sp_matmul_pairs",
+    "sp_matmul_threshold",
+    "sp_matmul_topn",
+    "sp_matmul_topn_approx",
+    "sp_matmul_topn_chain",
+    "sp_matmul_topn_chunked",
+    "sp_matmul_topn_components",
+    "sp_matmul_topn_coo",
+    "sp_matmul_topn_dense",
+    "sp_matmul_topn_fields",
+    "sp_matmul_topn_hybrid",
+    "sp_matmul_topn_mutual",
+    "sp_matmul_topn_semiring",
+    "sp_matmul_topn_sharded",
+    "sp_matmul_topn_update",
+    "zip_sp_matmul_topn",
+    "awesome_cossim_topn",
+]
 
 
 _N_CORES = psutil.cpu_count(logical=False) - 1
@@ -22,6 +53,166 @@ _N_CORES = psutil.cpu_count(logical=False) - 1
 _SUPPORTED_DTYPES = {np.dtype("int32"), np.dtype("int64"), np.dtype("float32"), np.dtype("float64")}
 
 
+def _to_csr_result(
+    C: tuple[NDArray, NDArray, NDArray], shape: tuple[int, int], canonical: bool = False
+) -> csr_matrix:
+    """Wrap the arrays returned by the extension in a CSR matrix without copies.
+
+    The constructor of `csr_matrix` casts `indices` and `indptr` to a shared dtype,
+    the arrays are assigned directly to retain a 64bit `indptr` with 32bit `indices`.
+    When `canonical` the rows were emitted with sorted, unique, column indices and
+    the matrix is flagged as such so scipy does not check or sort them again.
+    """
+    C_data, C_indices, C_indptr = C
+    if C_indices.dtype == C_indptr.dtype:
+        C_mat = csr_matrix((C_data, C_indices, C_indptr), shape=shape)
+    else:
+        C_mat = csr_matrix(shape, dtype=C_data.dtype)
+        C_mat.data = C_data
+        C_mat.indices = C_indices
+        C_mat.indptr = C_indptr
+    if canonical:
+        C_mat.has_canonical_format = True
+    return C_mat
+
+
+def _csr_transpose(M: csr_matrix, n_threads: int = 1) -> csr_matrix:
+    """Compute `M.T` in CSR format, i.e. convert `M` to CSC, using the extension.
+
+    This replaces `M.transpose().tocsr()` which is single-threaded in scipy.
+    A CSC matrix `M` can be converted to CSR with `_csr_transpose(M.transpose())`
+    as the transpose of a CSC matrix is a zero-copy CSR view.
+    """
+    if not is_supported_dtype(M.dtype):
+        return M.transpose().tocsr(False)
+    kwargs = {
+        "nrows": M.shape[0],
+        "ncols": M.shape[1],
+        "M_data": M.data,
+        "M_indptr": M.indptr.astype(np.result_type(M.indptr, M.indices), copy=False),
+        "M_indices": M.indices,
+    }
+    func = _core.csr_transpose
+    if n_threads > 1 and _core._has_openmp_support:
+        kwargs["n_threads"] = n_threads
+        func = _core.csr_transpose_mt
+    return _to_csr_result(func(**kwargs), shape=(M.shape[1], M.shape[0]))
+
+
+def _to_csr_operands(
+    A: csr_matrix | csc_matrix | coo_matrix, B: csr_matrix | csc_matrix | coo_matrix, n_threads: int = 1
+) -> tuple[csr_matrix, csr_matrix]:
+    """Convert `A` and `B` to CSR matrices such that `A.shape[1] == B.shape[0]`.
+
+    CSC operands and a CSR `B` in the `A * B.T` orientation are transposed with
+    `n_threads` threads by the extension rather than converted by scipy.
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+        ValueError: when the shapes of A and B are not compatible
+
+    """
+    if isinstance(A, csc_matrix) and isinstance(B, csc_matrix) and A.shape[0] == B.shape[1]:
+        A = A.transpose()
+        B = B.transpose()
+    elif isinstance(A, csc_matrix):
+        A = _csr_transpose(A.transpose(), n_threads)
+    elif isinstance(A, coo_matrix):
+        A = A.tocsr(False)
+    elif not isinstance(A, csr_matrix):
+        msg = f"type of `A` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(A)}`"
+        raise TypeError(msg)
+
+    if not isinstance(B, (csr_matrix, coo_matrix, csc_matrix)):
+        msg = f"type of `B` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(B)}`"
+        raise TypeError(msg)
+
+    A_ncols = A.shape[1]
+    B_nrows, B_ncols = B.shape
+
+    if A_ncols == B_nrows:
+        if isinstance(B, csc_matrix):
+            B = _csr_transpose(B.transpose(), n_threads)
+        elif isinstance(B, coo_matrix):
+            B = B.tocsr(False)
+    elif A_ncols == B_ncols:
+        if isinstance(B, csc_matrix):
+            B = B.transpose()
+        elif isinstance(B, csr_matrix):
+            B = _csr_transpose(B, n_threads)
+        else:
+            B = B.transpose().tocsr(False)
+    else:
+        msg = (
+            "Matrices `A` and `B` have incompatible shapes. `A.shape[1]` must be equal to `B.shape[0]` or `B.shape[1]`."
+        )
+        raise ValueError(msg)
+    return A, B
+
+
+def _index_arrays(
+    A: csr_matrix, B: csr_matrix, idx_dtype: DTypeLike | None = None
+) -> tuple[NDArray, NDArray, NDArray, NDArray]:
+    """Select the index arrays of `A` and `B` passed to the extension.
+
+    When `idx_dtype` is `None` the arrays are used as is, the column indices and
+    the index pointers are only widened when `A` and `B` disagree. An explicit
+    `idx_dtype` is not applied to index pointers whose values exceed its range. This keeps the
+    (int64 `indptr`, int32 `indices`) layout scipy uses for matrices with more than
+    2^31 non-zero elements without copying the indices.
+
+    Returns:
+        A_indptr, A_indices, B_indptr, B_indices
+
+    """
+    if idx_dtype is None:
+        idx_dtype = np.result_type(A.indices, B.indices)
+        ptr_dtype = np.result_type(A.indptr, B.indptr, idx_dtype)
+    elif max(int(A.indptr[-1]), int(B.indptr[-1])) > np.iinfo(idx_dtype).max:
+        # never truncate an index pointer that does not fit `idx_dtype`
+        ptr_dtype = np.result_type(A.indptr, B.indptr, idx_dtype)
+    else:
+        ptr_dtype = idx_dtype
+    return (
+        A.indptr.astype(ptr_dtype, copy=False),
+        A.indices.astype(idx_dtype, copy=False),
+        B.indptr.astype(ptr_dtype, copy=False),
+        B.indices.astype(idx_dtype, copy=False),
+    )
+
+
+def _widen_indptr(
+    A_indptr: NDArray,
+    A_indices: NDArray,
+    B_indptr: NDArray,
+    nrows: int,
+    ncols: int,
+    top_n: int | None = None,
+    max_nnz: int | None = None,
+) -> tuple[NDArray, NDArray]:
+    """Widen the index pointers to 64bit when the number of non-zero elements of C can exceed their range.
+
+    The column indices are bounded by the number of columns and are kept as is,
+    such that C is returned with 64bit `indptr` and 32bit `indices`.
+    `max_nnz` overrides the bound of `top_n` elements per row, e.g. for a top n per column.
+
+    Returns:
+        A_indptr, B_indptr
+
+    """
+    limit = np.iinfo(A_indptr.dtype).max
+    if max_nnz is None:
+        max_nnz = nrows * (ncols if top_n is None else min(top_n, ncols))
+    if max_nnz <= limit:
+        return A_indptr, B_indptr
+    # the number of non-zero elements of row i of C is bounded by the sum of
+    # the lengths of the rows of B selected by row i of A
+    bound = int(np.diff(B_indptr)[A_indices].sum(dtype=np.int64))
+    if min(bound, max_nnz) <= limit:
+        return A_indptr, B_indptr
+    return A_indptr.astype(np.int64), B_indptr.astype(np.int64)
+
+
 def awesome_cossim_topn(
     A, B, ntop, lower_bound=0, use_threads=False, n_jobs=1, return_best_ntop=None, test_nnz_max=None
 ):
@@ -78,6 +269,7 @@ def sp_matmul(
     B: csr_matrix | csc_matrix | coo_matrix,
     n_threads: int | None = None,
     idx_dtype: DTypeLike | None = None,
+    sort_indices: bool = False,
 ) -> csr_matrix:
     """Compute A * B whilst only storing the `top_n` elements.
 
@@ -91,7 +283,10 @@ def sp_matmul(
             `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
             Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
         n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
-        idx_dtype: dtype to use for the indices, defaults to 32bit integers
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`.
+            A 64bit `indptr` with 32bit `indices` is used without copies and retained in C.
+        sort_indices: return C in canonical format where the column indices of each row are sorted,
+            otherwise the columns are in the order they were first set
 
     Throws:
         TypeError: when A, B are not trivially convertable to a `CSR matrix`
@@ -100,70 +295,49 @@ def sp_matmul(
         C: result matrix
 
     """
-    idx_dtype = assert_idx_dtype(idx_dtype)
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
     n_threads: int = n_threads or 1
     if n_threads < 0:
         n_threads = _N_CORES
 
-    if isinstance(A, csc_matrix) and isinstance(B, csc_matrix) and A.shape[0] == B.shape[1]:
-        A = A.transpose()
-        B = B.transpose()
-    elif isinstance(A, (coo_matrix, csc_matrix)):
-        A = A.tocsr(False)
-    elif not isinstance(A, csr_matrix):
-        msg = f"type of `A` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(A)}`"
-        raise TypeError(msg)
-
-    if not isinstance(B, (csr_matrix, coo_matrix, csc_matrix)):
-        msg = f"type of `B` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(B)}`"
-        raise TypeError(msg)
-
-    A_nrows, A_ncols = A.shape
-    B_nrows, B_ncols = B.shape
-
-    if A_ncols == B_nrows:
-        if isinstance(B, (coo_matrix, csc_matrix)):
-            B = B.tocsr(False)
-    elif A_ncols == B_ncols:
-        B = B.transpose() if isinstance(B, csc_matrix) else B.transpose().tocsr(False)
-        B_nrows, B_ncols = B.shape
-    else:
-        msg = (
-            "Matrices `A` and `B` have incompatible shapes. `A.shape[1]` must be equal to `B.shape[0]` or `B.shape[1]`."
-        )
-        raise ValueError(msg)
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
 
     assert_supported_dtype(A)
     assert_supported_dtype(B)
     ensure_compatible_dtype(A, B)
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
 
     # basic check. if A or B are all zeros matrix, return all zero matrix directly
     if A.indices.size == 0 or B.indices.size == 0:
-        C_indptr = np.zeros(A_nrows + 1, dtype=idx_dtype)
-        C_indices = np.zeros(1, dtype=idx_dtype)
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        C_indices = np.zeros(1, dtype=A_indices.dtype)
         C_data = np.zeros(1, dtype=A.dtype)
-        return csr_matrix((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+    A_indptr, B_indptr = _widen_indptr(A_indptr, A_indices, B_indptr, A_nrows, B_ncols)
 
     kwargs = {
         "nrows": A_nrows,
         "ncols": B_ncols,
         "A_data": A.data,
-        "A_indptr": A.indptr if idx_dtype is None else A.indptr.astype(idx_dtype),
-        "A_indices": A.indices if idx_dtype is None else A.indices.astype(idx_dtype),
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
         "B_data": B.data,
-        "B_indptr": B.indptr if idx_dtype is None else B.indptr.astype(idx_dtype),
-        "B_indices": B.indices if idx_dtype is None else B.indices.astype(idx_dtype),
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
     }
 
-    func = _core.sp_matmul
+    func = _core.sp_matmul if not sort_indices else _core.sp_matmul_canonical
     if n_threads > 1:
         if _core._has_openmp_support:
             kwargs["n_threads"] = n_threads
-            func = _core.sp_matmul_mt
+            func = _core.sp_matmul_mt if not sort_indices else _core.sp_matmul_canonical_mt
         else:
             msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
             warnings.warn(msg, stacklevel=1)
-    return csr_matrix(func(**kwargs), shape=(A_nrows, B_ncols))
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols), canonical=sort_indices)
 
 
 def sp_matmul_topn(
@@ -175,6 +349,9 @@ def sp_matmul_topn(
     density: float | None = None,
     n_threads: int | None = None,
     idx_dtype: DTypeLike | None = None,
+    sort_indices: bool = False,
+    acc_dtype: DTypeLike | None = None,
+    value_dtype: DTypeLike | None = None,
 ) -> csr_matrix:
     """Compute A * B whilst only storing the `top_n` elements.
 
@@ -193,11 +370,22 @@ def sp_matmul_topn(
         density: the expected density of the result considering `top_n`. The expected number of non-zero elements
             in C should <= (`density` * `top_n` * `A.shape[0]`) otherwise the memory has to reallocated.
             This value should only be set if you have a strong expectation as being wrong incurs a realloaction penalty.
+            Defaults to an upper bound on the number of non-zero elements computed from the index pointer of `B`,
+            the unused memory is released after the product.
         n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
-        idx_dtype: dtype to use for the indices, defaults to 32bit integers
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`.
+            A 64bit `indptr` with 32bit `indices` is used without copies and retained in C.
+        sort_indices: return C in canonical format where the column indices of each row are sorted,
+            cannot be combined with `sort`
+        acc_dtype: dtype used to accumulate the products, must be `float32` or `float64` and at least as wide
+            as the dtype of `A`, defaults to the dtype of `A`. E.g. float32 inputs accumulated in float64 for long rows.
+        value_dtype: dtype of the values of C, must be `float32` or `float64`, defaults to `acc_dtype`.
+            E.g. int32 counts returned as float32 scores or a float64 accumulation stored as float32.
 
     Throws:
         TypeError: when A, B are not trivially convertable to a `CSR matrix`
+        ValueError: when both `sort` and `sort_indices` are set
+        ValueError: when `acc_dtype` or `value_dtype` is not supported
 
     Returns:
         C: result matrix
@@ -206,57 +394,56 @@ def sp_matmul_topn(
     n_threads: int = n_threads or 1
     if n_threads < 0:
         n_threads = _N_CORES
-    density: float = density or 1.0
-    idx_dtype = assert_idx_dtype(idx_dtype)
-
-    if isinstance(A, csc_matrix) and isinstance(B, csc_matrix) and A.shape[0] == B.shape[1]:
-        A = A.transpose()
-        B = B.transpose()
-    elif isinstance(A, (coo_matrix, csc_matrix)):
-        A = A.tocsr(False)
-    elif not isinstance(A, csr_matrix):
-        msg = f"type of `A` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(A)}`"
-        raise TypeError(msg)
-
-    if not isinstance(B, (csr_matrix, coo_matrix, csc_matrix)):
-        msg = f"type of `B` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(B)}`"
-        raise TypeError(msg)
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+    if sort and sort_indices:
+        msg = "`sort` and `sort_indices` are mutually exclusive."
+        raise ValueError(msg)
 
-    A_nrows, A_ncols = A.shape
-    B_nrows, B_ncols = B.shape
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
 
-    if A_ncols == B_nrows:
-        if isinstance(B, (coo_matrix, csc_matrix)):
-            B = B.tocsr(False)
-    elif A_ncols == B_ncols:
-        B = B.transpose() if isinstance(B, csc_matrix) else B.transpose().tocsr(False)
-        B_nrows, B_ncols = B.shape
+    acc_dtype = A.dtype if acc_dtype is None else np.dtype(acc_dtype)
+    value_dtype = acc_dtype if value_dtype is None else np.dtype(value_dtype)
+    if acc_dtype == A.dtype:
+        acc_dtype_name = ""
+    elif acc_dtype in (np.float32, np.float64) and acc_dtype.itemsize >= A.dtype.itemsize:
+        acc_dtype_name = acc_dtype.name
     else:
-        msg = (
-            "Matrices `A` and `B` have incompatible shapes. `A.shape[1]` must be equal to `B.shape[0]` or `B.shape[1]`."
-        )
+        msg = f"`acc_dtype` must be float32, float64 or the dtype of `A` and not narrower than `A`, got: {acc_dtype}"
         raise ValueError(msg)
+    if value_dtype == acc_dtype:
+        value_dtype_name = ""
+    elif value_dtype in (np.float32, np.float64):
+        value_dtype_name = value_dtype.name
+    else:
+        msg = f"`value_dtype` must be float32, float64 or `acc_dtype`, got: {value_dtype}"
+        raise ValueError(msg)
+    mixed_dtype = bool(acc_dtype_name or value_dtype_name)
 
-    if B_ncols == top_n and (sort is False) and (threshold is None):
-        return sp_matmul(A, B, n_threads)
+    if B_ncols == top_n and (sort is False) and (threshold is None) and not mixed_dtype:
+        return sp_matmul(A, B, n_threads, sort_indices=sort_indices)
 
     assert_supported_dtype(A)
     assert_supported_dtype(B)
     ensure_compatible_dtype(A, B)
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
 
     # guard against top_n larger than number of cols
     top_n = min(top_n, B_ncols)
 
     # handle threshold
     if threshold is not None:
-        threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+        threshold = int(np.rint(threshold)) if np.issubdtype(acc_dtype, np.integer) else float(threshold)
 
     # basic check. if A or B are all zeros matrix, return all zero matrix directly
     if A.indices.size == 0 or B.indices.size == 0:
-        C_indptr = np.zeros(A_nrows + 1, dtype=idx_dtype)
-        C_indices = np.zeros(1, dtype=idx_dtype)
-        C_data = np.zeros(1, dtype=A.dtype)
-        return csr_matrix((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        C_indices = np.zeros(1, dtype=A_indices.dtype)
+        C_data = np.zeros(1, dtype=value_dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+    A_indptr, B_indptr = _widen_indptr(A_indptr, A_indices, B_indptr, A_nrows, B_ncols, top_n)
 
     kwargs = {
         "top_n": top_n,
@@ -265,74 +452,1900 @@ def sp_matmul_topn(
         "threshold": threshold,
         "density": density,
         "A_data": A.data,
-        "A_indptr": A.indptr if idx_dtype is None else A.indptr.astype(idx_dtype),
-        "A_indices": A.indices if idx_dtype is None else A.indices.astype(idx_dtype),
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
         "B_data": B.data,
-        "B_indptr": B.indptr if idx_dtype is None else B.indptr.astype(idx_dtype),
-        "B_indices": B.indices if idx_dtype is None else B.indices.astype(idx_dtype),
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
     }
 
-    func = _core.sp_matmul_topn if not sort else _core.sp_matmul_topn_sorted
+    name = "sp_matmul_topn"
+    if mixed_dtype:
+        kwargs["acc_dtype"] = acc_dtype_name
+        kwargs["value_dtype"] = value_dtype_name
+        name = "sp_matmul_topn_dtype"
+
+    variant = "_canonical" if sort_indices else "_sorted" if sort else ""
+    func = getattr(_core, f"{name}{variant}")
     if n_threads > 1:
         if _core._has_openmp_support:
             kwargs["n_threads"] = n_threads
             kwargs.pop("density")
-            func = _core.sp_matmul_topn_mt if not sort else _core.sp_matmul_topn_sorted_mt
+            func = getattr(_core, f"{name}{variant}_mt")
         else:
             msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
             warnings.warn(msg, stacklevel=1)
-    return csr_matrix(func(**kwargs), shape=(A_nrows, B_ncols))
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols), canonical=sort_indices)
 
 
-def zip_sp_matmul_topn(top_n: int, C_mats: list[csr_matrix]) -> csr_matrix:
-    """Compute zip-matrix C = zip_i C_i = zip_i A * B_i = A * B whilst only storing the `top_n` elements.
+def _to_index_operand(
+    B: csr_matrix | csc_matrix | coo_matrix, A_ncols: int, n_threads: int = 1
+) -> csr_matrix:
+    """Convert `B` to the CSR matrix `B.T`, the rows of which are the columns of `A * B`.
 
-    Combine the sub-matrices together and keep only the `top_n` elements per row.
+    Follows the orientation rules of `_to_csr_operands`, a CSR `B` in the `A * B.T`
+    orientation is used as is.
+    """
+    if not isinstance(B, (csr_matrix, coo_matrix, csc_matrix)):
+        msg = f"type of `B` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(B)}`"
+        raise TypeError(msg)
+    B_nrows, B_ncols = B.shape
+    if A_ncols == B_nrows:
+        if isinstance(B, csc_matrix):
+            return B.transpose()
+        if isinstance(B, csr_matrix):
+            return _csr_transpose(B, n_threads)
+        return B.transpose().tocsr(False)
+    if A_ncols == B_ncols:
+        if isinstance(B, csc_matrix):
+            return _csr_transpose(B.transpose(), n_threads)
+        return B.tocsr(False)
+    msg = "Matrices `A` and `B` have incompatible shapes. `A.shape[1]` must be equal to `B.shape[0]` or `B.shape[1]`."
+    raise ValueError(msg)
 
-    Pre-calling this function, matrix B has been split row-wise into chunks B_i, and C_i = A * B_i have been calculated.
-    This function computes C = zip_i C_i, which is equivalent to A * B when only keeping the `top_n` elements.
-    It allows very large matrices to be split and multiplied with a limited memory footprint.
+
+def sp_matmul_topn_approx(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    threshold: int | float | None = None,
+    sort: bool = False,
+    n_bands: int = 32,
+    band_size: int = 4,
+    seed: int = 0,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute the `top_n` elements of A * B approximately.
+
+    Rather than computing the full product, candidate pairs of a row of `A` and a column of `B`
+    are generated with locality sensitive hashing. The column indices of each row are summarised
+    by a MinHash signature of `n_bands * band_size` values, a pair is a candidate when both share
+    all `band_size` values of at least one band. The candidates are scored exactly, the values in C
+    are equal to those of `sp_matmul_topn` but pairs that are not a candidate are missed.
+
+    A pair with a Jaccard similarity `s` between the column sets is a candidate with probability
+    `1 - (1 - s**band_size)**n_bands`. Increasing `n_bands` increases the recall and the run time,
+    increasing `band_size` reduces the number of dissimilar candidates and the recall.
+    The values of the non-zero elements are not used to generate candidates, the approximation is
+    best suited for (tf-idf weighted) binary features such as n-grams.
 
     Args:
-        top_n: the number of results to retain; should be smaller or equal to top_n used to obtain C_mats.
-        C_mats: a list with each C_i sub-matrix, with format csr_matrix.
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            A CSR matrix in the `A * B.T` orientation is used without conversion.
+        top_n: the number of results to retain
+        threshold: only return values greater than the threshold
+        sort: return C in a format where the first non-zero element of each row is the largest value
+        n_bands: the number of LSH bands
+        band_size: the number of MinHash values per band
+        seed: the seed of the hash functions
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`.
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+        ValueError: when `n_bands` or `band_size` is smaller than one
 
     Returns:
-        C: zipped result matrix
+        C: result matrix
 
-    Raises:
-        TypeError: when not all elements of `C_mats` is a csr_matrix or trivially convertable
-        ValueError: when not all elements of `C_mats` has the same number of rows
     """
-    _nrows = []
-    ncols = []
-    data = []
-    indptr = []
-    indices = []
-    for C in C_mats:
-        # check correct type of each C
-        if isinstance(C, (coo_matrix, csc_matrix)):
-            C = C.tocsr(False)
-        elif not isinstance(C, csr_matrix):
-            msg = f"type of `C` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(C)}`"
-            raise TypeError(msg)
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+    if n_bands < 1 or band_size < 1:
+        msg = "`n_bands` and `band_size` must be at least one."
+        raise ValueError(msg)
 
-        nrows, c_nc = C.shape
-        _nrows.append(nrows)
-        ncols.append(c_nc)
-        data.append(C.data)
-        indptr.append(C.indptr)
-        indices.append(C.indices)
+    if isinstance(A, csc_matrix):
+        A = _csr_transpose(A.transpose(), n_threads)
+    elif isinstance(A, coo_matrix):
+        A = A.tocsr(False)
+    elif not isinstance(A, csr_matrix):
+        msg = f"type of `A` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(A)}`"
+        raise TypeError(msg)
+    Bt = _to_index_operand(B, A.shape[1], n_threads)
+    A_nrows, A_ncols = A.shape
+    B_ncols = Bt.shape[0]
 
-    ncols = np.asarray(ncols, int)
-    total_cols = ncols.sum()
-    if not np.all(np.diff(_nrows) == 0):
-        msg = "Each `C` in `C_mats` should have the same number of rows."
-        raise ValueError(msg)
+    assert_supported_dtype(A)
+    assert_supported_dtype(Bt)
+    ensure_compatible_dtype(A, Bt)
+    A_indptr, A_indices, Bt_indptr, Bt_indices = _index_arrays(A, Bt, idx_dtype)
 
-    return csr_matrix(
-        _core.zip_sp_matmul_topn(
-            top_n=top_n, Z_max_nnz=nrows * top_n, nrows=nrows, B_ncols=ncols, data=data, indptr=indptr, indices=indices
-        ),
-        shape=(nrows, total_cols),
-    )
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, B_ncols)
+
+    # handle threshold
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+
+    # basic check. if A or B are all zeros matrix, return all zero matrix directly
+    if A.indices.size == 0 or Bt.indices.size == 0 or top_n < 1:
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        C_indices = np.zeros(1, dtype=A_indices.dtype)
+        C_data = np.zeros(1, dtype=A.dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+    if A_nrows * top_n > np.iinfo(A_indptr.dtype).max:
+        A_indptr = A_indptr.astype(np.int64)
+        Bt_indptr = Bt_indptr.astype(np.int64)
+
+    kwargs = {
+        "top_n": top_n,
+        "nrows": A_nrows,
+        "ncols": B_ncols,
+        "A_ncols": A_ncols,
+        "threshold": threshold,
+        "n_bands": n_bands,
+        "band_size": band_size,
+        "seed": seed,
+        "A_data": A.data,
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
+        "Bt_data": Bt.data,
+        "Bt_indptr": Bt_indptr,
+        "Bt_indices": Bt_indices,
+    }
+
+    variant = "_sorted" if sort else ""
+    func = getattr(_core, f"sp_matmul_topn_approx{variant}")
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = getattr(_core, f"sp_matmul_topn_approx{variant}_mt")
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols))
+
+
+def sp_matmul_threshold(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    threshold: int | float,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute all elements of A * B greater than `threshold`.
+
+    In contrast to `sp_matmul_topn` the number of elements per row is not capped and C is sized
+    to the number of matches. For non-negative `A` and `B`, e.g. the cosine similarity of tf-idf
+    vectors, the columns of `B` are prefix filtered: the entries of each column that cannot
+    reach the threshold on their own are not indexed and only pairs sharing an indexed entry are scored.
+    The remaining pairs are pruned with a norm bound before the score is completed. The result is exact,
+    when `A` or `B` contain negative values the filters are not applied.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            A CSR matrix in the `A * B.T` orientation is used without conversion.
+        threshold: only return values greater than the threshold
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`.
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+
+    Returns:
+        C: result matrix
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+
+    if isinstance(A, csc_matrix):
+        A = _csr_transpose(A.transpose(), n_threads)
+    elif isinstance(A, coo_matrix):
+        A = A.tocsr(False)
+    elif not isinstance(A, csr_matrix):
+        msg = f"type of `A` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(A)}`"
+        raise TypeError(msg)
+    Bt = _to_index_operand(B, A.shape[1], n_threads)
+    A_nrows, A_ncols = A.shape
+    B_ncols = Bt.shape[0]
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(Bt)
+    ensure_compatible_dtype(A, Bt)
+
+    # the pruning bounds use the norms of the rows, which are underestimated when a row has duplicate entries
+    if not A.has_canonical_format:
+        A = A.copy()
+        A.sum_duplicates()
+    if not Bt.has_canonical_format:
+        Bt = Bt.copy()
+        Bt.sum_duplicates()
+
+    A_indptr, A_indices, Bt_indptr, Bt_indices = _index_arrays(A, Bt, idx_dtype)
+    threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+
+    # basic check. if A or B are all zeros matrix, return all zero matrix directly
+    if A.indices.size == 0 or Bt.indices.size == 0:
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        C_indices = np.zeros(1, dtype=A_indices.dtype)
+        C_data = np.zeros(1, dtype=A.dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+    if A_nrows * B_ncols > np.iinfo(A_indptr.dtype).max:
+        # the number of elements of C is bounded by the lengths of the rows of B selected by A
+        B_row_nnz = np.bincount(Bt_indices, minlength=A_ncols)
+        if B_row_nnz[A_indices].sum(dtype=np.int64) > np.iinfo(A_indptr.dtype).max:
+            A_indptr = A_indptr.astype(np.int64)
+            Bt_indptr = Bt_indptr.astype(np.int64)
+
+    kwargs = {
+        "nrows": A_nrows,
+        "ncols": B_ncols,
+        "A_ncols": A_ncols,
+        "threshold": threshold,
+        "A_data": A.data,
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
+        "Bt_data": Bt.data,
+        "Bt_indptr": Bt_indptr,
+        "Bt_indices": Bt_indices,
+    }
+
+    func = _core.sp_matmul_threshold
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = _core.sp_matmul_threshold_mt
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols))
+
+
+def sp_matmul_topn_mutual(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    mode: str = "mutual",
+    threshold: int | float | None = None,
+    sort: bool = False,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute the row-wise, column-wise or mutual `top_n` elements of A * B in a single pass.
+
+    The mutual top n are the elements that are in the `top_n` of their row and in the `top_n` of their column,
+    i.e. the reciprocal nearest neighbours. This is equivalent to the intersection of `sp_matmul_topn(A, B, top_n)`
+    and `sp_matmul_topn(B.T, A.T, top_n).T` but computes the product only once.
+    Equal values in a column are ranked on their row index, the lowest row is retained.
+
+    Note that the column-wise top n requires `B.shape[1] * top_n` elements of memory per thread.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        top_n: the number of results to retain per row and per column
+        mode: the elements to return, one of:
+            * ``"row"``: the `top_n` elements of each row, as `sp_matmul_topn`
+            * ``"column"``: the `top_n` elements of each column, the column indices of each row are sorted
+            * ``"mutual"``: the elements in both the row and column `top_n`
+        threshold: only return values greater than the threshold
+        sort: return C in a format where the first non-zero element of each row is the largest value,
+            has no effect when `mode` is ``"column"``
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`.
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+        ValueError: when `mode` is not one of ``"row"``, ``"column"`` or ``"mutual"``
+
+    Returns:
+        C: result matrix
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+    if mode not in ("row", "column", "mutual"):
+        msg = "`mode` must be one of 'row', 'column' or 'mutual'."
+        raise ValueError(msg)
+
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(B)
+    ensure_compatible_dtype(A, B)
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
+
+    # guard against top_n larger than the number of elements of a row or of a column,
+    # the mutual top n ranks elements in both
+    top_n = min(top_n, {"row": B_ncols, "column": A_nrows}.get(mode, max(A_nrows, B_ncols)))
+
+    # handle threshold
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+
+    # basic check. if A or B are all zeros matrix, return all zero matrix directly
+    if A.indices.size == 0 or B.indices.size == 0:
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        C_indices = np.zeros(1, dtype=A_indices.dtype)
+        C_data = np.zeros(1, dtype=A.dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+    # the mutual top n is a subset of the row top n, the column top n has up to `top_n` elements per column
+    if mode == "column":
+        max_nnz = B_ncols * min(top_n, A_nrows)
+    else:
+        max_nnz = A_nrows * min(top_n, B_ncols)
+    A_indptr, B_indptr = _widen_indptr(A_indptr, A_indices, B_indptr, A_nrows, B_ncols, max_nnz=max_nnz)
+
+    kwargs = {
+        "mode": mode,
+        "top_n": top_n,
+        "nrows": A_nrows,
+        "ncols": B_ncols,
+        "threshold": threshold,
+        "A_data": A.data,
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
+        "B_data": B.data,
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
+    }
+
+    variant = "_sorted" if sort else ""
+    func = getattr(_core, f"sp_matmul_topn_mutual{variant}")
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = getattr(_core, f"sp_matmul_topn_mutual{variant}_mt")
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols), canonical=mode == "column")
+
+
+_SEMIRINGS = ("plus_times", "max_times", "min_plus", "plus_min")
+
+
+def sp_matmul_topn_semiring(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    semiring: str = "plus_times",
+    threshold: int | float | None = None,
+    sort: bool = False,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute the `top_n` elements of the product A * B over a semiring.
+
+    The product replaces the multiplication and addition of the elements by the operations of the semiring,
+    element (i, k) is the reduction of ``combine(A[i, j], B[j, k])`` over the shared j. Only the j where
+    both A[i, j] and B[j, k] are stored contribute.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        top_n: the number of results to retain
+        semiring: the operations of the product, one of:
+            * ``"plus_times"``: the sum of the products, as `sp_matmul_topn`
+            * ``"max_times"``: the largest product
+            * ``"min_plus"``: the smallest sum, e.g. the shortest path of two steps. The `top_n` smallest
+              values are retained and `threshold` is an upper bound, only values smaller than it are returned
+            * ``"plus_min"``: the sum of the minima, e.g. the numerator of the weighted Jaccard similarity
+        threshold: only return values greater than the threshold, or smaller for ``"min_plus"``
+        sort: return C in a format where the first non-zero element of each row is the best value
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`.
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+        ValueError: when `semiring` is not one of the supported semirings
+
+    Returns:
+        C: result matrix
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+    if semiring not in _SEMIRINGS:
+        msg = f"`semiring` must be one of {_SEMIRINGS}, got: {semiring}"
+        raise ValueError(msg)
+
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(B)
+    ensure_compatible_dtype(A, B)
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
+
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, B_ncols)
+
+    # handle threshold
+    is_int = np.issubdtype(A.data.dtype, np.integer)
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if is_int else float(threshold)
+    # min-plus ranks the negated sums, the threshold becomes a lower bound on the negated values
+    negate = semiring == "min_plus"
+    if negate:
+        if threshold is None:
+            threshold = int(np.iinfo(A.dtype).min) if is_int else float(np.finfo(A.dtype).min)
+        elif is_int:
+            # the negated sums are clamped to [-max, max], see `MinPlus`
+            int_max = int(np.iinfo(A.dtype).max)
+            threshold = -min(max(threshold, -int_max), int_max)
+        else:
+            threshold = -threshold
+
+    # basic check. if A or B are all zeros matrix, return all zero matrix directly
+    if A.indices.size == 0 or B.indices.size == 0:
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        C_indices = np.zeros(1, dtype=A_indices.dtype)
+        C_data = np.zeros(1, dtype=A.dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+    A_indptr, B_indptr = _widen_indptr(A_indptr, A_indices, B_indptr, A_nrows, B_ncols, top_n)
+
+    kwargs = {
+        "semiring": semiring,
+        "top_n": top_n,
+        "nrows": A_nrows,
+        "ncols": B_ncols,
+        "threshold": threshold,
+        "A_data": A.data,
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
+        "B_data": B.data,
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
+    }
+
+    variant = "_sorted" if sort else ""
+    func = getattr(_core, f"sp_matmul_topn_semiring{variant}")
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = getattr(_core, f"sp_matmul_topn_semiring{variant}_mt")
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    C_data, C_indices, C_indptr = func(**kwargs)
+    if negate:
+        np.negative(C_data, out=C_data)
+    return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+
+
+def sp_matmul_topn_fields(
+    fields: Sequence[tuple[csr_matrix | csc_matrix | coo_matrix, csr_matrix | csc_matrix | coo_matrix, int | float]],
+    top_n: int,
+    threshold: int | float | None = None,
+    sort: bool = False,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute the `top_n` elements of the weighted sum of products ``w_1 * A_1 * B_1 + ... + w_k * A_k * B_k``.
+
+    Each field, e.g. the name, address and phone number of a record, has its own operands that share the rows
+    of A and the columns of B. The products of the fields are accumulated per row before the top n is selected,
+    such that the memory required equals that of a single `sp_matmul_topn` rather than of a product per field.
+
+    Args:
+        fields: a sequence of (A, B, weight) tuples, see `sp_matmul_topn` for the requirements on A and B.
+            All `A` must have the same number of rows, all `B` the same number of columns and all operands
+            the same dtype. The weights are cast to that dtype, rounded for integer dtypes.
+        top_n: the number of results to retain
+        threshold: only return values greater than the threshold
+        sort: return C in a format where the first non-zero element of each row is the largest value
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of the operands
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix` or the operands differ in dtype
+        ValueError: when `fields` is empty or the shapes of the fields are not compatible
+
+    Returns:
+        C: result matrix
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+    if len(fields) == 0:
+        msg = "`fields` must contain at least one (A, B, weight) tuple."
+        raise ValueError(msg)
+
+    operands = []
+    for A, B, weight in fields:
+        A, B = _to_csr_operands(A, B, n_threads)
+        assert_supported_dtype(A)
+        assert_supported_dtype(B)
+        operands.append((A, B, weight))
+    A_nrows = operands[0][0].shape[0]
+    B_ncols = operands[0][1].shape[1]
+    if any(A.shape[0] != A_nrows or B.shape[1] != B_ncols for A, B, _ in operands):
+        msg = "all `A` of `fields` must have the same number of rows and all `B` the same number of columns."
+        raise ValueError(msg)
+    dtype = operands[0][0].dtype
+    if any(A.dtype != dtype or B.dtype != dtype for A, B, _ in operands):
+        msg = "the operands of `fields` do not have the same dtype"
+        raise TypeError(msg)
+
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, B_ncols)
+
+    # handle threshold
+    is_int = np.issubdtype(dtype, np.integer)
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if is_int else float(threshold)
+
+    # the fields where A or B are all zeros do not contribute
+    operands = [(A, B, weight) for A, B, weight in operands if A.indices.size > 0 and B.indices.size > 0]
+    if len(operands) == 0:
+        idx_dtype = np.int32 if idx_dtype is None else idx_dtype
+        C_indptr = np.zeros(A_nrows + 1, dtype=idx_dtype)
+        C_indices = np.zeros(1, dtype=idx_dtype)
+        C_data = np.zeros(1, dtype=dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+
+    # the index arrays of all fields are passed with the same dtypes
+    if idx_dtype is None:
+        idx_dtype = np.result_type(*[M.indices for A, B, _ in operands for M in (A, B)])
+        ptr_dtype = np.result_type(*[M.indptr for A, B, _ in operands for M in (A, B)], idx_dtype)
+    else:
+        ptr_dtype = idx_dtype
+    # a row of C holds at most `top_n` elements irrespective of the number of fields
+    if A_nrows * top_n > np.iinfo(ptr_dtype).max:
+        ptr_dtype = np.dtype(np.int64)
+    weights = np.asarray([weight for _, _, weight in operands], dtype=np.float64)
+    weights = (np.rint(weights) if is_int else weights).astype(dtype)
+
+    kwargs = {
+        "top_n": top_n,
+        "nrows": A_nrows,
+        "ncols": B_ncols,
+        "threshold": threshold,
+        "weights": weights,
+        "A_data": [A.data for A, _, _ in operands],
+        "A_indptr": [A.indptr.astype(ptr_dtype, copy=False) for A, _, _ in operands],
+        "A_indices": [A.indices.astype(idx_dtype, copy=False) for A, _, _ in operands],
+        "B_data": [B.data for _, B, _ in operands],
+        "B_indptr": [B.indptr.astype(ptr_dtype, copy=False) for _, B, _ in operands],
+        "B_indices": [B.indices.astype(idx_dtype, copy=False) for _, B, _ in operands],
+    }
+
+    variant = "_sorted" if sort else ""
+    func = getattr(_core, f"sp_matmul_topn_fields{variant}")
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = getattr(_core, f"sp_matmul_topn_fields{variant}_mt")
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols))
+
+
+def sp_matmul_topn_chain(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    C: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    intermediate_top_n: int | None = None,
+    intermediate_threshold: int | float | None = None,
+    threshold: int | float | None = None,
+    sort: bool = False,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute A * B * C whilst only storing the `top_n` elements, the rows of A * B are pruned whilst streaming.
+
+    Each row of the intermediate product A * B is computed, pruned to its `intermediate_top_n` elements greater
+    than `intermediate_threshold` and multiplied with C before the next row is started. The intermediate rows
+    only live in per-thread buffers, A * B is never materialised. E.g. the two-hop neighbours of
+    ``sp_matmul_topn_chain(A, S, S, top_n)`` are the items similar to the items similar to the rows of `A`.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: middle operand, the number of rows of B must match the number of columns of A or the shape of B.T
+            should be match A. Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        C: RHS of the multiplication, the number of rows of C must match the number of columns of B or the shape
+            of C.T should be match B. Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+            `A`, `B` and `C` must be have the same {32, 64}bit {int, float} dtype.
+        top_n: the number of results to retain
+        intermediate_top_n: the number of elements to retain of each row of A * B, `None` retains all
+        intermediate_threshold: only retain elements of A * B greater than the threshold
+        threshold: only return values greater than the threshold
+        sort: return Z in a format where the first non-zero element of each row is the largest value
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of the operands
+
+    Throws:
+        TypeError: when A, B, C are not trivially convertable to a `CSR matrix` or differ in dtype
+        ValueError: when the shapes of the operands are not compatible
+
+    Returns:
+        Z: result matrix
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+
+    A, B = _to_csr_operands(A, B, n_threads)
+    B, C = _to_csr_operands(B, C, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+    C_ncols = C.shape[1]
+
+    for M, name in ((A, "A"), (B, "B"), (C, "C")):
+        assert_supported_dtype(M, name)
+    if not A.dtype == B.dtype == C.dtype:
+        msg = "`A`, `B` and `C` do not have the same dtype"
+        raise TypeError(msg)
+
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, C_ncols)
+    intermediate_top_n = B_ncols if intermediate_top_n is None else min(intermediate_top_n, B_ncols)
+
+    # handle thresholds
+    is_int = np.issubdtype(A.data.dtype, np.integer)
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if is_int else float(threshold)
+    if intermediate_threshold is not None:
+        intermediate_threshold = int(np.rint(intermediate_threshold)) if is_int else float(intermediate_threshold)
+
+    if idx_dtype is None:
+        idx_dtype = np.result_type(A.indices, B.indices, C.indices)
+        ptr_dtype = np.result_type(A.indptr, B.indptr, C.indptr, idx_dtype)
+    else:
+        ptr_dtype = idx_dtype
+    # a row of Z holds at most `top_n` elements
+    if A_nrows * top_n > np.iinfo(ptr_dtype).max:
+        ptr_dtype = np.dtype(np.int64)
+
+    # basic check. if A, B or C are all zeros matrix, return all zero matrix directly
+    if A.indices.size == 0 or B.indices.size == 0 or C.indices.size == 0 or intermediate_top_n < 1:
+        Z_indptr = np.zeros(A_nrows + 1, dtype=ptr_dtype)
+        Z_indices = np.zeros(1, dtype=idx_dtype)
+        Z_data = np.zeros(1, dtype=A.dtype)
+        return _to_csr_result((Z_data, Z_indices, Z_indptr), shape=(A_nrows, C_ncols))
+
+    kwargs = {
+        "top_n": top_n,
+        "nrows": A_nrows,
+        "ncols": C_ncols,
+        "threshold": threshold,
+        "intermediate_top_n": intermediate_top_n,
+        "intermediate_ncols": B_ncols,
+        "intermediate_threshold": intermediate_threshold,
+    }
+    for M, name in ((A, "A"), (B, "B"), (C, "C")):
+        kwargs[f"{name}_data"] = M.data
+        kwargs[f"{name}_indptr"] = M.indptr.astype(ptr_dtype, copy=False)
+        kwargs[f"{name}_indices"] = M.indices.astype(idx_dtype, copy=False)
+
+    variant = "_sorted" if sort else ""
+    func = getattr(_core, f"sp_matmul_topn_chain{variant}")
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = getattr(_core, f"sp_matmul_topn_chain{variant}_mt")
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, C_ncols))
+
+
+def sp_matmul_masked(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    M: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int | None = None,
+    threshold: int | float | None = None,
+    sort: bool = False,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute A * B restricted to the sparsity pattern of the mask M, optionally only storing the `top_n` elements.
+
+    Only the columns in the row of `M` are accumulated, e.g. to score the candidate pairs generated by blocking
+    rules. The result has at most as many non-zero elements as `M`, the positions of `M` where the rows of `A`
+    and the columns of `B` do not share an element are not stored. The values of `M` are ignored, stored zeros
+    are part of the pattern.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        M: the mask with the shape of A * B, converted to CSR format if a CSC or COO matrix.
+            Without `top_n` the column indices of each row of C are in the order of `M`.
+        top_n: the number of results to retain, `None` retains all elements inside the mask
+        threshold: only return values greater than the threshold, requires `top_n`
+        sort: return C in a format where the first non-zero element of each row is the largest value, requires `top_n`
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of the operands
+
+    Throws:
+        TypeError: when A, B or M are not trivially convertable to a `CSR matrix`
+        ValueError: when the shape of `M` does not match A * B or `threshold` is set without `top_n`
+
+    Returns:
+        C: result matrix
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+    if top_n is None and threshold is not None:
+        msg = "`threshold` requires `top_n`."
+        raise ValueError(msg)
+
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+    if not isinstance(M, (csr_matrix, csc_matrix, coo_matrix)):
+        msg = f"type of `M` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(M)}`"
+        raise TypeError(msg)
+    if M.shape != (A_nrows, B_ncols):
+        msg = f"the shape of `M` must be equal to the shape of A * B {(A_nrows, B_ncols)}, got {M.shape}."
+        raise ValueError(msg)
+    M = _csr_transpose(M.transpose(), n_threads) if isinstance(M, csc_matrix) else M.tocsr(False)
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(B)
+    ensure_compatible_dtype(A, B)
+
+    if idx_dtype is None:
+        idx_dtype = np.result_type(A.indices, B.indices, M.indices)
+        ptr_dtype = np.result_type(A.indptr, B.indptr, M.indptr, idx_dtype)
+    else:
+        ptr_dtype = idx_dtype
+
+    # handle threshold
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+
+    # basic check. if A, B or M are all zeros matrix, return all zero matrix directly
+    if A.indices.size == 0 or B.indices.size == 0 or M.indices.size == 0 or (top_n is not None and top_n < 1):
+        C_indptr = np.zeros(A_nrows + 1, dtype=ptr_dtype)
+        C_indices = np.zeros(1, dtype=idx_dtype)
+        C_data = np.zeros(1, dtype=A.dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+
+    kwargs = {
+        "nrows": A_nrows,
+        "ncols": B_ncols,
+        "A_data": A.data,
+        "A_indptr": A.indptr.astype(ptr_dtype, copy=False),
+        "A_indices": A.indices.astype(idx_dtype, copy=False),
+        "B_data": B.data,
+        "B_indptr": B.indptr.astype(ptr_dtype, copy=False),
+        "B_indices": B.indices.astype(idx_dtype, copy=False),
+        "M_indptr": M.indptr.astype(ptr_dtype, copy=False),
+        "M_indices": M.indices.astype(idx_dtype, copy=False),
+    }
+
+    if top_n is None:
+        name = "sp_matmul_masked"
+    else:
+        kwargs["top_n"] = min(top_n, B_ncols)
+        kwargs["threshold"] = threshold
+        name = "sp_matmul_topn_masked_sorted" if sort else "sp_matmul_topn_masked"
+    func = getattr(_core, name)
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = getattr(_core, f"{name}_mt")
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    # a row of C is a subsequence of the row of M
+    canonical = top_n is None and M.has_canonical_format
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols), canonical=canonical)
+
+
+def sp_matmul_pairs(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    rows: ArrayLike,
+    cols: ArrayLike,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> NDArray:
+    """Compute the elements `(rows[k], cols[k])` of A * B without computing the product.
+
+    Each element is the dot product of a row of `A` and a column of `B`, computed by intersecting their sorted
+    column indices. Rows of similar length are merged, four indices at a time when SSE2 is available and the
+    indices are 32bit, a short row is searched in a much longer row with an exponential search.
+    Suited to score a list of candidate pairs that is too irregular to express as a mask, see `sp_matmul_masked`.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            Note the matrix is converted (copied) such that the columns of B are rows in CSR format,
+            B in the `A * B.T` orientation as CSR matrix is used as is.
+        rows: the row of C of each pair
+        cols: the column of C of each pair
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of the operands
+
+    Throws:
+        TypeError: when A or B are not trivially convertable to a `CSR matrix`
+        ValueError: when the shapes of A and B are not compatible, `rows` and `cols` differ in shape or are out of bounds
+
+    Returns:
+        values: the elements of C for the pairs, with the dtype of `A`
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+
+    if isinstance(A, csc_matrix):
+        A = _csr_transpose(A.transpose(), n_threads)
+    elif isinstance(A, coo_matrix):
+        A = A.tocsr(False)
+    elif not isinstance(A, csr_matrix):
+        msg = f"type of `A` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(A)}`"
+        raise TypeError(msg)
+    if not isinstance(B, (csr_matrix, coo_matrix, csc_matrix)):
+        msg = f"type of `B` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(B)}`"
+        raise TypeError(msg)
+
+    # the kernel intersects rows, B is converted to B.T in CSR format
+    A_nrows, A_ncols = A.shape
+    if A_ncols == B.shape[0]:
+        if isinstance(B, csc_matrix):
+            B = B.transpose()
+        elif isinstance(B, csr_matrix):
+            B = _csr_transpose(B, n_threads)
+        else:
+            B = B.transpose().tocsr(False)
+    elif A_ncols == B.shape[1]:
+        if isinstance(B, csc_matrix):
+            B = _csr_transpose(B.transpose(), n_threads)
+        elif isinstance(B, coo_matrix):
+            B = B.tocsr(False)
+    else:
+        msg = (
+            "Matrices `A` and `B` have incompatible shapes. `A.shape[1]` must be equal to `B.shape[0]` or `B.shape[1]`."
+        )
+        raise ValueError(msg)
+    B_nrows = B.shape[0]
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(B)
+    ensure_compatible_dtype(A, B)
+
+    rows = np.asarray(rows)
+    cols = np.asarray(cols)
+    if rows.ndim != 1 or rows.shape != cols.shape:
+        msg = f"`rows` and `cols` must be one dimensional with the same shape, got {rows.shape} and {cols.shape}."
+        raise ValueError(msg)
+    if rows.size > 0 and (rows.min() < 0 or rows.max() >= A_nrows or cols.min() < 0 or cols.max() >= B_nrows):
+        msg = f"`rows` and `cols` must index the elements of A * B with shape {(A_nrows, B_nrows)}."
+        raise ValueError(msg)
+    if rows.size == 0 or A.indices.size == 0 or B.indices.size == 0:
+        return np.zeros(rows.size, dtype=A.dtype)
+
+    # the intersection requires sorted and unique column indices
+    if not A.has_canonical_format:
+        A = A.copy()
+        A.sum_duplicates()
+    if not B.has_canonical_format:
+        B = B.copy()
+        B.sum_duplicates()
+
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
+    kwargs = {
+        "A_data": A.data,
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
+        "B_data": B.data,
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
+        "rows": rows.astype(A_indices.dtype, copy=False),
+        "cols": cols.astype(A_indices.dtype, copy=False),
+    }
+
+    func = _core.sp_matmul_pairs
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = _core.sp_matmul_pairs_mt
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    return func(**kwargs)
+
+
+def sp_matmul_topn_components(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    threshold: int | float | None = None,
+    return_edges: bool = False,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> tuple[int, NDArray] | tuple[int, NDArray, csr_matrix]:
+    """Compute the connected components of the graph formed by the `top_n` elements of A * B.
+
+    The retained elements of each row are fed into a (lock-free) union-find as soon as the row has been computed,
+    such that C = A * B is never stored unless `return_edges` is set.
+    The result is equal to ``scipy.sparse.csgraph.connected_components(sp_matmul_topn(A, B, top_n, threshold))``,
+    i.e. the graph is treated as undirected and the components are labelled in the order of their first row.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        top_n: the number of results to retain
+        threshold: only connect rows and columns with a value greater than the threshold
+        return_edges: also return the retained elements C
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`.
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+        ValueError: when A * B is not square
+
+    Returns:
+        n_components: the number of connected components
+        labels: the component of each row
+        C: the retained elements, only when `return_edges` is set
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+    if A_nrows != B_ncols:
+        msg = f"A * B must be square to form a graph, got shape {(A_nrows, B_ncols)}"
+        raise ValueError(msg)
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(B)
+    ensure_compatible_dtype(A, B)
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
+
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, B_ncols)
+
+    # handle threshold
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+
+    # basic check. if A or B are all zeros matrix, every row is a component
+    if A.indices.size == 0 or B.indices.size == 0:
+        labels = np.arange(A_nrows, dtype=A_indices.dtype)
+        if not return_edges:
+            return A_nrows, labels
+        return A_nrows, labels, csr_matrix((A_nrows, B_ncols), dtype=A.dtype)
+
+    kwargs = {
+        "top_n": top_n,
+        "nrows": A_nrows,
+        "threshold": threshold,
+        "with_edges": return_edges,
+        "A_data": A.data,
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
+        "B_data": B.data,
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
+    }
+
+    func = _core.sp_matmul_topn_components
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = _core.sp_matmul_topn_components_mt
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    n_components, labels, E_data, E_rows, E_cols = func(**kwargs)
+    if not return_edges:
+        return n_components, labels
+    C = coo_matrix((E_data, (E_rows, E_cols)), shape=(A_nrows, B_ncols)).tocsr()
+    return n_components, labels, C
+
+
+def sp_matmul_topn_coo(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    threshold: int | float | None = None,
+    sort: bool = False,
+    density: float | None = None,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+    value_dtype: DTypeLike | None = None,
+) -> coo_matrix:
+    """Compute A * B whilst only storing the `top_n` elements in COO format.
+
+    The row indices, column indices and values of the result are written directly
+    by the extension as parallel arrays, e.g. for use as an edge list, which avoids
+    expanding a CSR result with `tocoo`. The arrays are accessible without copies
+    as `C.row`, `C.col` and `C.data`.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        top_n: the number of results to retain
+        sort: return C in a format where the first non-zero element of each row is the largest value
+        threshold: only return values greater than the threshold
+        density: the expected density of the result considering `top_n`. The expected number of non-zero elements
+            in C should <= (`density` * `top_n` * `A.shape[0]`) otherwise the memory has to reallocated.
+            This value should only be set if you have a strong expectation as being wrong incurs a realloaction penalty.
+            Defaults to an upper bound on the number of non-zero elements computed from the index pointer of `B`,
+            the unused memory is released after the product.
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`.
+            A 64bit `indptr` with 32bit `indices` is used without copies and retained in C.
+        value_dtype: dtype of the values of C, must be `float32` or `float64`, defaults to the dtype of `A`
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+        ValueError: when `value_dtype` is not supported
+
+    Returns:
+        C: result matrix
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(B)
+    ensure_compatible_dtype(A, B)
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
+
+    value_dtype = A.dtype if value_dtype is None else np.dtype(value_dtype)
+    if value_dtype == A.dtype:
+        value_dtype_name = ""
+    elif value_dtype in (np.float32, np.float64):
+        value_dtype_name = value_dtype.name
+    else:
+        msg = f"`value_dtype` must be float32, float64 or the dtype of `A`, got: {value_dtype}"
+        raise ValueError(msg)
+
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, B_ncols)
+
+    # handle threshold
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+
+    # basic check. if A or B are all zeros matrix, return all zero matrix directly
+    if A.indices.size == 0 or B.indices.size == 0 or top_n < 1:
+        C_idx = np.zeros(0, dtype=A_indices.dtype)
+        C_data = np.zeros(0, dtype=value_dtype)
+        return coo_matrix((C_data, (C_idx, C_idx)), shape=(A_nrows, B_ncols))
+
+    kwargs = {
+        "top_n": top_n,
+        "nrows": A_nrows,
+        "ncols": B_ncols,
+        "threshold": threshold,
+        "density": density,
+        "value_dtype": value_dtype_name,
+        "A_data": A.data,
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
+        "B_data": B.data,
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
+    }
+
+    func = _core.sp_matmul_topn_coo if not sort else _core.sp_matmul_topn_sorted_coo
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            kwargs.pop("density")
+            func = _core.sp_matmul_topn_coo_mt if not sort else _core.sp_matmul_topn_sorted_coo_mt
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    C_data, C_rows, C_cols = func(**kwargs)
+    return coo_matrix((C_data, (C_rows, C_cols)), shape=(A_nrows, B_ncols), copy=False)
+
+
+def sp_matmul_topn_dense(
+    A: NDArray | csr_matrix | csc_matrix | coo_matrix,
+    B: NDArray,
+    top_n: int,
+    threshold: float | None = None,
+    sort: bool = False,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute A * B whilst only storing the `top_n` elements for a dense or sparse `A` and a dense `B`.
+
+    Suited to dense embeddings, e.g. `A` the embeddings of the queries and `B` the embeddings of the entities.
+    The product is computed in tiles by Eigen's blocked matrix product, or by accumulating the rows of `B`
+    for a sparse `A`, and each tile is streamed into a heap per row such that the dense matrix of scores is
+    never stored. The blocks of rows are distributed over the threads.
+
+    Args:
+        A: LHS of the multiplication, a dense array or a sparse matrix, the number of columns of A determines the
+            orientation of B. Note a sparse matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, a dense array, the number of rows of B must match the number of columns of A
+            or the shape of B.T should be match A, e.g. the embeddings of the entities with a row per entity.
+            Note that B is copied when a dense A is multiplied with B in the `A * B` orientation
+            or a sparse A with B in the `A * B.T` orientation.
+        top_n: the number of results to retain
+        threshold: only return values greater than the threshold
+        sort: return C in a format where the first non-zero element of each row is the largest value
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to int32. The index pointers
+            are int64 when the number of non-zero elements of C may exceed the range of `idx_dtype`
+
+    Throws:
+        TypeError: when A is not a dense array or trivially convertable to a `CSR matrix` or A and B
+            do not have a {32, 64}bit float dtype
+        ValueError: when the shapes of A and B are not compatible
+
+    Returns:
+        C: result matrix, without `sort` the column indices of each row are sorted
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+
+    if isinstance(A, csc_matrix):
+        A = _csr_transpose(A.transpose(), n_threads)
+    elif isinstance(A, coo_matrix):
+        A = A.tocsr(False)
+    elif not isinstance(A, csr_matrix):
+        A = np.asarray(A)
+        if A.ndim != 2:
+            msg = f"`A` must be a two dimensional array or a sparse matrix, got {A.ndim} dimensions."
+            raise TypeError(msg)
+    is_sparse = isinstance(A, csr_matrix)
+    B = np.asarray(B)
+    if B.ndim != 2:
+        msg = f"`B` must be a two dimensional array, got {B.ndim} dimensions."
+        raise TypeError(msg)
+
+    dtype = np.result_type(A.dtype, B.dtype)
+    if dtype not in (np.dtype(np.float32), np.dtype(np.float64)):
+        msg = f"`A` and `B` must have a {{32, 64}}bit float dtype, got {A.dtype} and {B.dtype}."
+        raise TypeError(msg)
+
+    # the sparse kernel takes B in the `A * B` orientation, the dense kernel in the `A * B.T` orientation
+    A_nrows, dim = A.shape
+    if dim == B.shape[0]:
+        B_ncols = B.shape[1]
+        B = np.ascontiguousarray(B if is_sparse else B.T, dtype=dtype)
+    elif dim == B.shape[1]:
+        B_ncols = B.shape[0]
+        B = np.ascontiguousarray(B.T if is_sparse else B, dtype=dtype)
+    else:
+        msg = (
+            "Matrices `A` and `B` have incompatible shapes. `A.shape[1]` must be equal to `B.shape[0]` or `B.shape[1]`."
+        )
+        raise ValueError(msg)
+
+    top_n = min(top_n, B_ncols)
+    if idx_dtype is None:
+        idx_dtype = np.dtype(np.int32) if B_ncols <= np.iinfo(np.int32).max else np.dtype(np.int64)
+        if is_sparse:
+            idx_dtype = np.result_type(A.indices, idx_dtype)
+        ptr_dtype = np.int64 if A_nrows * max(top_n, 0) > np.iinfo(idx_dtype).max else idx_dtype
+        ptr_dtype = np.result_type(A.indptr, ptr_dtype) if is_sparse else np.dtype(ptr_dtype)
+    else:
+        idx_dtype = np.dtype(idx_dtype)
+        # the index pointers of C and A are widened rather than truncated
+        ptr_max = max(A_nrows * max(top_n, 0), int(A.indptr[-1]) if is_sparse else 0)
+        ptr_dtype = np.dtype(np.int64) if ptr_max > np.iinfo(idx_dtype).max else idx_dtype
+
+    if threshold is not None:
+        threshold = float(threshold)
+
+    # basic check. if A or B are empty, return all zero matrix directly
+    if top_n < 1 or dim == 0 or (is_sparse and A.indices.size == 0):
+        C_indptr = np.zeros(A_nrows + 1, dtype=ptr_dtype)
+        C_indices = np.zeros(1, dtype=idx_dtype)
+        C_data = np.zeros(1, dtype=dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+
+    kwargs = {"top_n": top_n, "threshold": threshold}
+    variant = "_sorted" if sort else ""
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            variant += "_mt"
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+
+    if is_sparse:
+        kwargs["nrows"] = A_nrows
+        kwargs["A_data"] = A.data.astype(dtype, copy=False)
+        kwargs["A_indptr"] = A.indptr.astype(ptr_dtype, copy=False)
+        kwargs["A_indices"] = A.indices.astype(idx_dtype, copy=False)
+        kwargs["D"] = B
+        func = getattr(_core, f"sparse_dense_matmul_topn{variant}")
+    else:
+        kwargs["Q"] = np.ascontiguousarray(A, dtype=dtype)
+        kwargs["E"] = B
+        # the index types cannot be inferred from the arguments
+        func = getattr(_core, f"dense_matmul_topn{variant}_{dtype.name}_{idx_dtype.name}_{ptr_dtype.name}")
+    # without sorting the values of a row are in column order
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols), canonical=not sort)
+
+
+def sp_matmul_topn_hybrid(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    A_emb: NDArray,
+    B_emb: NDArray,
+    top_n: int,
+    alpha: float = 1.0,
+    beta: float = 1.0,
+    threshold: float | None = None,
+    sort: bool = False,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Compute the `top_n` elements of ``alpha * A * B + beta * A_emb * B_emb.T`` in a single pass.
+
+    Fuses e.g. the cosine similarity of TF-IDF vectors with the cosine similarity of embeddings.
+    The sparse product generates the candidates, for each column set in a row of A * B the dot product of the
+    embeddings is added before the fused score is compared with the top n of the row. Columns that do not
+    share an element with a row of A are not scored, such that the result is the top-n of the fused score
+    over the candidates of the sparse product rather than a re-ranking of its top-n.
+
+    Args:
+        A: LHS of the sparse multiplication, the number of columns of A determines the orientation of B.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the sparse multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        A_emb: the embeddings of the rows of C, a dense array with a row per row of `A`
+        B_emb: the embeddings of the columns of C, a dense array with a row per column of C
+        top_n: the number of results to retain
+        alpha: the weight of the sparse product
+        beta: the weight of the product of the embeddings
+        threshold: only return fused scores greater than the threshold
+        sort: return C in a format where the first non-zero element of each row is the largest value
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix` or the operands
+            do not have a {32, 64}bit float dtype
+        ValueError: when the shapes of the operands are not compatible
+
+    Returns:
+        C: result matrix with the fused scores
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+
+    A_emb = np.asarray(A_emb)
+    B_emb = np.asarray(B_emb)
+    dtype = np.result_type(A.dtype, B.dtype, A_emb.dtype, B_emb.dtype)
+    if dtype not in (np.dtype(np.float32), np.dtype(np.float64)):
+        msg = f"the operands must have a {{32, 64}}bit float dtype, got {dtype}."
+        raise TypeError(msg)
+    if A_emb.ndim != 2 or B_emb.ndim != 2 or A_emb.shape[1] != B_emb.shape[1]:
+        msg = "`A_emb` and `B_emb` must be two dimensional arrays with the same number of columns."
+        raise ValueError(msg)
+    if A_emb.shape[0] != A_nrows or B_emb.shape[0] != B_ncols:
+        msg = f"`A_emb` and `B_emb` must have {A_nrows} and {B_ncols} rows, got {A_emb.shape[0]} and {B_emb.shape[0]}."
+        raise ValueError(msg)
+
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
+
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, B_ncols)
+
+    if threshold is not None:
+        threshold = float(threshold)
+
+    # basic check. if A or B are all zeros matrix there are no candidates, return all zero matrix directly
+    if A.indices.size == 0 or B.indices.size == 0 or top_n < 1:
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        C_indices = np.zeros(1, dtype=A_indices.dtype)
+        C_data = np.zeros(1, dtype=dtype)
+        return _to_csr_result((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+    A_indptr, B_indptr = _widen_indptr(A_indptr, A_indices, B_indptr, A_nrows, B_ncols, top_n)
+
+    kwargs = {
+        "top_n": top_n,
+        "nrows": A_nrows,
+        "ncols": B_ncols,
+        "threshold": threshold,
+        "alpha": float(alpha),
+        "beta": float(beta),
+        "A_data": A.data.astype(dtype, copy=False),
+        "A_indptr": A_indptr,
+        "A_indices": A_indices,
+        "B_data": B.data.astype(dtype, copy=False),
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
+        "Q": np.ascontiguousarray(A_emb, dtype=dtype),
+        "E": np.ascontiguousarray(B_emb, dtype=dtype),
+    }
+
+    variant = "_sorted" if sort else ""
+    func = getattr(_core, f"sp_matmul_topn_hybrid{variant}")
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            func = getattr(_core, f"sp_matmul_topn_hybrid{variant}_mt")
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+    return _to_csr_result(func(**kwargs), shape=(A_nrows, B_ncols))
+
+
+def sp_matmul_topn_chunked(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    sink: Callable | str | PathLike,
+    block_size: int = 100_000,
+    threshold: int | float | None = None,
+    sort: bool = False,
+    density: float | None = None,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> Path | None:
+    """Compute A * B whilst only storing the `top_n` elements and stream the result in blocks of rows.
+
+    `A` is processed in blocks of `block_size` rows, after each block the
+    finished rows are handed to `sink` and released. The memory required for
+    the result is therefore bounded by a single block rather than by `C`.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        top_n: the number of results to retain
+        sink: a callable with signature `sink(start, data, indices, indptr)` that is called
+            for each block of rows in order, where `start` is the first row of the block in `C` and
+            `indptr` starts at zero. Alternatively a path to a directory where `C` is written
+            to using a `CSRWriter`, the result can be memory-mapped with `load_csr`.
+            The partially written files are removed when an error occurs. The arrays passed to a callable are not retained by this function.
+        block_size: the number of rows of `A` per block
+        threshold: only return values greater than the threshold
+        sort: return C in a format where the first non-zero element of each row is the largest value
+        density: the expected density of each block considering `top_n`, see `sp_matmul_topn`
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of `A` and `B`
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+
+    Returns:
+        path: the directory `C` was written to when `sink` is a path, `None` otherwise
+
+    """
+    n_threads: int = n_threads or 1
+    if n_threads < 0:
+        n_threads = _N_CORES
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+    if block_size < 1:
+        msg = "`block_size` must be at least one."
+        raise ValueError(msg)
+
+    A, B = _to_csr_operands(A, B, n_threads)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(B)
+    ensure_compatible_dtype(A, B)
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
+
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, B_ncols)
+
+    # handle threshold
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+
+    writer = None
+    if not callable(sink):
+        # the number of non-zero elements on disk is not bounded by memory, use 64bit indices
+        writer = sink = CSRWriter(sink, ncols=B_ncols, dtype=A.dtype, idx_dtype=np.int64)
+
+    kwargs = {
+        "top_n": top_n,
+        "ncols": B_ncols,
+        "threshold": threshold,
+        "density": density,
+        "A_data": A.data,
+        "A_indices": A_indices,
+        "B_data": B.data,
+        "B_indptr": B_indptr,
+        "B_indices": B_indices,
+    }
+
+    func = _core.sp_matmul_topn if not sort else _core.sp_matmul_topn_sorted
+    if n_threads > 1:
+        if _core._has_openmp_support:
+            kwargs["n_threads"] = n_threads
+            kwargs.pop("density")
+            func = _core.sp_matmul_topn_mt if not sort else _core.sp_matmul_topn_sorted_mt
+        else:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+
+    # if A or B are all zeros matrix, emit the empty rows directly
+    is_empty = A.indices.size == 0 or B.indices.size == 0
+
+    try:
+        for start in range(0, A_nrows, block_size):
+            stop = min(start + block_size, A_nrows)
+            if is_empty:
+                C_block = (
+                    np.zeros(0, dtype=A.dtype),
+                    np.zeros(0, dtype=A_indices.dtype),
+                    np.zeros(stop - start + 1, dtype=A_indptr.dtype),
+                )
+            else:
+                # the kernels use `A_indptr` as an absolute offset into `A_data` and
+                # `A_indices` so a slice of the index pointer selects the block without copies
+                C_block = func(nrows=stop - start, A_indptr=A_indptr[start : stop + 1], **kwargs)
+            sink(start, *C_block)
+            del C_block
+    except BaseException:
+        # don't leave a truncated result on disk that can be loaded as if it were complete
+        if writer is not None:
+            writer.discard()
+        raise
+    return writer.close() if writer is not None else None
+
+
+def zip_sp_matmul_topn(top_n: int, C_mats: list[csr_matrix]) -> csr_matrix:
+    """Compute zip-matrix C = zip_i C_i = zip_i A * B_i = A * B whilst only storing the `top_n` elements.
+
+    Combine the sub-matrices together and keep only the `top_n` elements per row.
+
+    Pre-calling this function, matrix B has been split row-wise into chunks B_i, and C_i = A * B_i have been calculated.
+    This function computes C = zip_i C_i, which is equivalent to A * B when only keeping the `top_n` elements.
+    It allows very large matrices to be split and multiplied with a limited memory footprint.
+
+    Args:
+        top_n: the number of results to retain; should be smaller or equal to top_n used to obtain C_mats.
+        C_mats: a list with each C_i sub-matrix, with format csr_matrix.
+
+    Returns:
+        C: zipped result matrix
+
+    Raises:
+        TypeError: when not all elements of `C_mats` is a csr_matrix or trivially convertable
+        ValueError: when not all elements of `C_mats` has the same number of rows
+    """
+    _nrows = []
+    ncols = []
+    data = []
+    indptr = []
+    indices = []
+    for C in C_mats:
+        # check correct type of each C
+        if isinstance(C, (coo_matrix, csc_matrix)):
+            C = C.tocsr(False)
+        elif not isinstance(C, csr_matrix):
+            msg = f"type of `C` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(C)}`"
+            raise TypeError(msg)
+
+        nrows, c_nc = C.shape
+        _nrows.append(nrows)
+        ncols.append(c_nc)
+        data.append(C.data)
+        indptr.append(C.indptr)
+        indices.append(C.indices)
+
+    ncols = np.asarray(ncols, int)
+    # the sub-matrices must share the index layout, widen only where they disagree
+    idx_dtype = np.result_type(*indices)
+    ptr_dtype = np.result_type(*indptr, idx_dtype)
+    # Z holds at most `top_n` elements per row and never more than the sub-matrices combined,
+    # the bound is used to size Z and can exceed the range of 32bit index pointers
+    Z_max_nnz = min(sum(arr.size for arr in data), nrows * top_n)
+    if Z_max_nnz > np.iinfo(ptr_dtype).max:
+        ptr_dtype = np.dtype(np.int64)
+    indices = [arr.astype(idx_dtype, copy=False) for arr in indices]
+    indptr = [arr.astype(ptr_dtype, copy=False) for arr in indptr]
+    total_cols = ncols.sum()
+    if not np.all(np.diff(_nrows) == 0):
+        msg = "Each `C` in `C_mats` should have the same number of rows."
+        raise ValueError(msg)
+
+    Z_data, Z_indices, Z_indptr = _core.zip_sp_matmul_topn(
+        top_n=top_n, Z_max_nnz=Z_max_nnz, nrows=nrows, B_ncols=ncols, data=data, indptr=indptr, indices=indices
+    )
+    return _to_csr_result((Z_data, Z_indices, Z_indptr), shape=(nrows, total_cols))
+
+
+class ZipAccumulator:
+    """Compute zip-matrix C = zip_j C_j = zip_j A * B_j = A * B incrementally whilst only storing the `top_n` elements.
+
+    Streaming counterpart of `zip_sp_matmul_topn`, the sub-matrices C_j are
+    added one at a time and merged into a per-row top-n state after which they
+    are no longer referenced. Only a single C_j has to be in memory at a time
+    and the memory of the state is bounded by `nrows * top_n` elements.
+    The sub-matrices must be added in the order of the blocks B_j, the column
+    indices of C_j are offset by the number of columns added before it.
+
+    `add` can be called from multiple threads, the calls are serialised and the
+    column offsets of the sub-matrices follow the order in which they are merged.
+
+    Args:
+        top_n: the number of results to retain; should be smaller or equal to top_n used to obtain C_j.
+        nrows: the number of rows of each C_j
+        n_threads: number of threads used to merge each C_j, `None` implies sequential processing,
+            -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers, defaults to the index dtypes of the first C_j
+
+    Examples:
+        >>> acc = ZipAccumulator(top_n=10, nrows=A.shape[0])
+        >>> for B_j in blocks:
+        ...     acc.add(sp_matmul_topn(A, B_j, top_n=10))
+        >>> C = acc.finalize()
+
+    """
+
+    def __init__(self, top_n: int, nrows: int, n_threads: int | None = None, idx_dtype: DTypeLike | None = None):
+        n_threads: int = n_threads or 1
+        if n_threads < 0:
+            n_threads = _N_CORES
+        if n_threads > 1 and not _core._has_openmp_support:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+            n_threads = 1
+        if idx_dtype is not None:
+            idx_dtype = np.dtype(assert_idx_dtype(idx_dtype))
+        self.top_n = top_n
+        self.nrows = nrows
+        self._n_threads = n_threads
+        self._idx_dtype = idx_dtype
+        self._ptr_dtype = idx_dtype
+        self._acc = None
+        self._ncols = 0
+        self._finalized = False
+        self._lock = threading.Lock()
+
+    @property
+    def ncols(self) -> int:
+        """The number of columns added so far."""
+        return self._ncols
+
+    def _init_state(self, C: csr_matrix):
+        if self._idx_dtype is None:
+            self._idx_dtype = C.indices.dtype
+            self._ptr_dtype = np.result_type(C.indptr, C.indices)
+        # the state holds up to `nrows * top_n` elements
+        if np.iinfo(self._ptr_dtype).max < self.nrows * self.top_n:
+            self._ptr_dtype = np.dtype(np.int64)
+        self._dtype = C.dtype
+        acc_type = getattr(_core, f"ZipAccumulator_{self._dtype.name}_{self._idx_dtype.name}_{self._ptr_dtype.name}")
+        self._acc = acc_type(top_n=self.top_n, nrows=self.nrows)
+
+    def add(self, C: csr_matrix | csc_matrix | coo_matrix) -> None:
+        """Merge the next sub-matrix C_j = A * B_j.
+
+        Args:
+            C: the sub-matrix, must have `nrows` rows and the dtype of the first sub-matrix
+
+        Raises:
+            TypeError: when `C` is not a csr_matrix or trivially convertable
+            ValueError: when `C` does not have `nrows` rows or the accumulator has been finalized
+
+        """
+        if isinstance(C, (coo_matrix, csc_matrix)):
+            C = C.tocsr(False)
+        elif not isinstance(C, csr_matrix):
+            msg = f"type of `C` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(C)}`"
+            raise TypeError(msg)
+        if C.shape[0] != self.nrows:
+            msg = f"`C` should have {self.nrows} rows, got {C.shape[0]}"
+            raise ValueError(msg)
+        assert_supported_dtype(C)
+        with self._lock:
+            self._add(C)
+
+    def _add(self, C: csr_matrix) -> None:
+        if self._finalized:
+            msg = "the accumulator has been finalized"
+            raise ValueError(msg)
+        if self._acc is None:
+            self._init_state(C)
+        elif C.dtype != self._dtype:
+            msg = f"`C` should have dtype {self._dtype} consistent with the previous sub-matrices, got {C.dtype}"
+            raise TypeError(msg)
+        if self.ncols + C.shape[1] > np.iinfo(self._idx_dtype).max:
+            msg = f"the number of columns exceeds the range of `idx_dtype` {self._idx_dtype}"
+            raise ValueError(msg)
+
+        kwargs = {
+            "ncols": C.shape[1],
+            "data": C.data,
+            "indptr": C.indptr.astype(self._ptr_dtype, copy=False),
+            "indices": C.indices.astype(self._idx_dtype, copy=False),
+        }
+        if self._n_threads > 1:
+            self._acc.add_mt(n_threads=self._n_threads, **kwargs)
+        else:
+            self._acc.add(**kwargs)
+        self._ncols += C.shape[1]
+
+    def finalize(self) -> csr_matrix:
+        """Return the zipped result and release the state.
+
+        Returns:
+            C: zipped result matrix, the rows are sorted such that the first non-zero element is the largest value
+
+        """
+        with self._lock:
+            if self._finalized:
+                msg = "the accumulator has been finalized"
+                raise ValueError(msg)
+            self._finalized = True
+            acc, self._acc = self._acc, None
+        if acc is None:
+            idx_dtype = self._idx_dtype or np.dtype(np.int32)
+            C = (np.zeros(0, dtype=np.float64), np.zeros(0, dtype=idx_dtype), np.zeros(self.nrows + 1, dtype=idx_dtype))
+        else:
+            C = acc.finalize()
+        return _to_csr_result(C, shape=(self.nrows, self._ncols))
+
+
+def sp_matmul_topn_update(
+    C: csr_matrix | csc_matrix | coo_matrix,
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    B_delta: csr_matrix | csc_matrix | coo_matrix | None = None,
+    tombstones: ArrayLike | None = None,
+    threshold: int | float | None = None,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+) -> csr_matrix:
+    """Update C = A * B, computed by `sp_matmul_topn`, with appended and tombstoned columns of B.
+
+    The new columns `B_delta` are multiplied with A and their `top_n` elements are zipped into C,
+    see `zip_sp_matmul_topn`. The elements of C in the `tombstones` columns are removed, only the rows
+    that held `top_n` elements and lost one are recomputed against `B` as they may have dropped their successors.
+    A recomputed row only gathers the rows of `B` it selects, the cost of an update therefore scales with
+    the size of the delta rather than the size of `B`. Note that `B` is transposed when rows are recomputed
+    and it is not a CSR matrix with `B.shape[0] == A.shape[1]`.
+
+    The tombstoned columns are retained as empty columns such that the column indices remain stable,
+    the columns of `B_delta` are appended after the columns of `B`. `B` must be the matrix C was computed from
+    with the columns tombstoned in earlier updates emptied.
+
+    Args:
+        C: the previous result, `A * B` with the same `top_n` and `threshold`
+        A: LHS of the multiplication
+        B: RHS of the previous multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` is only used to recompute the rows affected by the tombstones.
+        top_n: the number of results to retain
+        B_delta: the columns to append, in the same orientation as `B`
+        tombstones: the column indices of C to remove
+        threshold: only return values greater than the threshold
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices and index pointers of the products, defaults to the index dtypes of `A` and `B`.
+
+    Throws:
+        TypeError: when C, A, B are not trivially convertable to a `CSR matrix`
+        ValueError: when the shapes of C, A and B do not match or a tombstone is out of range
+
+    Returns:
+        C: updated result matrix with `B.shape[1] + B_delta.shape[1]` columns,
+            the rows are sorted such that the first non-zero element is the largest value
+
+    """
+    if isinstance(C, (coo_matrix, csc_matrix)):
+        C = C.tocsr(False)
+    elif not isinstance(C, csr_matrix):
+        msg = f"type of `C` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(C)}`"
+        raise TypeError(msg)
+    for name, M in (("A", A), ("B", B)):
+        if not isinstance(M, (csr_matrix, csc_matrix, coo_matrix)):
+            msg = f"type of `{name}` must be one of `csr_matrix`, `csc_matrix` or `csr_matrix`, got `{type(M)}`"
+            raise TypeError(msg)
+
+    # only validate the shapes, `B` is converted when rows have to be recomputed such that
+    # an update without refills does not pay for a conversion or transpose of `B`
+    if A.shape[1] == B.shape[0]:
+        B_ncols = B.shape[1]
+    elif A.shape[1] == B.shape[1]:
+        B_ncols = B.shape[0]
+    else:
+        msg = "Matrices `A` and `B` have incompatible shapes. `A.shape[1]` must be equal to `B.shape[0]` or `B.shape[1]`."
+        raise ValueError(msg)
+    nrows, ncols = C.shape
+    if A.shape[0] != nrows or B_ncols != ncols:
+        msg = f"`C` should have shape {(A.shape[0], B_ncols)}, got {C.shape}"
+        raise ValueError(msg)
+
+    dead = np.zeros(ncols, dtype=bool)
+    if tombstones is not None:
+        tombstones = np.asarray(tombstones, dtype=np.int64)
+        if tombstones.size > 0 and (tombstones.min() < 0 or tombstones.max() >= ncols):
+            msg = f"`tombstones` should be column indices in [0, {ncols})"
+            raise ValueError(msg)
+        dead[tombstones] = True
+
+    # a row that held `top_n` elements and lost one can have dropped its successors,
+    # the other rows retained all their elements above the threshold
+    row_nnz = np.diff(C.indptr)
+    rows = np.repeat(np.arange(nrows), row_nnz)
+    removed = dead[C.indices]
+    refill = np.zeros(nrows, dtype=bool)
+    refill[rows[removed]] = True
+    refill &= row_nnz >= top_n
+
+    keep = ~(removed | refill[rows])
+    C_indptr = np.zeros(nrows + 1, dtype=C.indptr.dtype)
+    np.cumsum(np.bincount(rows[keep], minlength=nrows), out=C_indptr[1:])
+    C_new = _to_csr_result((C.data[keep], C.indices[keep], C_indptr), shape=(nrows, ncols))
+
+    if refill.any():
+        A, B = _to_csr_operands(A, B, n_threads or 1)
+        refill_rows = np.flatnonzero(refill)
+        A_refill = A[refill_rows]
+        # only the rows of `B` selected by the recomputed rows are copied and cleared of the tombstoned columns
+        used, A_refill_indices = np.unique(A_refill.indices, return_inverse=True)
+        A_refill = csr_matrix(
+            (A_refill.data, A_refill_indices.astype(A_refill.indices.dtype), A_refill.indptr),
+            shape=(refill_rows.size, used.size),
+        )
+        B_live = B[used]
+        B_live.data[dead[B_live.indices]] = 0
+        B_live.eliminate_zeros()
+        C_refill = sp_matmul_topn(
+            A_refill, B_live, top_n=top_n, threshold=threshold, n_threads=n_threads, idx_dtype=idx_dtype
+        )
+        # scatter the recomputed rows, their rows in `C_new` are empty
+        R_indptr = np.zeros(nrows + 1, dtype=C_refill.indptr.dtype)
+        R_indptr[refill_rows + 1] = np.diff(C_refill.indptr)
+        np.cumsum(R_indptr, out=R_indptr)
+        C_new = C_new + _to_csr_result((C_refill.data, C_refill.indices, R_indptr), shape=(nrows, ncols))
+
+    C_mats = [C_new]
+    if B_delta is not None:
+        A, B_delta = _to_csr_operands(A, B_delta, n_threads or 1)
+        C_mats.append(
+            sp_matmul_topn(A, B_delta, top_n=top_n, threshold=threshold, n_threads=n_threads, idx_dtype=idx_dtype)
+        )
+    return zip_sp_matmul_topn(top_n, C_mats)
+
+
+def sp_matmul_topn_sharded(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    path: str | PathLike,
+    top_n: int,
+    threshold: int | float | None = None,
+    n_threads: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+    mmap: bool = True,
+) -> csr_matrix:
+    """Compute C = A * B.T whilst only storing the `top_n` elements, where B is stored on disk in shards.
+
+    The shards written by `save_csr_shards` are processed one at a time, the
+    top-n product with each shard is folded into the running top-n result
+    with a `ZipAccumulator`. The peak memory is therefore bounded by a single
+    shard and the `top_n` elements per row rather than by the complete `B`.
+
+    Args:
+        A: LHS of the multiplication, `A.shape[1]` must be equal to `B.shape[1]`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        path: the directory the shards of `B` were stored in with `save_csr_shards`
+        top_n: the number of results to retain
+        threshold: only return values greater than the threshold
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+        idx_dtype: dtype to use for the indices, defaults to 32bit integers
+        mmap: memory-map the shards rather than reading each shard into memory with sequential reads
+
+    Returns:
+        C: result matrix, the rows are sorted such that the first non-zero element is the largest value
+
+    """
+    acc = None
+    for _, B_j in load_csr_shards(path, mmap=mmap):
+        C_j = sp_matmul_topn(A, B_j, top_n=top_n, threshold=threshold, n_threads=n_threads, idx_dtype=idx_dtype)
+        if acc is None:
+            acc = ZipAccumulator(top_n=top_n, nrows=C_j.shape[0], n_threads=n_threads, idx_dtype=idx_dtype)
+        acc.add(C_j)
+        del B_j, C_j
+    if acc is None:
+        msg = f"`{path}` does not contain any shards"
+        raise ValueError(msg)
+    return acc.finalize()
@@ -0,0 +1,212 @@
+# Copyright (c) 2023 ING Analytics Wholesale Banking
+from __future__ import annotations
+
+from concurrent.futures import ProcessPoolExecutor
+from multiprocessing import shared_memory
+from typing import TYPE_CHECKING
+
+import numpy as np
+from scipy.sparse import coo_matrix, csc_matrix, csr_matrix
+
+from sparse_dot_topn.api import _N_CORES, _index_arrays, _to_csr_operands, _widen_indptr
+from sparse_dot_topn.lib import _sparse_dot_topn_core as _core
+from sparse_dot_topn.types import assert_idx_dtype, assert_supported_dtype, ensure_compatible_dtype
+
+if TYPE_CHECKING:
+    from numpy.types import DTypeLike, NDArray
+
+__all__ = ["sp_matmul_topn_mp"]
+
+# shared memory segments attached by a worker process, set by `_init_worker`
+_WORKER_SEGMENTS: dict[str, shared_memory.SharedMemory] = {}
+_WORKER_SPECS: dict[str, tuple[str, tuple[int, ...], str]] = {}
+_WORKER_PARAMS: dict[str, int | float | bool | None] = {}
+
+
+def _to_shared(arr: NDArray) -> tuple[shared_memory.SharedMemory, tuple[str, tuple[int, ...], str]]:
+    """Copy `arr` into a new shared memory segment."""
+    shm = shared_memory.SharedMemory(create=True, size=max(arr.nbytes, 1))
+    view = np.ndarray(arr.shape, dtype=arr.dtype, buffer=shm.buf)
+    view[...] = arr
+    del view
+    return shm, (shm.name, arr.shape, arr.dtype.str)
+
+
+def _empty_shared(
+    shape: tuple[int, ...], dtype: DTypeLike
+) -> tuple[shared_memory.SharedMemory, tuple[str, tuple[int, ...], str]]:
+    """Allocate an uninitialised shared memory segment for an array of `shape`."""
+    dtype = np.dtype(dtype)
+    shm = shared_memory.SharedMemory(create=True, size=max(int(np.prod(shape)) * dtype.itemsize, 1))
+    return shm, (shm.name, shape, dtype.str)
+
+
+def _view(shm: shared_memory.SharedMemory, spec: tuple[str, tuple[int, ...], str]) -> NDArray:
+    """Zero-copy view on the array stored in `shm`.
+
+    Views must not outlive the call they are created in, an exported buffer
+    prevents the segment from being closed.
+    """
+    return np.ndarray(spec[1], dtype=np.dtype(spec[2]), buffer=shm.buf)
+
+
+def _init_worker(specs: dict[str, tuple[str, tuple[int, ...], str]], params: dict[str, int | float | bool | None]):
+    # The workers share the resource tracker of the parent process, which
+    # remains the owner of the segments and is responsible for unlinking them.
+    for key, spec in specs.items():
+        _WORKER_SEGMENTS[key] = shared_memory.SharedMemory(name=spec[0])
+    _WORKER_SPECS.update(specs)
+    _WORKER_PARAMS.update(params)
+
+
+def _sp_matmul_topn_block(start: int, stop: int) -> None:
+    """Compute the top-n product for rows [start, stop) of `A` and store it in the output slots."""
+    arrs = {key: _view(_WORKER_SEGMENTS[key], spec) for key, spec in _WORKER_SPECS.items()}
+    top_n = _WORKER_PARAMS["top_n"]
+    func = _core.sp_matmul_topn_sorted if _WORKER_PARAMS["sort"] else _core.sp_matmul_topn
+
+    # the kernels use `A_indptr` as an absolute offset into `A_data` and
+    # `A_indices` so a slice of the index pointer selects the row block without copies
+    C_data, C_indices, C_indptr = func(
+        top_n=top_n,
+        nrows=stop - start,
+        ncols=_WORKER_PARAMS["ncols"],
+        threshold=_WORKER_PARAMS["threshold"],
+        density=None,
+        A_data=arrs["A_data"],
+        A_indptr=arrs["A_indptr"][start : stop + 1],
+        A_indices=arrs["A_indices"],
+        B_data=arrs["B_data"],
+        B_indptr=arrs["B_indptr"],
+        B_indices=arrs["B_indices"],
+    )
+
+    # scatter the rows into their `top_n` wide slots
+    row_nnz = np.diff(C_indptr)
+    slots = np.repeat(np.arange(start, stop, dtype=np.int64) * top_n - C_indptr[:-1], row_nnz)
+    slots += np.arange(C_indptr[-1], dtype=np.int64)
+    arrs["values"][slots] = C_data
+    arrs["indices"][slots] = C_indices
+    arrs["row_nnz"][start:stop] = row_nnz
+    del arrs
+
+
+def sp_matmul_topn_mp(
+    A: csr_matrix | csc_matrix | coo_matrix,
+    B: csr_matrix | csc_matrix | coo_matrix,
+    top_n: int,
+    threshold: int | float | None = None,
+    sort: bool = False,
+    n_workers: int | None = None,
+    block_size: int | None = None,
+    idx_dtype: DTypeLike | None = None,
+    mp_context=None,
+) -> csr_matrix:
+    """Compute A * B whilst only storing the `top_n` elements using multiple processes.
+
+    `A` and `B` are placed once in POSIX shared memory, each worker process
+    operates on a zero-copy view of the operands and computes the top-n product
+    for blocks of rows of `A`. The results are written by the workers directly
+    into a shared output buffer of `A.shape[0] * top_n` elements, so neither the
+    operands nor the results are serialised between processes.
+
+    This is useful in environments where the number of threads per process is capped,
+    otherwise `sp_matmul_topn` with `n_threads` has a lower overhead.
+
+    Args:
+        A: LHS of the multiplication, the number of columns of A determines the orientation of B.
+            `A` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `B`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        B: RHS of the multiplication, the number of rows of B must match the number of columns of A or the shape of B.T should be match A.
+            `B` must be have an {32, 64}bit {int, float} dtype that is of the same kind as `A`.
+            Note the matrix is converted (copied) to CSR format if a CSC or COO matrix.
+        top_n: the number of results to retain
+        threshold: only return values greater than the threshold
+        sort: return C in a format where the first non-zero element of each row is the largest value
+        n_workers: number of worker processes to use, `None` or -1 will use all but one of the available cores.
+        block_size: the number of rows of `A` per task, defaults to spreading `A` in four blocks per worker
+        idx_dtype: dtype to use for the indices, defaults to the dtype of the indices of `A` and `B`
+        mp_context: multiprocessing context used to start the workers, defaults to the platform default
+
+    Throws:
+        TypeError: when A, B are not trivially convertable to a `CSR matrix`
+
+    Returns:
+        C: result matrix
+
+    """
+    n_workers = n_workers or -1
+    if n_workers < 0:
+        n_workers = max(_N_CORES, 1)
+    if idx_dtype is not None:
+        idx_dtype = assert_idx_dtype(idx_dtype)
+
+    A, B = _to_csr_operands(A, B)
+    A_nrows = A.shape[0]
+    B_ncols = B.shape[1]
+
+    assert_supported_dtype(A)
+    assert_supported_dtype(B)
+    ensure_compatible_dtype(A, B)
+    A_indptr, A_indices, B_indptr, B_indices = _index_arrays(A, B, idx_dtype)
+
+    # guard against top_n larger than number of cols
+    top_n = min(top_n, B_ncols)
+
+    # handle threshold
+    if threshold is not None:
+        threshold = int(np.rint(threshold)) if np.issubdtype(A.data.dtype, np.integer) else float(threshold)
+
+    # basic check. if A or B are all zeros matrix, return all zero matrix directly
+    if A.indices.size == 0 or B.indices.size == 0 or top_n < 1:
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        C_indices = np.zeros(1, dtype=A_indices.dtype)
+        C_data = np.zeros(1, dtype=A.dtype)
+        return csr_matrix((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
+    A_indptr, B_indptr = _widen_indptr(A_indptr, A_indices, B_indptr, A_nrows, B_ncols, top_n)
+
+    block_size = block_size or max(-(-A_nrows // (4 * n_workers)), 1)
+
+    segments = {}
+    specs = {}
+    try:
+        for key, arr in (
+            ("A_data", A.data),
+            ("A_indptr", A_indptr),
+            ("A_indices", A_indices),
+            ("B_data", B.data),
+            ("B_indptr", B_indptr),
+            ("B_indices", B_indices),
+        ):
+            segments[key], specs[key] = _to_shared(arr)
+        for key, shape, dtype in (
+            ("values", (A_nrows * top_n,), A.dtype),
+            ("indices", (A_nrows * top_n,), A_indices.dtype),
+            ("row_nnz", (A_nrows,), A_indices.dtype),
+        ):
+            segments[key], specs[key] = _empty_shared(shape, dtype)
+
+        params = {"top_n": top_n, "ncols": B_ncols, "threshold": threshold, "sort": sort}
+        with ProcessPoolExecutor(
+            max_workers=n_workers, mp_context=mp_context, initializer=_init_worker, initargs=(specs, params)
+        ) as pool:
+            starts = range(0, A_nrows, block_size)
+            futures = [pool.submit(_sp_matmul_topn_block, i, min(i + block_size, A_nrows)) for i in starts]
+            for fut in futures:
+                fut.result()
+
+        # gather the filled part of each slot
+        values = _view(segments["values"], specs["values"]).reshape(A_nrows, top_n)
+        indices = _view(segments["indices"], specs["indices"]).reshape(A_nrows, top_n)
+        row_nnz = _view(segments["row_nnz"], specs["row_nnz"])
+        C_indptr = np.zeros(A_nrows + 1, dtype=A_indptr.dtype)
+        np.cumsum(row_nnz, out=C_indptr[1:])
+        filled = np.arange(top_n, dtype=row_nnz.dtype) < row_nnz[:, None]
+        C_data = values[filled]
+        C_indices = indices[filled]
+        del values, indices, row_nnz, filled
+    finally:
+        for shm in segments.values():
+            shm.close()
+            shm.unlink()
+    return csr_matrix((C_data, C_indices, C_indptr), shape=(A_nrows, B_ncols))
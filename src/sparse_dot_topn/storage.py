@@ -0,0 +1,259 @@
+# Copyright (c) 2023 ING Analytics Wholesale Banking
+from __future__ import annotations
+
+import json
+import struct
+from pathlib import Path
+from typing import TYPE_CHECKING, Iterator
+
+import numpy as np
+from scipy.sparse import coo_matrix, csc_matrix, csr_matrix
+
+if TYPE_CHECKING:
+    from os import PathLike
+
+    from numpy.types import DTypeLike, NDArray
+
+__all__ = ["CSRWriter", "save_csr", "load_csr", "save_csr_shards", "load_csr_shards"]
+
+_SHARDS_FORMAT = "sparse_dot_topn.csr_shards"
+_SHARDS_VERSION = 1
+_MANIFEST = "manifest.json"
+
+
+class _NpyAppender:
+    """Write a 1D `.npy` file of unknown length by appending chunks.
+
+    The header is written with a fixed size such that it can be rewritten in
+    place with the final shape when the file is closed.
+    """
+
+    _HEADER_SIZE = 128
+
+    def __init__(self, path: Path, dtype: DTypeLike):
+        self.path = path
+        self.dtype = np.dtype(dtype)
+        self.size = 0
+        self._fh = open(path, "wb")  # noqa: SIM115
+        self._write_header()
+
+    def _write_header(self):
+        header = {
+            "descr": np.lib.format.dtype_to_descr(self.dtype),
+            "fortran_order": False,
+            "shape": (self.size,),
+        }
+        magic = np.lib.format.magic(1, 0)
+        header = repr(header).encode("latin1")
+        header += b" " * (self._HEADER_SIZE - len(magic) - 2 - len(header) - 1) + b"\n"
+        self._fh.seek(0)
+        self._fh.write(magic + struct.pack("<H", len(header)) + header)
+
+    def append(self, arr: NDArray):
+        self._fh.seek(0, 2)
+        np.ascontiguousarray(arr, dtype=self.dtype).tofile(self._fh)
+        self.size += arr.size
+
+    def close(self):
+        if self._fh.closed:
+            return
+        self._write_header()
+        self._fh.close()
+
+    def discard(self):
+        self._fh.close()
+        self.path.unlink(missing_ok=True)
+
+
+class CSRWriter:
+    """Append blocks of rows of a CSR matrix to a directory on disk.
+
+    The result is stored in the same layout as `save_csr` and can be read,
+    or memory-mapped, with `load_csr`. Instances can be passed as the `sink` of
+    `sp_matmul_topn_chunked`.
+
+    Args:
+        path: the directory to store the matrix in, created if it does not exist
+        ncols: the number of columns of the matrix
+        dtype: the dtype of the non-zero elements
+        idx_dtype: the dtype of `indices` and `indptr`
+
+    """
+
+    def __init__(self, path: str | PathLike, ncols: int, dtype: DTypeLike, idx_dtype: DTypeLike = np.int64):
+        self.path = Path(path)
+        self._created = not self.path.exists()
+        self.path.mkdir(parents=True, exist_ok=True)
+        self.ncols = ncols
+        self.nrows = 0
+        self.nnz = 0
+        self._data = _NpyAppender(self.path / "data.npy", dtype)
+        self._indices = _NpyAppender(self.path / "indices.npy", idx_dtype)
+        self._indptr = _NpyAppender(self.path / "indptr.npy", idx_dtype)
+        self._indptr.append(np.zeros(1, dtype=idx_dtype))
+
+    def __call__(self, start: int, data: NDArray, indices: NDArray, indptr: NDArray):
+        """Append the rows [start, start + indptr.size - 1).
+
+        Args:
+            start: the index of the first row of the block, must be equal to the number of rows written
+            data: the non-zero elements of the block
+            indices: the column indices of the block
+            indptr: the row indices of the block, starting at zero
+
+        """
+        if start != self.nrows:
+            msg = f"blocks must be appended in order, expected a block starting at row {self.nrows} got {start}"
+            raise ValueError(msg)
+        nnz = int(indptr[-1])
+        self._data.append(data[:nnz])
+        self._indices.append(indices[:nnz])
+        self._indptr.append(indptr[1:].astype(np.int64) + self.nnz)
+        self.nrows += indptr.size - 1
+        self.nnz += nnz
+
+    def close(self) -> Path:
+        """Finalise the files, the matrix can be loaded once the writer is closed."""
+        self._data.close()
+        self._indices.close()
+        self._indptr.close()
+        np.save(self.path / "format.npy", np.array(b"csr"))
+        np.save(self.path / "shape.npy", np.array((self.nrows, self.ncols)))
+        return self.path
+
+    def discard(self):
+        """Remove the partially written files, e.g. after an error whilst writing."""
+        self._data.discard()
+        self._indices.discard()
+        self._indptr.discard()
+        if self._created and not any(self.path.iterdir()):
+            self.path.rmdir()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, *args):
+        if exc_type is not None:
+            self.discard()
+        else:
+            self.close()
+
+
+def save_csr(path: str | PathLike, M: csr_matrix) -> Path:
+    """Store `M` as a directory of uncompressed `.npy` files.
+
+    The directory contains the same members as a `scipy.sparse.save_npz` archive
+    (`data`, `indices`, `indptr`, `format` and `shape`) but keeps them as separate
+    files such that they can be memory-mapped by `load_csr`.
+
+    Args:
+        path: the directory to store the matrix in, created if it does not exist
+        M: the matrix to store
+
+    Returns:
+        path: the directory the matrix was stored in
+
+    """
+    path = Path(path)
+    path.mkdir(parents=True, exist_ok=True)
+    np.save(path / "data.npy", M.data)
+    np.save(path / "indices.npy", M.indices)
+    np.save(path / "indptr.npy", M.indptr)
+    np.save(path / "format.npy", np.array(b"csr"))
+    np.save(path / "shape.npy", np.array(M.shape))
+    return path
+
+
+def load_csr(path: str | PathLike, mmap: bool = True) -> csr_matrix:
+    """Load a matrix stored with `save_csr`.
+
+    Args:
+        path: the directory the matrix was stored in
+        mmap: memory-map the arrays rather than reading them into memory.
+            The arrays are mapped copy-on-write, the files are never modified.
+
+    Returns:
+        M: the stored matrix
+
+    """
+    path = Path(path)
+    mmap_mode = "c" if mmap else None
+    shape = tuple(np.load(path / "shape.npy"))
+    data = np.load(path / "data.npy", mmap_mode=mmap_mode)
+    indices = np.load(path / "indices.npy", mmap_mode=mmap_mode)
+    indptr = np.load(path / "indptr.npy", mmap_mode=mmap_mode)
+    return csr_matrix((data, indices, indptr), shape=shape, copy=False)
+
+
+def save_csr_shards(
+    B: csr_matrix | csc_matrix | coo_matrix, path: str | PathLike, shard_size: int
+) -> list[Path]:
+    """Split `B` row-wise into shards and store them on disk.
+
+    `B` is the right-hand side in the `A * B.T` orientation, e.g. an index of
+    entities where each row is an entity. Each shard of `shard_size` rows `B_j`
+    is stored transposed, as the CSR matrix `B_j.T`, such that it can be used
+    without conversion by `sp_matmul_topn_sharded`.
+
+    Args:
+        B: the matrix to split, rows correspond to the columns of `A * B.T`
+        path: the directory to store the shards in, created if it does not exist
+        shard_size: the maximum number of rows of `B` per shard
+
+    Returns:
+        paths: the directories of the shards
+
+    """
+    if shard_size < 1:
+        msg = "`shard_size` must be at least one."
+        raise ValueError(msg)
+    B = B.tocsr()
+    path = Path(path)
+    path.mkdir(parents=True, exist_ok=True)
+    nrows, ncols = B.shape
+
+    shards = []
+    paths = []
+    for j, start in enumerate(range(0, nrows, shard_size)):
+        stop = min(start + shard_size, nrows)
+        name = f"shard_{j:05d}"
+        paths.append(save_csr(path / name, B[start:stop].transpose().tocsr()))
+        shards.append({"path": name, "nrows": stop - start})
+
+    manifest = {
+        "format": _SHARDS_FORMAT,
+        "version": _SHARDS_VERSION,
+        "shape": [nrows, ncols],
+        "dtype": B.dtype.str,
+        "shards": shards,
+    }
+    with open(path / _MANIFEST, "w") as fh:
+        json.dump(manifest, fh, indent=2)
+    return paths
+
+
+def load_csr_shards(path: str | PathLike, mmap: bool = True) -> Iterator[tuple[int, csr_matrix]]:
+    """Iterate over the shards stored with `save_csr_shards`.
+
+    Only a single shard is loaded (or mapped) at a time.
+
+    Args:
+        path: the directory the shards were stored in
+        mmap: memory-map the shards rather than reading them into memory
+
+    Yields:
+        offset: the index of the first row of `B` in the shard
+        B_j_T: the transposed shard as CSR matrix
+
+    """
+    path = Path(path)
+    with open(path / _MANIFEST) as fh:
+        manifest = json.load(fh)
+    if manifest.get("format") != _SHARDS_FORMAT or manifest.get("version") != _SHARDS_VERSION:
+        msg = f"`{path}` does not contain shards written by `save_csr_shards`"
+        raise ValueError(msg)
+
+    offset = 0
+    for shard in manifest["shards"]:
+        yield offset, load_csr(path / shard["path"], mmap=mmap)
+        offset += shard["nrows"]
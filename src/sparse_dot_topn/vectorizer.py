@@ -0,0 +1,199 @@
+# Copyright (c) 2023 ING Analytics Wholesale Banking
+from __future__ import annotations
+
+import warnings
+from typing import TYPE_CHECKING, Iterable
+
+import numpy as np
+
+from sparse_dot_topn.api import _N_CORES, _to_csr_result
+from sparse_dot_topn.lib import _sparse_dot_topn_core as _core
+from sparse_dot_topn.types import assert_idx_dtype
+
+if TYPE_CHECKING:
+    from numpy.types import DTypeLike, NDArray
+    from scipy.sparse import csr_matrix
+
+__all__ = ["NgramTfidfVectorizer"]
+
+
+def _encode(docs: Iterable[str], lowercase: bool) -> tuple[NDArray, NDArray]:
+    """Concatenate the UTF-8 encoding of the documents and compute their offsets."""
+    encoded = [(doc.lower() if lowercase else doc).encode("utf-8") for doc in docs]
+    offsets = np.zeros(len(encoded) + 1, dtype=np.int64)
+    np.cumsum([len(doc) for doc in encoded], out=offsets[1:])
+    # a bytearray as the extension does not accept read-only arrays
+    data = np.frombuffer(bytearray(b"".join(encoded)), dtype=np.uint8)
+    return data, offsets
+
+
+class NgramTfidfVectorizer:
+    """Convert strings to TF-IDF weighted character n-grams, in parallel over the documents.
+
+    The counterpart of ``sklearn.feature_extraction.text.TfidfVectorizer(analyzer="char", ngram_range=(n, n))``
+    that emits the CSR matrix directly in the dtypes expected by the kernels.
+    The n-grams are formed of unicode code points, unlike sklearn white space is not normalised.
+    The n-grams are mapped to a vocabulary learned by `fit`, sorted as in sklearn, or hashed into `n_features`
+    columns when `n_features` is set. The column indices of each row are sorted.
+
+    Args:
+        n: the number of characters per n-gram
+        n_features: hash the n-grams into `n_features` columns instead of learning a vocabulary
+        lowercase: convert the documents to lowercase
+        use_idf: weight the term frequencies with the inverse document frequency
+        smooth_idf: add one to the document frequencies as if an extra document contained every n-gram once
+        sublinear_tf: use ``1 + log(tf)`` as term frequency
+        norm: scale the rows to unit ``"l2"`` norm or not at all when `None`
+        dtype: the dtype of the values, one of {float32, float64}
+        idx_dtype: the dtype of the indices and index pointers, defaults to int32. The index pointers are
+            widened to int64 when the number of non-zero elements may exceed the range of `idx_dtype`
+        n_threads: number of threads to use, `None` implies sequential processing, -1 will use all but one of the available cores.
+
+    Examples:
+        >>> vectorizer = NgramTfidfVectorizer(n=3, n_threads=-1).fit(names)
+        >>> A = vectorizer.transform(names)
+        >>> C = sp_matmul_topn(A, A.T, top_n=10, threshold=0.8, n_threads=-1)
+
+    """
+
+    def __init__(
+        self,
+        n: int = 3,
+        n_features: int | None = None,
+        lowercase: bool = True,
+        use_idf: bool = True,
+        smooth_idf: bool = True,
+        sublinear_tf: bool = False,
+        norm: str | None = "l2",
+        dtype: DTypeLike = np.float64,
+        idx_dtype: DTypeLike | None = None,
+        n_threads: int | None = None,
+    ):
+        if n < 1:
+            msg = "`n` must be at least 1"
+            raise ValueError(msg)
+        if n_features is not None and n_features < 1:
+            msg = "`n_features` must be at least 1"
+            raise ValueError(msg)
+        if norm not in ("l2", None):
+            msg = f"`norm` must be one of {{'l2', None}}, got: {norm}"
+            raise ValueError(msg)
+        dtype = np.dtype(dtype)
+        if dtype not in (np.dtype(np.float32), np.dtype(np.float64)):
+            msg = f"`dtype` must be one of {{float32, float64}}, got: {dtype}"
+            raise TypeError(msg)
+        if idx_dtype is not None:
+            idx_dtype = np.dtype(assert_idx_dtype(idx_dtype))
+        n_threads: int = n_threads or 1
+        if n_threads < 0:
+            n_threads = _N_CORES
+        if n_threads > 1 and not _core._has_openmp_support:
+            msg = "sparse_dot_topn: extension was compiled without parallelisation (OpenMP) support, ignoring ``n_threads``"
+            warnings.warn(msg, stacklevel=1)
+            n_threads = 1
+        self.n = n
+        self.n_features = n_features
+        self.lowercase = lowercase
+        self.use_idf = use_idf
+        self.smooth_idf = smooth_idf
+        self.sublinear_tf = sublinear_tf
+        self.norm = norm
+        self.dtype = dtype
+        self.idx_dtype = idx_dtype
+        self._n_threads = n_threads
+        self._vocab = (np.zeros(0, dtype=np.uint8), np.zeros(1, dtype=np.int64))
+        self.idf_ = None
+        self._fitted = False
+
+    @property
+    def n_columns(self) -> int:
+        """The number of columns of the result."""
+        if self.n_features is not None:
+            return self.n_features
+        return self._vocab[1].size - 1
+
+    def get_feature_names_out(self) -> NDArray:
+        """The n-gram of each column, only available with a learned vocabulary."""
+        if self.n_features is not None:
+            msg = "hashed n-grams have no feature names"
+            raise ValueError(msg)
+        data, offsets = self._vocab
+        raw = data.tobytes()
+        return np.array([raw[offsets[k] : offsets[k + 1]].decode("utf-8") for k in range(offsets.size - 1)], dtype=object)
+
+    def _core_func(self, nnz_bound: int):
+        idx_dtype = np.dtype(np.int32) if self.idx_dtype is None else self.idx_dtype
+        ptr_dtype = np.dtype(np.int64) if nnz_bound > np.iinfo(idx_dtype).max else idx_dtype
+        return getattr(_core, f"ngram_tfidf_{self.dtype.name}_{idx_dtype.name}_{ptr_dtype.name}")
+
+    def _transform(self, data: NDArray, offsets: NDArray, idf: NDArray | None, normalize: bool) -> csr_matrix:
+        # a document of `m` bytes has at most `m` n-grams
+        func = self._core_func(int(offsets[-1]))
+        C = func(
+            n=self.n,
+            n_features=self.n_features or 0,
+            sublinear_tf=self.sublinear_tf,
+            idf=idf,
+            normalize=normalize,
+            n_threads=self._n_threads,
+            docs_data=data,
+            docs_offsets=offsets,
+            vocab_data=self._vocab[0],
+            vocab_offsets=self._vocab[1],
+        )
+        return _to_csr_result(C, shape=(offsets.size - 1, self.n_columns), canonical=True)
+
+    def fit(self, docs: Iterable[str]) -> NgramTfidfVectorizer:
+        """Learn the vocabulary and the inverse document frequencies.
+
+        Args:
+            docs: the documents
+
+        Returns:
+            self
+
+        """
+        data, offsets = _encode(docs, self.lowercase)
+        if self.n_features is None:
+            self._vocab = _core.ngram_vocabulary(n=self.n, n_threads=self._n_threads, docs_data=data, docs_offsets=offsets)
+        self.idf_ = None
+        if self.use_idf:
+            # the columns of each row are unique, the number of entries per column is the document frequency
+            counts = self._transform(data, offsets, None, False)
+            df = np.bincount(counts.indices, minlength=self.n_columns).astype(np.float64)
+            n_docs = offsets.size - 1 + int(self.smooth_idf)
+            self.idf_ = (np.log(n_docs / (df + int(self.smooth_idf))) + 1.0).astype(self.dtype)
+        self._fitted = True
+        return self
+
+    def transform(self, docs: Iterable[str]) -> csr_matrix:
+        """Compute the TF-IDF weighted n-grams.
+
+        Args:
+            docs: the documents
+
+        Raises:
+            ValueError: when the vectorizer has not been fitted, a hashing vectorizer without `use_idf` needs no fit
+
+        Returns:
+            C: the TF-IDF matrix with a row per document
+
+        """
+        if not self._fitted and (self.n_features is None or self.use_idf):
+            msg = "the vectorizer has not been fitted"
+            raise ValueError(msg)
+        data, offsets = _encode(docs, self.lowercase)
+        return self._transform(data, offsets, self.idf_, self.norm == "l2")
+
+    def fit_transform(self, docs: Iterable[str]) -> csr_matrix:
+        """Learn the vocabulary and inverse document frequencies and compute the TF-IDF weighted n-grams.
+
+        Args:
+            docs: the documents
+
+        Returns:
+            C: the TF-IDF matrix with a row per document
+
+        """
+        docs = list(docs)
+        return self.fit(docs).transform(docs)
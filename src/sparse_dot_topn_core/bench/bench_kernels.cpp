@@ -0,0 +1,680 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * Microbenchmarks of the core kernels on generated matrices, without the
+ * overhead of the Python API.
+ *
+ * The product A * B is computed for every combination of the value types,
+ * index types, `top_n` and number of threads that is requested, see `--help`.
+ * For each run the median and minimum time is reported together with the
+ * throughput in floating point operations, two per multiply-add, and the
+ * bytes read and written by the product. The bytes count the arrays of A,
+ * the rows of B that are visited for each element of A and the arrays of C.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(SDTN_OMP_ENABLED)
+#include <omp.h>
+#endif  // SDTN_OMP_ENABLED
+
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+#include <sparse_dot_topn/zip_sp_matmul_topn.hpp>
+
+#include "generators.hpp"
+
+namespace sdtn::bench {
+
+struct Options {
+    CsrSpec A{10000, 50000, 0.001, 0.0, 0.0, 42};
+    CsrSpec B{50000, 10000, 0.001, 0.0, 0.0, 43};
+    std::vector<std::string> kernels{
+        "sp_matmul", "sp_matmul_topn", "sp_matmul_topn_mt", "zip_sp_matmul_topn"
+    };
+    std::vector<std::string> dtypes{"float32", "float64"};
+    std::vector<std::string> index_types{"int32", "int64"};
+    std::vector<int64_t> top_ns{10, 100};
+    std::vector<int> threads{1};
+    int repeats = 5;
+    int zip_splits = 4;
+    bool csv = false;
+};
+
+struct Result {
+    std::string kernel;
+    std::string dtype;
+    std::string index_type;
+    int64_t top_n;
+    int n_threads;
+    size_t nnz;
+    double median_ms;
+    double min_ms;
+    double flops;
+    double bytes;
+};
+
+/**
+ * \brief Run `func` once to warm up and `repeats` times timed.
+ *
+ * \returns the median and minimum time in milliseconds
+ */
+template <typename Func>
+inline std::pair<double, double> time_runs(const int repeats, Func&& func) {
+    func();
+    std::vector<double> times;
+    times.reserve(repeats);
+    for (int r = 0; r < repeats; ++r) {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto stop = std::chrono::steady_clock::now();
+        times.push_back(
+            std::chrono::duration<double, std::milli>(stop - start).count()
+        );
+    }
+    std::sort(times.begin(), times.end());
+    return {times[times.size() / 2], times.front()};
+}
+
+/**
+ * \brief The multiply-adds and the bytes read by A * B, C excluded.
+ */
+template <typename eT, typename idxT, typename ptrT>
+inline std::pair<double, double> product_cost(
+    const CsrMatrix<eT, idxT, ptrT>& A,
+    const CsrMatrix<eT, idxT, ptrT>& B
+) {
+    double madds = 0.0;
+    for (const idxT j : A.indices) {
+        madds += static_cast<double>(B.row_nnz(j));
+    }
+    const double bytes = static_cast<double>(A.nbytes())
+        + madds * static_cast<double>(sizeof(eT) + sizeof(idxT))
+        + static_cast<double>(A.nnz() * 2 * sizeof(ptrT));
+    return {madds, bytes};
+}
+
+template <typename eT, typename idxT, typename ptrT>
+inline double output_bytes(const size_t nnz, const idxT nrows) {
+    return static_cast<double>(
+        nnz * (sizeof(eT) + sizeof(idxT)) + (nrows + 1) * sizeof(ptrT)
+    );
+}
+
+inline bool has(const std::vector<std::string>& names, const char* name) {
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+template <typename eT, typename idxT, typename ptrT>
+inline Result bench_sp_matmul(
+    const Options& opts,
+    const CsrMatrix<eT, idxT, ptrT>& A,
+    const CsrMatrix<eT, idxT, ptrT>& B,
+    const int n_threads
+) {
+    const idxT nrows = A.nrows;
+    const idxT ncols = B.ncols;
+    size_t nnz = 0;
+    auto run = [&]() {
+        std::vector<ptrT> C_indptr(nrows + 1);
+        std::vector<idxT> C_indices;
+        std::vector<eT> C_data;
+#if defined(SDTN_OMP_ENABLED)
+        if (n_threads > 1) {
+            omp_set_num_threads(n_threads);
+            const ptrT size = core::sp_matmul_size_mt<idxT, ptrT>(
+                nrows,
+                ncols,
+                A.indptr.data(),
+                A.indices.data(),
+                B.indptr.data(),
+                B.indices.data(),
+                C_indptr.data()
+            );
+            C_indices.resize(size);
+            C_data.resize(size);
+            core::sp_matmul_mt<eT, idxT, ptrT>(
+                nrows,
+                ncols,
+                n_threads,
+                A.data.data(),
+                A.indptr.data(),
+                A.indices.data(),
+                B.data.data(),
+                B.indptr.data(),
+                B.indices.data(),
+                C_data.data(),
+                C_indptr.data(),
+                C_indices.data()
+            );
+            nnz = C_data.size();
+            return;
+        }
+#endif  // SDTN_OMP_ENABLED
+        const ptrT size = core::sp_matmul_size(
+            nrows,
+            ncols,
+            A.indptr.data(),
+            A.indices.data(),
+            B.indptr.data(),
+            B.indices.data(),
+            C_indptr.data()
+        );
+        C_indices.resize(size);
+        C_data.resize(size);
+        core::sp_matmul<eT, idxT, ptrT>(
+            nrows,
+            ncols,
+            A.data.data(),
+            A.indptr.data(),
+            A.indices.data(),
+            B.data.data(),
+            B.indptr.data(),
+            B.indices.data(),
+            C_data.data(),
+            C_indices.data()
+        );
+        nnz = C_data.size();
+    };
+    auto [median_ms, min_ms] = time_runs(opts.repeats, run);
+    auto [madds, bytes] = product_cost(A, B);
+    return {
+        "sp_matmul",
+        "",
+        "",
+        0,
+        n_threads,
+        nnz,
+        median_ms,
+        min_ms,
+        2.0 * madds,
+        bytes + output_bytes<eT, idxT, ptrT>(nnz, nrows)
+    };
+}
+
+template <typename eT, typename idxT, typename ptrT>
+inline Result bench_sp_matmul_topn(
+    const Options& opts,
+    const CsrMatrix<eT, idxT, ptrT>& A,
+    const CsrMatrix<eT, idxT, ptrT>& B,
+    const idxT top_n
+) {
+    const idxT nrows = A.nrows;
+    const idxT ncols = B.ncols;
+    const eT threshold = std::numeric_limits<eT>::min();
+    size_t nnz = 0;
+    auto run = [&]() {
+        const size_t result_size = core::sp_matmul_topn_size(
+            top_n, nrows, A.indptr.data(), A.indices.data(), B.indptr.data()
+        );
+        std::vector<eT> C_data;
+        C_data.reserve(result_size);
+        std::vector<idxT> C_indices;
+        C_indices.reserve(result_size);
+        std::vector<ptrT> C_indptr(nrows + 1);
+        core::sp_matmul_topn<eT, idxT, ptrT, core::SortOrder::insertion>(
+            top_n,
+            nrows,
+            ncols,
+            threshold,
+            A.data.data(),
+            A.indptr.data(),
+            A.indices.data(),
+            B.data.data(),
+            B.indptr.data(),
+            B.indices.data(),
+            C_data,
+            C_indptr,
+            C_indices
+        );
+        nnz = C_data.size();
+    };
+    auto [median_ms, min_ms] = time_runs(opts.repeats, run);
+    auto [madds, bytes] = product_cost(A, B);
+    return {
+        "sp_matmul_topn",
+        "",
+        "",
+        top_n,
+        1,
+        nnz,
+        median_ms,
+        min_ms,
+        2.0 * madds,
+        bytes + output_bytes<eT, idxT, ptrT>(nnz, nrows)
+    };
+}
+
+#if defined(SDTN_OMP_ENABLED)
+template <typename eT, typename idxT, typename ptrT>
+inline Result bench_sp_matmul_topn_mt(
+    const Options& opts,
+    const CsrMatrix<eT, idxT, ptrT>& A,
+    const CsrMatrix<eT, idxT, ptrT>& B,
+    const idxT top_n,
+    const int n_threads
+) {
+    const idxT nrows = A.nrows;
+    const idxT ncols = B.ncols;
+    const eT threshold = std::numeric_limits<eT>::min();
+    size_t nnz = 0;
+    auto run = [&]() {
+        auto [total_nonzero, C_data, C_indices, C_indptr]
+            = core::sp_matmul_topn_mt<
+                eT,
+                idxT,
+                ptrT,
+                core::SortOrder::insertion>(
+                top_n,
+                nrows,
+                ncols,
+                threshold,
+                n_threads,
+                A.data.data(),
+                A.indptr.data(),
+                A.indices.data(),
+                B.data.data(),
+                B.indptr.data(),
+                B.indices.data()
+            );
+        nnz = total_nonzero;
+        delete[] C_data;
+        delete[] C_indices;
+        delete[] C_indptr;
+    };
+    auto [median_ms, min_ms] = time_runs(opts.repeats, run);
+    auto [madds, bytes] = product_cost(A, B);
+    return {
+        "sp_matmul_topn_mt",
+        "",
+        "",
+        top_n,
+        n_threads,
+        nnz,
+        median_ms,
+        min_ms,
+        2.0 * madds,
+        bytes + output_bytes<eT, idxT, ptrT>(nnz, nrows)
+    };
+}
+#endif  // SDTN_OMP_ENABLED
+
+/**
+ * \brief Zip the top n of A * B_j where B_j are column blocks of B.
+ *
+ * \details The sub-products are computed before the timing, only the zip is
+ * timed. The flops are reported as zero as the zip only compares values.
+ */
+template <typename eT, typename idxT, typename ptrT>
+inline Result bench_zip_sp_matmul_topn(
+    const Options& opts,
+    const CsrMatrix<eT, idxT, ptrT>& A,
+    const CsrMatrix<eT, idxT, ptrT>& B,
+    const idxT top_n
+) {
+    const idxT nrows = A.nrows;
+    const eT threshold = std::numeric_limits<eT>::min();
+    std::vector<CsrMatrix<eT, idxT, ptrT>> Cs;
+    std::vector<idxT> B_ncols;
+    double bytes = 0.0;
+    for (const auto& B_j : split_columns(B, opts.zip_splits)) {
+        CsrMatrix<eT, idxT, ptrT> C_j;
+        C_j.nrows = nrows;
+        C_j.ncols = B_j.ncols;
+        C_j.indptr.resize(nrows + 1);
+        core::sp_matmul_topn<eT, idxT, ptrT, core::SortOrder::value>(
+            top_n,
+            nrows,
+            B_j.ncols,
+            threshold,
+            A.data.data(),
+            A.indptr.data(),
+            A.indices.data(),
+            B_j.data.data(),
+            B_j.indptr.data(),
+            B_j.indices.data(),
+            C_j.data,
+            C_j.indptr,
+            C_j.indices
+        );
+        bytes += static_cast<double>(C_j.nbytes());
+        B_ncols.push_back(B_j.ncols);
+        Cs.push_back(std::move(C_j));
+    }
+    std::vector<const eT*> C_data;
+    std::vector<const ptrT*> C_indptrs;
+    std::vector<const idxT*> C_indices;
+    for (const auto& C_j : Cs) {
+        C_data.push_back(C_j.data.data());
+        C_indptrs.push_back(C_j.indptr.data());
+        C_indices.push_back(C_j.indices.data());
+    }
+
+    size_t nnz = 0;
+    auto run = [&]() {
+        std::vector<eT> Z_data;
+        std::vector<idxT> Z_indices;
+        std::vector<ptrT> Z_indptr(nrows + 1);
+        core::zip_sp_matmul_topn<eT, idxT, ptrT>(
+            top_n,
+            nrows,
+            B_ncols.data(),
+            C_data,
+            C_indptrs,
+            C_indices,
+            Z_data,
+            Z_indptr.data(),
+            Z_indices
+        );
+        nnz = Z_data.size();
+    };
+    auto [median_ms, min_ms] = time_runs(opts.repeats, run);
+    return {
+        "zip_sp_matmul_topn",
+        "",
+        "",
+        top_n,
+        1,
+        nnz,
+        median_ms,
+        min_ms,
+        0.0,
+        bytes + output_bytes<eT, idxT, ptrT>(nnz, nrows)
+    };
+}
+
+class Reporter {
+    bool csv;
+
+   public:
+    explicit Reporter(const bool csv) : csv(csv) {
+        if (csv) {
+            std::printf(
+                "kernel,dtype,index,top_n,threads,nnz_C,median_ms,min_ms,"
+                "gflops,mbytes,gbytes_per_s\n"
+            );
+        } else {
+            std::printf(
+                "%-20s %-8s %-12s %6s %7s %12s %11s %11s %8s %10s %8s\n",
+                "kernel",
+                "dtype",
+                "index",
+                "top_n",
+                "threads",
+                "nnz_C",
+                "median_ms",
+                "min_ms",
+                "GFLOP/s",
+                "MB",
+                "GB/s"
+            );
+        }
+    }
+
+    void report(const Result& res) const {
+        const double seconds = res.median_ms * 1e-3;
+        const double gflops = res.flops / seconds * 1e-9;
+        const double mbytes = res.bytes * 1e-6;
+        const double gbps = res.bytes / seconds * 1e-9;
+        const std::string top_n
+            = res.top_n > 0 ? std::to_string(res.top_n) : std::string("-");
+        const char* fmt = csv
+            ? "%s,%s,%s,%s,%d,%zu,%.4f,%.4f,%.4f,%.3f,%.4f\n"
+            : "%-20s %-8s %-12s %6s %7d %12zu %11.3f %11.3f %8.3f %10.2f "
+              "%8.3f\n";
+        std::printf(
+            fmt,
+            res.kernel.c_str(),
+            res.dtype.c_str(),
+            res.index_type.c_str(),
+            top_n.c_str(),
+            res.n_threads,
+            res.nnz,
+            res.median_ms,
+            res.min_ms,
+            gflops,
+            mbytes,
+            gbps
+        );
+        std::fflush(stdout);
+    }
+};
+
+template <typename eT, typename idxT, typename ptrT>
+inline void run_types(
+    const Options& opts,
+    const std::string& dtype,
+    const std::string& index_type,
+    const Reporter& reporter
+) {
+    const auto A = random_csr<eT, idxT, ptrT>(opts.A);
+    const auto B = random_csr<eT, idxT, ptrT>(opts.B);
+    auto emit = [&](Result res) {
+        res.dtype = dtype;
+        res.index_type = index_type;
+        reporter.report(res);
+    };
+
+    if (has(opts.kernels, "sp_matmul")) {
+        for (const int n_threads : opts.threads) {
+#if !defined(SDTN_OMP_ENABLED)
+            if (n_threads > 1) {
+                continue;
+            }
+#endif  // SDTN_OMP_ENABLED
+            emit(bench_sp_matmul(opts, A, B, n_threads));
+        }
+    }
+    for (const int64_t top_n : opts.top_ns) {
+        const idxT n = static_cast<idxT>(std::min<int64_t>(top_n, B.ncols));
+        if (has(opts.kernels, "sp_matmul_topn")) {
+            emit(bench_sp_matmul_topn(opts, A, B, n));
+        }
+#if defined(SDTN_OMP_ENABLED)
+        if (has(opts.kernels, "sp_matmul_topn_mt")) {
+            for (const int n_threads : opts.threads) {
+                emit(bench_sp_matmul_topn_mt(opts, A, B, n, n_threads));
+            }
+        }
+#endif  // SDTN_OMP_ENABLED
+        if (has(opts.kernels, "zip_sp_matmul_topn")) {
+            emit(bench_zip_sp_matmul_topn(opts, A, B, n));
+        }
+    }
+}
+
+template <typename eT>
+inline void run_index_types(
+    const Options& opts,
+    const std::string& dtype,
+    const Reporter& reporter
+) {
+    for (const auto& index_type : opts.index_types) {
+        if (index_type == "int32") {
+            run_types<eT, int32_t, int32_t>(opts, dtype, index_type, reporter);
+        } else if (index_type == "int64") {
+            run_types<eT, int64_t, int64_t>(opts, dtype, index_type, reporter);
+        } else if (index_type == "int32_int64") {
+            run_types<eT, int32_t, int64_t>(opts, dtype, index_type, reporter);
+        } else {
+            throw std::invalid_argument("unknown index type: " + index_type);
+        }
+    }
+}
+
+inline void run(const Options& opts) {
+    const Reporter reporter(opts.csv);
+    for (const auto& dtype : opts.dtypes) {
+        if (dtype == "float32") {
+            run_index_types<float>(opts, dtype, reporter);
+        } else if (dtype == "float64") {
+            run_index_types<double>(opts, dtype, reporter);
+        } else if (dtype == "int32") {
+            run_index_types<int32_t>(opts, dtype, reporter);
+        } else if (dtype == "int64") {
+            run_index_types<int64_t>(opts, dtype, reporter);
+        } else {
+            throw std::invalid_argument("unknown dtype: " + dtype);
+        }
+    }
+}
+
+inline std::vector<std::string> split_list(const std::string& arg) {
+    std::vector<std::string> items;
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+template <typename T>
+inline std::vector<T> parse_list(const std::string& arg) {
+    std::vector<T> values;
+    for (const auto& item : split_list(arg)) {
+        values.push_back(static_cast<T>(std::stoll(item)));
+    }
+    return values;
+}
+
+constexpr const char* usage = R"(usage: sdtn_bench_kernels [options]
+
+Computes A * B with A of shape (nrows, inner) and B of shape (inner, ncols).
+
+matrices:
+  --nrows N          rows of A (10000)
+  --inner N          columns of A and rows of B (50000)
+  --ncols N          columns of B (10000)
+  --density D        density of A and B (0.001)
+  --density-a D      density of A
+  --density-b D      density of B
+  --row-skew S       power-law exponent of the row lengths (0)
+  --col-skew S       power-law exponent of the column frequencies (0)
+  --seed N           seed of the generator (42)
+
+sweep, comma separated lists:
+  --kernels K        sp_matmul,sp_matmul_topn,sp_matmul_topn_mt,
+                     zip_sp_matmul_topn (all)
+  --dtypes T         float32,float64,int32,int64 (float32,float64)
+  --index I          int32,int64,int32_int64 (int32,int64)
+  --top-n N          (10,100)
+  --threads N        (1 and the number of available threads)
+
+  --repeats N        timed runs per measurement, the median is reported (5)
+  --zip-splits N     column blocks of B zipped by zip_sp_matmul_topn (4)
+  --csv              print the results as CSV
+)";
+
+inline Options parse_args(int argc, char** argv) {
+    Options opts;
+#if defined(SDTN_OMP_ENABLED)
+    if (omp_get_max_threads() > 1) {
+        opts.threads.push_back(omp_get_max_threads());
+    }
+#endif  // SDTN_OMP_ENABLED
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "--help" || key == "-h") {
+            std::fputs(usage, stdout);
+            std::exit(0);
+        } else if (key == "--csv") {
+            opts.csv = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + key);
+        }
+        const std::string value = argv[++i];
+        if (key == "--nrows") {
+            opts.A.nrows = std::stoll(value);
+        } else if (key == "--inner") {
+            opts.A.ncols = opts.B.nrows = std::stoll(value);
+        } else if (key == "--ncols") {
+            opts.B.ncols = std::stoll(value);
+        } else if (key == "--density") {
+            opts.A.density = opts.B.density = std::stod(value);
+        } else if (key == "--density-a") {
+            opts.A.density = std::stod(value);
+        } else if (key == "--density-b") {
+            opts.B.density = std::stod(value);
+        } else if (key == "--row-skew") {
+            opts.A.row_skew = opts.B.row_skew = std::stod(value);
+        } else if (key == "--col-skew") {
+            opts.A.col_skew = opts.B.col_skew = std::stod(value);
+        } else if (key == "--seed") {
+            opts.A.seed = std::stoull(value);
+            opts.B.seed = opts.A.seed + 1;
+        } else if (key == "--kernels") {
+            opts.kernels = split_list(value);
+        } else if (key == "--dtypes") {
+            opts.dtypes = split_list(value);
+        } else if (key == "--index") {
+            opts.index_types = split_list(value);
+        } else if (key == "--top-n") {
+            opts.top_ns = parse_list<int64_t>(value);
+        } else if (key == "--threads") {
+            opts.threads = parse_list<int>(value);
+        } else if (key == "--repeats") {
+            opts.repeats = std::max(1, std::stoi(value));
+        } else if (key == "--zip-splits") {
+            opts.zip_splits = std::max(1, std::stoi(value));
+        } else {
+            throw std::invalid_argument("unknown option: " + key);
+        }
+    }
+    return opts;
+}
+
+}  // namespace sdtn::bench
+
+int main(int argc, char** argv) {
+    try {
+        const auto opts = sdtn::bench::parse_args(argc, argv);
+        std::fprintf(
+            stderr,
+            "A: %lld x %lld, B: %lld x %lld, density: %g / %g, "
+            "skew (row, col): %g, %g\n",
+            static_cast<long long>(opts.A.nrows),
+            static_cast<long long>(opts.A.ncols),
+            static_cast<long long>(opts.B.nrows),
+            static_cast<long long>(opts.B.ncols),
+            opts.A.density,
+            opts.B.density,
+            opts.A.row_skew,
+            opts.A.col_skew
+        );
+        sdtn::bench::run(opts);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "sdtn_bench_kernels: %s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,235 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+
+namespace sdtn::bench {
+
+/**
+ * \brief Matrix in CSR format that owns its arrays.
+ *
+ * \tparam eT   element type of the matrix
+ * \tparam idxT integer type of the index arrays
+ * \tparam ptrT integer type of the index pointer array
+ */
+template <typename eT, typename idxT, typename ptrT>
+struct CsrMatrix {
+    idxT nrows = 0;
+    idxT ncols = 0;
+    std::vector<eT> data;
+    std::vector<ptrT> indptr;
+    std::vector<idxT> indices;
+
+    size_t nnz() const { return data.size(); }
+
+    ptrT row_nnz(const idxT i) const { return indptr[i + 1] - indptr[i]; }
+
+    size_t nbytes() const {
+        return data.size() * sizeof(eT) + indptr.size() * sizeof(ptrT)
+            + indices.size() * sizeof(idxT);
+    }
+};
+
+/**
+ * \brief Parameters of a generated matrix.
+ *
+ * \details The rows and columns are drawn with a probability proportional to
+ * `(rank + 1)^-skew`, a skew of zero gives a uniform matrix, a skew around
+ * one the long tail typical of term frequencies. The ranks are shuffled such
+ * that the heavy rows and columns are not clustered.
+ */
+struct CsrSpec {
+    int64_t nrows = 1000;
+    int64_t ncols = 1000;
+    double density = 0.01;
+    double row_skew = 0.0;
+    double col_skew = 0.0;
+    uint64_t seed = 42;
+};
+
+/**
+ * \brief Power-law weights `(rank + 1)^-skew` in shuffled order.
+ */
+inline std::vector<double> power_law_weights(
+    const int64_t n,
+    const double skew,
+    std::mt19937_64& rng
+) {
+    std::vector<double> weights(n);
+    for (int64_t i = 0; i < n; ++i) {
+        weights[i] = std::pow(static_cast<double>(i + 1), -skew);
+    }
+    std::shuffle(weights.begin(), weights.end(), rng);
+    return weights;
+}
+
+/**
+ * \brief Generate a random matrix in canonical CSR format.
+ *
+ * \details The expected number of nonzero elements is
+ * `density * nrows * ncols`, distributed over the rows with `row_skew`.
+ * The columns of a row are drawn without replacement with `col_skew`, when a
+ * heavily skewed row can not be filled after a bounded number of draws it is
+ * kept shorter. The values are drawn uniformly from (0, 1] for floating point
+ * types and from [1, 4] for integer types such that the products do not
+ * overflow.
+ *
+ * \tparam eT   element type of the matrix
+ * \tparam idxT integer type of the index arrays
+ * \tparam ptrT integer type of the index pointer array
+ * \param[in] spec the shape, density, skew and seed of the matrix
+ * \returns the generated matrix, a given `spec` always gives the same
+ * structure irrespective of the types
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline CsrMatrix<eT, idxT, ptrT> random_csr(const CsrSpec& spec) {
+    std::mt19937_64 rng(spec.seed);
+    const int64_t nrows = spec.nrows;
+    const int64_t ncols = spec.ncols;
+
+    // expected number of elements per row
+    std::vector<double> row_weights
+        = power_law_weights(nrows, spec.row_skew, rng);
+    const double row_total
+        = std::accumulate(row_weights.begin(), row_weights.end(), 0.0);
+    const double expected_nnz = spec.density * static_cast<double>(nrows)
+        * static_cast<double>(ncols);
+
+    std::discrete_distribution<int64_t> col_dist;
+    if (spec.col_skew != 0.0) {
+        std::vector<double> col_weights
+            = power_law_weights(ncols, spec.col_skew, rng);
+        col_dist = std::discrete_distribution<int64_t>(
+            col_weights.begin(), col_weights.end()
+        );
+    }
+    std::uniform_int_distribution<int64_t> uniform_col(0, ncols - 1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    CsrMatrix<eT, idxT, ptrT> M;
+    M.nrows = static_cast<idxT>(nrows);
+    M.ncols = static_cast<idxT>(ncols);
+    M.indptr.reserve(nrows + 1);
+    M.indptr.push_back(0);
+    M.indices.reserve(static_cast<size_t>(expected_nnz * 1.05));
+
+    std::vector<int64_t> mask(ncols, -1);
+    std::vector<idxT> row;
+    for (int64_t i = 0; i < nrows; ++i) {
+        // stochastic rounding keeps the expected number of elements exact
+        const double target = expected_nnz * row_weights[i] / row_total;
+        int64_t len = static_cast<int64_t>(target);
+        len += unit(rng) < (target - static_cast<double>(len)) ? 1 : 0;
+        len = std::min(len, ncols);
+
+        row.clear();
+        if (spec.col_skew == 0.0 && 2 * len > ncols) {
+            // dense rows are selected in a single sweep over the columns
+            int64_t needed = len;
+            for (int64_t k = 0; k < ncols && needed > 0; ++k) {
+                const double p = static_cast<double>(needed)
+                    / static_cast<double>(ncols - k);
+                if (unit(rng) < p) {
+                    row.push_back(static_cast<idxT>(k));
+                    --needed;
+                }
+            }
+        } else {
+            const int64_t max_draws = 8 * len + 64;
+            for (int64_t d = 0;
+                 d < max_draws && static_cast<int64_t>(row.size()) < len;
+                 ++d) {
+                const int64_t k = spec.col_skew == 0.0 ? uniform_col(rng)
+                                                       : col_dist(rng);
+                if (mask[k] != i) {
+                    mask[k] = i;
+                    row.push_back(static_cast<idxT>(k));
+                }
+            }
+            std::sort(row.begin(), row.end());
+        }
+
+        for (const idxT k : row) {
+            M.indices.push_back(k);
+            if constexpr (std::is_integral_v<eT>) {
+                M.data.push_back(static_cast<eT>(1 + (rng() & 3)));
+            } else {
+                M.data.push_back(static_cast<eT>(1.0 - unit(rng)));
+            }
+        }
+        M.indptr.push_back(static_cast<ptrT>(M.indices.size()));
+    }
+    return M;
+}
+
+/**
+ * \brief Split the columns of `M` into `n_splits` contiguous blocks.
+ *
+ * \details Used to create the sub-matrices B_j of `zip_sp_matmul_topn`, the
+ * column indices of each block start at zero.
+ */
+template <typename eT, typename idxT, typename ptrT>
+inline std::vector<CsrMatrix<eT, idxT, ptrT>> split_columns(
+    const CsrMatrix<eT, idxT, ptrT>& M,
+    const int n_splits
+) {
+    std::vector<CsrMatrix<eT, idxT, ptrT>> blocks(n_splits);
+    std::vector<idxT> bounds(n_splits + 1);
+    for (int s = 0; s <= n_splits; ++s) {
+        bounds[s] = static_cast<idxT>(
+            static_cast<int64_t>(M.ncols) * s / n_splits
+        );
+    }
+    for (int s = 0; s < n_splits; ++s) {
+        auto& blk = blocks[s];
+        blk.nrows = M.nrows;
+        blk.ncols = bounds[s + 1] - bounds[s];
+        blk.indptr.assign(1, 0);
+        blk.indptr.reserve(M.nrows + 1);
+    }
+    for (idxT i = 0; i < M.nrows; ++i) {
+        int s = 0;
+        for (ptrT kk = M.indptr[i]; kk < M.indptr[i + 1]; ++kk) {
+            const idxT k = M.indices[kk];
+            while (k >= bounds[s + 1]) {
+                ++s;
+            }
+            blocks[s].indices.push_back(k - bounds[s]);
+            blocks[s].data.push_back(M.data[kk]);
+        }
+        for (auto& blk : blocks) {
+            blk.indptr.push_back(static_cast<ptrT>(blk.indices.size()));
+        }
+    }
+    return blocks;
+}
+
+}  // namespace sdtn::bench
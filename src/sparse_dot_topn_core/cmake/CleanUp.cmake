@@ -4,3 +4,4 @@ unset(SDTN_ENABLE_OPENMP CACHE)
 unset(SDTN_ENABLE_DEVMODE CACHE)
 unset(SDTN_EIGEN_DEFAULT_VERSION CACHE)
 unset(SDTN_ENABLE_ARCH_FLAGS CACHE)
+unset(SDTN_BUILD_BENCHMARKS CACHE)
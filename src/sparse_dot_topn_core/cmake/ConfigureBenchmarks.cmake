@@ -0,0 +1,20 @@
+# -- C++ kernel benchmarks, see src/sparse_dot_topn_core/bench
+# The benchmarks only depend on the core headers, not on Python or nanobind.
+set(SDTN_BENCH_PREF "${PROJECT_SOURCE_DIR}/src/sparse_dot_topn_core/bench")
+
+add_executable(sdtn_bench_kernels ${SDTN_BENCH_PREF}/bench_kernels.cpp)
+target_include_directories(sdtn_bench_kernels PRIVATE ${SDTN_INCLUDE_DIR} ${SDTN_BENCH_PREF})
+if(OpenMP_CXX_FOUND)
+    target_link_libraries(sdtn_bench_kernels PRIVATE OpenMP::OpenMP_CXX)
+    target_compile_definitions(sdtn_bench_kernels PRIVATE SDTN_OMP_ENABLED=TRUE)
+endif()
+
+if(SDTN_ENABLE_DEVMODE)
+    target_compile_options(sdtn_bench_kernels PRIVATE ${SDTN_DEVMODE_OPTIONS})
+endif()
+if(SDTN_ARCHITECTURE_FLAGS)
+    target_compile_options(sdtn_bench_kernels PRIVATE $<$<CONFIG:RELEASE>:${SDTN_ARCHITECTURE_FLAGS}>)
+endif()
+
+set_property(TARGET sdtn_bench_kernels PROPERTY CXX_STANDARD ${SDTN_CPP_STANDARD})
+set_property(TARGET sdtn_bench_kernels PROPERTY CXX_STANDARD_REQUIRED ON)
@@ -1,4 +1,9 @@
 target_include_directories(_sparse_dot_topn_core PUBLIC ${SDTN_INCLUDE_DIR})
+if(TARGET Eigen3::Eigen)
+    target_link_libraries(_sparse_dot_topn_core PRIVATE Eigen3::Eigen)
+else()
+    target_include_directories(_sparse_dot_topn_core SYSTEM PRIVATE ${EIGEN3_ROOT_DIR})
+endif()
 if(OpenMP_CXX_FOUND)
     target_link_libraries(_sparse_dot_topn_core PUBLIC OpenMP::OpenMP_CXX)
     target_compile_definitions(_sparse_dot_topn_core PRIVATE SDTN_OMP_ENABLED=TRUE)
@@ -7,6 +7,12 @@ find_package(
 # -- Nanobind
 find_package(nanobind CONFIG REQUIRED)
 
+# -- Eigen, header only, collected when not installed
+find_package(Eigen3 3.3 QUIET NO_MODULE)
+if (NOT TARGET Eigen3::Eigen)
+  include(GetEigen)
+endif()
+
 
 # -- OpenMP
 if(NOT SDTN_DISABLE_OPENMP)
@@ -15,12 +15,8 @@
  * limitations under the License.
  */
 #pragma once
-#include <nanobind/nanobind.h>
-#include <nanobind/ndarray.h>
-#include <nanobind/stl/optional.h>
 
-#include <utility>
-#include <vector>
+#include <type_traits>
 
 namespace sdtn {
 namespace core {
@@ -29,32 +25,4 @@ template <typename T>
 using iffInt = std::enable_if_t<std::is_integral_v<T>, bool>;
 
 }  // namespace core
-
-namespace api {
-
-namespace nb = nanobind;
-
-template <typename eT>
-using nb_vec
-    = nb::ndarray<nb::numpy, eT, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
-
-template <typename eT>
-inline nb_vec<eT> to_nbvec(std::vector<eT>&& seq) {
-    std::vector<eT>* seq_ptr = new std::vector<eT>(std::move(seq));
-    eT* data = seq_ptr->data();
-    auto capsule = nb::capsule(seq_ptr, [](void* p) noexcept {
-        delete reinterpret_cast<std::vector<eT>*>(p);
-    });
-    return nb_vec<eT>(data, {seq_ptr->size()}, capsule);
-}
-
-template <typename eT>
-inline nb_vec<eT> to_nbvec(eT* data, size_t size) {
-    auto capsule = nb::capsule(data, [](void* p) noexcept {
-        delete[] reinterpret_cast<eT*>(p);
-    });
-    return nb_vec<eT>(data, {size}, capsule);
-}
-
-}  // namespace api
 }  // namespace sdtn
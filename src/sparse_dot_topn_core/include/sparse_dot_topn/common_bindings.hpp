@@ -0,0 +1,115 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+
+namespace sdtn {
+namespace api {
+
+namespace nb = nanobind;
+
+template <typename eT>
+using nb_vec
+    = nb::ndarray<nb::numpy, eT, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+template <typename eT>
+using nb_mat
+    = nb::ndarray<nb::numpy, eT, nb::ndim<2>, nb::c_contig, nb::device::cpu>;
+
+template <typename eT>
+inline nb_vec<eT> to_nbvec(std::vector<eT>&& seq) {
+    std::vector<eT>* seq_ptr = new std::vector<eT>(std::move(seq));
+    eT* data = seq_ptr->data();
+    auto capsule = nb::capsule(seq_ptr, [](void* p) noexcept {
+        delete reinterpret_cast<std::vector<eT>*>(p);
+    });
+    return nb_vec<eT>(data, {seq_ptr->size()}, capsule);
+}
+
+template <typename eT>
+inline nb_vec<eT> to_nbvec(eT* data, size_t size) {
+    auto capsule = nb::capsule(data, [](void* p) noexcept {
+        delete[] reinterpret_cast<eT*>(p);
+    });
+    return nb_vec<eT>(data, {size}, capsule);
+}
+
+template <typename T>
+struct type_tag {
+    using type = T;
+};
+
+/**
+ * \brief Call `func` with the `type_tag` of the output type named by `dtype`.
+ *
+ * \details An empty `dtype` selects the input type `eT`, otherwise `dtype`
+ * must be the numpy name of a floating point type.
+ *
+ * \tparam eT the input type
+ * \param[in] dtype the name of the output type
+ * \param[in] func generic callable taking a `type_tag`
+ */
+template <typename eT, typename Func>
+inline decltype(auto) visit_value_dtype(const std::string& dtype, Func&& func) {
+    if (dtype.empty()) {
+        return func(type_tag<eT>{});
+    } else if (dtype == "float32") {
+        return func(type_tag<float>{});
+    } else if (dtype == "float64") {
+        return func(type_tag<double>{});
+    }
+    throw std::invalid_argument(
+        "`value_dtype` must be one of {'float32', 'float64'}, got: " + dtype
+    );
+}
+
+/**
+ * \brief Call `func` with the `type_tag` of the accumulator type named by
+ * `dtype`.
+ *
+ * \details An empty `dtype` selects the input type `eT`, otherwise `dtype`
+ * must be the numpy name of a floating point type.
+ *
+ * \tparam eT the input type
+ * \param[in] dtype the name of the accumulator type
+ * \param[in] func generic callable taking a `type_tag`
+ */
+template <typename eT, typename Func>
+inline decltype(auto) visit_acc_dtype(const std::string& dtype, Func&& func) {
+    if (dtype.empty()) {
+        return func(type_tag<eT>{});
+    } else if (dtype == "float32") {
+        return func(type_tag<float>{});
+    } else if (dtype == "float64") {
+        return func(type_tag<double>{});
+    }
+    throw std::invalid_argument(
+        "`acc_dtype` must be one of {'float32', 'float64'}, got: " + dtype
+    );
+}
+
+}  // namespace api
+}  // namespace sdtn
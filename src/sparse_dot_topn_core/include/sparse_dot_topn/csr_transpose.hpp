@@ -0,0 +1,199 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(SDTN_OMP_ENABLED)
+#include <omp.h>
+#endif  // SDTN_OMP_ENABLED
+
+#include <sparse_dot_topn/common.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief Transpose a matrix in CSR format.
+ *
+ * \details This function will return the matrix T = M.T in CSR format, which
+ * is equal to M in CSC format. The column indices of each row of T are
+ * sorted.
+ *
+ *  Copyright Scipy:
+ *  This function is a modified version of `csr_tocsc`
+ *  Source: scipy/sparse/sparsetools/csr.h
+ *  License: BSD 3 https://github.com/scipy/scipy/blob/main/LICENSE.txt
+ *  All modifications copyright INGA WB.
+ *
+ * \tparam eT   element type of the matrix
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] nrows the number of rows in M
+ * \param[in] ncols the number of columns in M
+ * \param[in] M_data the nonzero elements of M
+ * \param[in] M_indptr array containing the row indices for `M_data`
+ * \param[in] M_indices array containing the column indices
+ * \param[out] T_data the nonzero elements of T
+ * \param[out] T_indptr array containing the row indices for `T_data`, must
+ * be of size ncols + 1
+ * \param[out] T_indices array containing the column indices
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void csr_transpose(
+    const idxT nrows,
+    const idxT ncols,
+    const eT* __restrict M_data,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices,
+    eT* __restrict T_data,
+    ptrT* __restrict T_indptr,
+    idxT* __restrict T_indices
+) {
+    const ptrT offset = M_indptr[0];
+    const ptrT nnz = M_indptr[nrows] - offset;
+
+    // count the number of elements in each column
+    std::fill(T_indptr, T_indptr + ncols + 1, ptrT(0));
+    for (ptrT jj = 0; jj < nnz; ++jj) {
+        T_indptr[M_indices[offset + jj] + 1]++;
+    }
+    for (idxT j = 0; j < ncols; ++j) {
+        T_indptr[j + 1] += T_indptr[j];
+    }
+
+    // scatter the elements, `next` tracks the insert position of each column
+    std::vector<ptrT> next(T_indptr, T_indptr + ncols);
+    for (idxT i = 0; i < nrows; ++i) {
+        for (ptrT jj = M_indptr[i]; jj < M_indptr[i + 1]; ++jj) {
+            ptrT dest = next[M_indices[jj]]++;
+            T_indices[dest] = i;
+            T_data[dest] = M_data[jj];
+        }
+    }
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Transpose a matrix in CSR format using multiple threads.
+ *
+ * \details This function will return the matrix T = M.T in CSR format, which
+ * is equal to M in CSC format. The rows of M are split in a contiguous block
+ * per thread. Each thread counts the elements per column in its block, the
+ * counts determine where each block writes its elements in every row of T.
+ * The result is identical to `csr_transpose`, i.e. the column indices of each
+ * row of T are sorted, at the cost of a count array of size `ncols` per
+ * thread.
+ *
+ * \tparam eT   element type of the matrix
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] nrows the number of rows in M
+ * \param[in] ncols the number of columns in M
+ * \param[in] n_threads number of threads to use
+ * \param[in] M_data the nonzero elements of M
+ * \param[in] M_indptr array containing the row indices for `M_data`
+ * \param[in] M_indices array containing the column indices
+ * \param[out] T_data the nonzero elements of T
+ * \param[out] T_indptr array containing the row indices for `T_data`, must
+ * be of size ncols + 1
+ * \param[out] T_indices array containing the column indices
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void csr_transpose_mt(
+    const idxT nrows,
+    const idxT ncols,
+    const int n_threads,
+    const eT* __restrict M_data,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices,
+    eT* __restrict T_data,
+    ptrT* __restrict T_indptr,
+    idxT* __restrict T_indices
+) {
+    // counts[t * ncols + j]: the number of elements in column j of block t,
+    // turned into the position where block t writes its first element of j
+    auto counts = std::unique_ptr<ptrT[]>(
+        new ptrT[static_cast<size_t>(n_threads) * ncols]
+    );
+
+#pragma omp parallel num_threads(n_threads) \
+    shared(nrows, ncols, M_data, M_indptr, M_indices, T_data, T_indptr, T_indices, counts)
+    {
+        const int t = omp_get_thread_num();
+        const int n_blocks = omp_get_num_threads();
+        const idxT start = static_cast<idxT>(
+            (static_cast<int64_t>(nrows) * t) / n_blocks
+        );
+        const idxT stop = static_cast<idxT>(
+            (static_cast<int64_t>(nrows) * (t + 1)) / n_blocks
+        );
+        ptrT* local_counts = counts.get() + static_cast<size_t>(t) * ncols;
+        std::fill(local_counts, local_counts + ncols, ptrT(0));
+        for (ptrT jj = M_indptr[start]; jj < M_indptr[stop]; ++jj) {
+            local_counts[M_indices[jj]]++;
+        }
+#pragma omp barrier
+
+        // exclusive scan over the blocks of each column
+#pragma omp for
+        for (idxT j = 0; j < ncols; ++j) {
+            ptrT total = 0;
+            for (int b = 0; b < n_blocks; ++b) {
+                ptrT* count = counts.get() + static_cast<size_t>(b) * ncols + j;
+                ptrT n = *count;
+                *count = total;
+                total += n;
+            }
+            T_indptr[j + 1] = total;
+        }
+
+#pragma omp single
+        {
+            T_indptr[0] = 0;
+            for (idxT j = 0; j < ncols; ++j) {
+                T_indptr[j + 1] += T_indptr[j];
+            }
+        }  // implicit barrier
+
+        for (idxT i = start; i < stop; ++i) {
+            for (ptrT jj = M_indptr[i]; jj < M_indptr[i + 1]; ++jj) {
+                idxT j = M_indices[jj];
+                ptrT dest = T_indptr[j] + local_counts[j]++;
+                T_indices[dest] = i;
+                T_data[dest] = M_data[jj];
+            }
+        }
+    }  // #pragma omp parallel
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,116 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/csr_transpose.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple csr_transpose(
+    const idxT nrows,
+    const idxT ncols,
+    const nb_vec<eT>& M_data,
+    const nb_vec<ptrT>& M_indptr,
+    const nb_vec<idxT>& M_indices
+) {
+    const ptrT* M_indptr_ptr = M_indptr.data();
+    const size_t nnz = M_indptr_ptr[nrows] - M_indptr_ptr[0];
+    ptrT* T_indptr = new ptrT[ncols + 1];
+    idxT* T_indices = new idxT[nnz];
+    eT* T_data = new eT[nnz];
+
+    core::csr_transpose<eT, idxT, ptrT>(
+        nrows,
+        ncols,
+        M_data.data(),
+        M_indptr_ptr,
+        M_indices.data(),
+        T_data,
+        T_indptr,
+        T_indices
+    );
+    return nb::make_tuple(
+        to_nbvec<eT>(T_data, nnz),
+        to_nbvec<idxT>(T_indices, nnz),
+        to_nbvec<ptrT>(T_indptr, ncols + 1)
+    );
+}
+
+#if defined(SDTN_OMP_ENABLED)
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple csr_transpose_mt(
+    const idxT nrows,
+    const idxT ncols,
+    const int n_threads,
+    const nb_vec<eT>& M_data,
+    const nb_vec<ptrT>& M_indptr,
+    const nb_vec<idxT>& M_indices
+) {
+    const ptrT* M_indptr_ptr = M_indptr.data();
+    const size_t nnz = M_indptr_ptr[nrows] - M_indptr_ptr[0];
+    ptrT* T_indptr = new ptrT[ncols + 1];
+    idxT* T_indices = new idxT[nnz];
+    eT* T_data = new eT[nnz];
+
+    core::csr_transpose_mt<eT, idxT, ptrT>(
+        nrows,
+        ncols,
+        n_threads,
+        M_data.data(),
+        M_indptr_ptr,
+        M_indices.data(),
+        T_data,
+        T_indptr,
+        T_indices
+    );
+    return nb::make_tuple(
+        to_nbvec<eT>(T_data, nnz),
+        to_nbvec<idxT>(T_indices, nnz),
+        to_nbvec<ptrT>(T_indptr, ncols + 1)
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_csr_transpose(nb::module_& m);
+#if defined(SDTN_OMP_ENABLED)
+void bind_csr_transpose_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace bindings
+}  // namespace sdtn
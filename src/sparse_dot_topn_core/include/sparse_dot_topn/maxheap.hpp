@@ -24,9 +24,19 @@
 
 namespace sdtn::core {
 
+/**
+ * \brief Order of the values retained by `MaxHeap` after sorting.
+ *
+ * \details `insertion` sorts on the order the values were pushed, `value`
+ * such that the largest value is first and `index` on increasing index, i.e.
+ * the canonical column order of a CSR row.
+ */
+enum class SortOrder { insertion, value, index };
+
 template <typename eT, typename idxT>
 struct Score {
-    int order;
+    // insertion order within a row, bounded by the number of columns
+    idxT order;
     idxT idx;
     eT val;
     bool operator>(const Score& other) const { return val > other.val; }
@@ -44,9 +54,9 @@ struct Score {
 template <typename eT, typename idxT>
 class MaxHeap {
     using compare = std::greater<Score<eT, idxT>>;
-    const int heap_size;
-    int n_set = 0;
-    static constexpr int max_order = std::numeric_limits<int>::max();
+    const idxT heap_size;
+    idxT n_set = 0;
+    static constexpr idxT max_order = std::numeric_limits<idxT>::max();
     eT init;
 
  public:
@@ -58,9 +68,9 @@ class MaxHeap {
      * \param n       maximum number of values to store
      * \param initial initial `val` to set for all the entries
      */
-    explicit MaxHeap(int n, eT initial) : heap_size{n}, init{initial} {
+    explicit MaxHeap(idxT n, eT initial) : heap_size{n}, init{initial} {
         heap.reserve(n + 1);
-        for (int i = 0; i < heap_size; i++) {
+        for (idxT i = 0; i < heap_size; i++) {
             heap.push_back({max_order, -1, initial});
         }
         std::make_heap(heap.begin(), heap.end(), compare());
@@ -69,7 +79,7 @@ class MaxHeap {
 
     eT reset() {
         n_set = 0;
-        for (int i = 0; i < heap_size; i++) {
+        for (idxT i = 0; i < heap_size; i++) {
             heap[i].order = max_order;
             heap[i].idx = -1;
             heap[i].val = init;
@@ -77,7 +87,9 @@ class MaxHeap {
         return init;
     }
 
-    [[nodiscard]] int get_n_set() const { return std::min(heap_size, n_set); }
+    [[nodiscard]] idxT get_n_set() const {
+        return std::min(heap_size, n_set);
+    }
 
     /**
      * \brief Pop minimum value and store `val`.
@@ -112,6 +124,48 @@ class MaxHeap {
      * Calls should be followed by a call to `reset`.
      */
     void value_sort() { std::sort(heap.begin(), heap.end(), compare()); }
+
+    /**
+     * \brief Sort the heap according to the index.
+     *
+     * \details The unset entries are placed after the set entries. Note that
+     * calling `index_sort` invalidates the heap. Calls should be followed by
+     * a call to `reset`.
+     */
+    void index_sort() {
+        std::sort(
+            heap.begin(),
+            heap.end(),
+            [](const Score<eT, idxT>& lhs, const Score<eT, idxT>& rhs) {
+                const bool lhs_unset = lhs.order == max_order;
+                const bool rhs_unset = rhs.order == max_order;
+                if (lhs_unset != rhs_unset) {
+                    return rhs_unset;
+                }
+                return lhs.idx < rhs.idx;
+            }
+        );
+    }
+
+    /**
+     * \brief Sort the heap according to `sort_order`.
+     *
+     * \details Note that sorting invalidates the heap. Calls should be
+     * followed by a call to `reset`.
+     */
+    template <SortOrder sort_order>
+    void sort() {
+        if constexpr (sort_order == SortOrder::insertion) {
+            // sort the heap s.t. the original matrix order is maintained
+            insertion_sort();
+        } else if constexpr (sort_order == SortOrder::value) {
+            // sort the heap s.t. the first value is the largest
+            value_sort();
+        } else {
+            // sort the heap s.t. the column indices are increasing
+            index_sort();
+        }
+    }
 };
 
 }  // namespace sdtn::core
@@ -0,0 +1,303 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#if defined(SDTN_OMP_ENABLED)
+#include <omp.h>
+#endif  // SDTN_OMP_ENABLED
+
+#include <sparse_dot_topn/common.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief 64bit FNV-1a hash of `str`.
+ */
+inline uint64_t fnv1a(const std::string_view str) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char c : str) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * \brief Call `func` with every character n-gram of the UTF-8 encoded `doc`.
+ *
+ * \details The n-grams consist of `n` code points, a document with fewer
+ * than `n` code points has no n-grams.
+ *
+ * \param[in] doc the UTF-8 encoded document
+ * \param[in] n the number of code points per n-gram
+ * \param[in] starts scratch array for the offsets of the code points
+ * \param[in] func callable taking the n-gram as `std::string_view`
+ */
+template <typename Func>
+inline void for_each_ngram(
+    const std::string_view doc,
+    const int n,
+    std::vector<size_t>& starts,
+    Func&& func
+) {
+    starts.clear();
+    for (size_t k = 0; k < doc.size(); ++k) {
+        // skip the continuation bytes
+        if ((static_cast<uint8_t>(doc[k]) & 0xC0) != 0x80) {
+            starts.push_back(k);
+        }
+    }
+    starts.push_back(doc.size());
+    const auto n_ngrams = static_cast<int64_t>(starts.size()) - n;
+    for (int64_t k = 0; k < n_ngrams; ++k) {
+        func(doc.substr(starts[k], starts[k + n] - starts[k]));
+    }
+}
+
+/**
+ * \brief Documents stored as the concatenation of their UTF-8 encoding.
+ */
+struct Documents {
+    const uint8_t* data;
+    const int64_t* offsets;
+    int64_t size;
+
+    [[nodiscard]] std::string_view operator[](const int64_t i) const {
+        return {
+            reinterpret_cast<const char*>(data) + offsets[i],
+            static_cast<size_t>(offsets[i + 1] - offsets[i])
+        };
+    }
+};
+
+/**
+ * \brief Compute the sorted unique character n-grams of `docs`.
+ *
+ * \param[in] docs the documents
+ * \param[in] n the number of code points per n-gram
+ * \param[in] n_threads number of threads to use
+ * \returns the concatenated n-grams and their offsets
+ */
+inline std::pair<std::vector<uint8_t>, std::vector<int64_t>> ngram_vocabulary(
+    const Documents& docs,
+    const int n,
+    [[maybe_unused]] const int n_threads
+) {
+    std::vector<std::unordered_set<std::string_view>> local_ngrams(n_threads);
+#if defined(SDTN_OMP_ENABLED)
+#pragma omp parallel num_threads(n_threads)
+#endif  // SDTN_OMP_ENABLED
+    {
+#if defined(SDTN_OMP_ENABLED)
+        auto& ngrams = local_ngrams[omp_get_thread_num()];
+#else
+        auto& ngrams = local_ngrams[0];
+#endif  // SDTN_OMP_ENABLED
+        std::vector<size_t> starts;
+#if defined(SDTN_OMP_ENABLED)
+#pragma omp for schedule(dynamic, 256)
+#endif  // SDTN_OMP_ENABLED
+        for (int64_t i = 0; i < docs.size; ++i) {
+            for_each_ngram(
+                docs[i], n, starts, [&](const std::string_view ngram) {
+                    ngrams.insert(ngram);
+                }
+            );
+        }
+    }
+
+    for (int t = 1; t < n_threads; ++t) {
+        local_ngrams[0].insert(local_ngrams[t].begin(), local_ngrams[t].end());
+        local_ngrams[t] = {};
+    }
+    // byte order of UTF-8 is code point order
+    std::vector<std::string_view> vocab(
+        local_ngrams[0].begin(), local_ngrams[0].end()
+    );
+    std::sort(vocab.begin(), vocab.end());
+
+    std::vector<uint8_t> V_data;
+    std::vector<int64_t> V_offsets(1, 0);
+    V_offsets.reserve(vocab.size() + 1);
+    for (const auto& ngram : vocab) {
+        V_data.insert(V_data.end(), ngram.begin(), ngram.end());
+        V_offsets.push_back(static_cast<int64_t>(V_data.size()));
+    }
+    return {std::move(V_data), std::move(V_offsets)};
+}
+
+/**
+ * \brief Compute the TF-IDF weighted character n-grams of `docs`.
+ *
+ * \details The n-grams are hashed into `n_features` columns when
+ * `n_features` is positive. Otherwise the n-grams are mapped to their column
+ * in `vocab` and the n-grams outside the vocabulary are ignored. The column
+ * indices of each row are sorted.
+ *
+ * \tparam eT   element type of the result
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] docs the documents
+ * \param[in] vocab the sorted vocabulary, ignored when hashing
+ * \param[in] n the number of code points per n-gram
+ * \param[in] n_features the number of hashed columns, zero to use `vocab`
+ * \param[in] sublinear_tf use `1 + log(tf)` as term frequency
+ * \param[in] idf the inverse document frequency of each column, may be null
+ * \param[in] normalize scale the rows to unit L2 norm
+ * \param[in] n_threads number of threads to use
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> ngram_tfidf(
+    const Documents& docs,
+    const Documents& vocab,
+    const int n,
+    const idxT n_features,
+    const bool sublinear_tf,
+    const eT* __restrict idf,
+    const bool normalize,
+    [[maybe_unused]] const int n_threads
+) {
+    const bool hashed = n_features > 0;
+    std::unordered_map<std::string_view, idxT> columns;
+    if (!hashed) {
+        columns.reserve(vocab.size);
+        for (int64_t k = 0; k < vocab.size; ++k) {
+            columns.emplace(vocab[k], static_cast<idxT>(k));
+        }
+    }
+    const auto n_buckets = static_cast<uint64_t>(n_features);
+
+    // location of the rows in the buffers of the threads
+    const int64_t nrows = docs.size;
+    auto row_thread = std::unique_ptr<int[]>(new int[nrows]);
+    auto row_start = std::unique_ptr<size_t[]>(new size_t[nrows]);
+    auto C_indptr = std::unique_ptr<ptrT[]>(new ptrT[nrows + 1]);
+    std::vector<std::vector<eT>> thread_data(n_threads);
+    std::vector<std::vector<idxT>> thread_indices(n_threads);
+
+#if defined(SDTN_OMP_ENABLED)
+#pragma omp parallel num_threads(n_threads)
+#endif  // SDTN_OMP_ENABLED
+    {
+#if defined(SDTN_OMP_ENABLED)
+        const int tid = omp_get_thread_num();
+#else
+        const int tid = 0;
+#endif  // SDTN_OMP_ENABLED
+        auto& local_data = thread_data[tid];
+        auto& local_indices = thread_indices[tid];
+        std::vector<size_t> starts;
+        std::vector<idxT> terms;
+
+#if defined(SDTN_OMP_ENABLED)
+#pragma omp for schedule(dynamic, 256)
+#endif  // SDTN_OMP_ENABLED
+        for (int64_t i = 0; i < nrows; ++i) {
+            terms.clear();
+            for_each_ngram(
+                docs[i], n, starts, [&](const std::string_view ngram) {
+                    if (hashed) {
+                        terms.push_back(
+                            static_cast<idxT>(fnv1a(ngram) % n_buckets)
+                        );
+                    } else if (auto it = columns.find(ngram);
+                               it != columns.end()) {
+                        terms.push_back(it->second);
+                    }
+                }
+            );
+            std::sort(terms.begin(), terms.end());
+
+            row_thread[i] = tid;
+            row_start[i] = local_indices.size();
+            double norm = 0.0;
+            for (size_t k = 0; k < terms.size();) {
+                const idxT term = terms[k];
+                size_t tf = 0;
+                for (; k < terms.size() && terms[k] == term; ++k) {
+                    tf++;
+                }
+                double val = static_cast<double>(tf);
+                if (sublinear_tf) {
+                    val = 1.0 + std::log(val);
+                }
+                if (idf) {
+                    val *= idf[term];
+                }
+                norm += val * val;
+                local_indices.push_back(term);
+                local_data.push_back(static_cast<eT>(val));
+            }
+            if (normalize && norm > 0.0) {
+                const double scale = 1.0 / std::sqrt(norm);
+                for (size_t k = row_start[i]; k < local_data.size(); ++k) {
+                    local_data[k] = static_cast<eT>(local_data[k] * scale);
+                }
+            }
+            C_indptr[i + 1]
+                = static_cast<ptrT>(local_indices.size() - row_start[i]);
+        }
+    }
+
+    C_indptr[0] = 0;
+    for (int64_t i = 0; i < nrows; ++i) {
+        C_indptr[i + 1] += C_indptr[i];
+    }
+    const auto total_nonzero = static_cast<size_t>(C_indptr[nrows]);
+    auto C_indices = std::unique_ptr<idxT[]>(new idxT[total_nonzero]);
+    auto C_data = std::unique_ptr<eT[]>(new eT[total_nonzero]);
+#if defined(SDTN_OMP_ENABLED)
+#pragma omp parallel for num_threads(n_threads) schedule(static)
+#endif  // SDTN_OMP_ENABLED
+    for (int64_t i = 0; i < nrows; ++i) {
+        const size_t n_set = C_indptr[i + 1] - C_indptr[i];
+        const size_t src = row_start[i];
+        const int tid = row_thread[i];
+        std::copy_n(
+            thread_indices[tid].begin() + src,
+            n_set,
+            C_indices.get() + C_indptr[i]
+        );
+        std::copy_n(
+            thread_data[tid].begin() + src, n_set, C_data.get() + C_indptr[i]
+        );
+    }
+    return std::make_tuple(
+        total_nonzero, C_data.release(), C_indices.release(), C_indptr.release()
+    );
+}
+
+}  // namespace sdtn::core
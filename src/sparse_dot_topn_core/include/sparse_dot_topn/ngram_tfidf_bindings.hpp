@@ -0,0 +1,100 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/ngram_tfidf.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+inline core::Documents to_documents(
+    const nb_vec<uint8_t>& data, const nb_vec<int64_t>& offsets
+) {
+    const auto size = static_cast<int64_t>(offsets.size());
+    return {data.data(), offsets.data(), size > 0 ? size - 1 : 0};
+}
+
+inline nb::tuple ngram_vocabulary(
+    const int n,
+    const int n_threads,
+    const nb_vec<uint8_t>& docs_data,
+    const nb_vec<int64_t>& docs_offsets
+) {
+    auto [V_data, V_offsets] = core::ngram_vocabulary(
+        to_documents(docs_data, docs_offsets), n, n_threads
+    );
+    return nb::make_tuple(
+        to_nbvec<uint8_t>(std::move(V_data)),
+        to_nbvec<int64_t>(std::move(V_offsets))
+    );
+}
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple ngram_tfidf(
+    const int n,
+    const idxT n_features,
+    const bool sublinear_tf,
+    const std::optional<nb_vec<eT>>& idf,
+    const bool normalize,
+    const int n_threads,
+    const nb_vec<uint8_t>& docs_data,
+    const nb_vec<int64_t>& docs_offsets,
+    const nb_vec<uint8_t>& vocab_data,
+    const nb_vec<int64_t>& vocab_offsets
+) {
+    const auto docs = to_documents(docs_data, docs_offsets);
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::ngram_tfidf<eT, idxT, ptrT>(
+            docs,
+            to_documents(vocab_data, vocab_offsets),
+            n,
+            n_features,
+            sublinear_tf,
+            idf ? idf->data() : nullptr,
+            normalize,
+            n_threads
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, docs.size + 1)
+    );
+}
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_ngram_tfidf(nb::module_& m);
+}  // namespace bindings
+}  // namespace sdtn
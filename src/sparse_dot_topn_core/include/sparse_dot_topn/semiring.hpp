@@ -0,0 +1,95 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+namespace sdtn::core {
+
+/**
+ * \brief The operations used to score a row of A with a column of B.
+ *
+ * \details The score of (i, k) is computed as
+ * `finalize(accumulate(..., combine(A(i, j), B(j, k)), ...))` over the
+ * shared j starting from `zero()`, the identity of `accumulate`.
+ * The top n retains the largest finalized scores.
+ *
+ * The operations are performed in `value_type`, the accumulator type, which
+ * can be wider than the element type of the matrices.
+ *
+ * The semirings below are the predefined implementations, any type with the
+ * same members can be passed to the kernels.
+ */
+template <typename eT>
+struct PlusTimes {
+    using value_type = eT;
+
+    static constexpr eT zero() { return eT(0); }
+    static eT combine(const eT a, const eT b) { return a * b; }
+    static eT accumulate(const eT acc, const eT x) { return acc + x; }
+    static eT finalize(const eT acc) { return acc; }
+};
+
+/**
+ * \brief The largest product of the shared elements.
+ */
+template <typename eT>
+struct MaxTimes {
+    using value_type = eT;
+
+    static constexpr eT zero() { return std::numeric_limits<eT>::lowest(); }
+    static eT combine(const eT a, const eT b) { return a * b; }
+    static eT accumulate(const eT acc, const eT x) { return std::max(acc, x); }
+    static eT finalize(const eT acc) { return acc; }
+};
+
+/**
+ * \brief The smallest sum of the shared elements, e.g. the shortest path of
+ * two steps.
+ *
+ * \details The score is negated such that the top n retains the smallest
+ * sums. For integers the sum is clamped to `-max()` before it is negated,
+ * as the negation of `min()` is out of range.
+ */
+template <typename eT>
+struct MinPlus {
+    using value_type = eT;
+
+    static constexpr eT zero() { return std::numeric_limits<eT>::max(); }
+    static eT combine(const eT a, const eT b) { return a + b; }
+    static eT accumulate(const eT acc, const eT x) { return std::min(acc, x); }
+    static eT finalize(const eT acc) {
+        return -std::max(acc, static_cast<eT>(-std::numeric_limits<eT>::max()));
+    }
+};
+
+/**
+ * \brief The sum of the minimum of the shared elements, e.g. the numerator of
+ * the weighted Jaccard similarity.
+ */
+template <typename eT>
+struct PlusMin {
+    using value_type = eT;
+
+    static constexpr eT zero() { return eT(0); }
+    static eT combine(const eT a, const eT b) { return std::min(a, b); }
+    static eT accumulate(const eT acc, const eT x) { return acc + x; }
+    static eT finalize(const eT acc) { return acc; }
+};
+
+}  // namespace sdtn::core
@@ -15,32 +15,33 @@
  * limitations under the License.
  */
 #pragma once
+#include <algorithm>
 #include <vector>
 
 #include <sparse_dot_topn/common.hpp>
 
 namespace sdtn::core {
 
-template <typename idxT, iffInt<idxT> = true>
-inline idxT sp_matmul_size(
+template <typename idxT, typename ptrT, iffInt<idxT> = true, iffInt<ptrT> = true>
+inline ptrT sp_matmul_size(
     const idxT nrows,
     const idxT ncols,
-    const idxT* __restrict A_indptr,
+    const ptrT* __restrict A_indptr,
     const idxT* __restrict A_indices,
-    const idxT* __restrict B_indptr,
+    const ptrT* __restrict B_indptr,
     const idxT* __restrict B_indices,
-    idxT* __restrict C_indptr
+    ptrT* __restrict C_indptr
 ) {
-    idxT nnz = 0;
+    ptrT nnz = 0;
     C_indptr[0] = 0;
     std::vector<idxT> mask(ncols, -1);
     for (idxT i = 0; i < nrows; i++) {
         idxT row_nnz = 0;
-        idxT A_cidx_start = A_indptr[i];
-        idxT A_cidx_end = A_indptr[i + 1];
-        for (idxT A_cidx = A_cidx_start; A_cidx < A_cidx_end; ++A_cidx) {
+        ptrT A_cidx_start = A_indptr[i];
+        ptrT A_cidx_end = A_indptr[i + 1];
+        for (ptrT A_cidx = A_cidx_start; A_cidx < A_cidx_end; ++A_cidx) {
             idxT j = A_indices[A_cidx];
-            for (idxT kk = B_indptr[j]; kk < B_indptr[j + 1]; ++kk) {
+            for (ptrT kk = B_indptr[j]; kk < B_indptr[j + 1]; ++kk) {
                 idxT k = B_indices[kk];
                 if (mask[k] != i) {
                     mask[k] = i;
@@ -54,6 +55,45 @@ inline idxT sp_matmul_size(
     return nnz;
 }
 
+/**
+ * \brief Collect the columns of the linked list starting at `head` in
+ * increasing order.
+ *
+ * \details Rows that set a large fraction of the columns are collected with
+ * a sweep over `next`, which avoids sorting, otherwise the linked list is
+ * sorted.
+ *
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \param[in] head the first column of the linked list
+ * \param[in] length the number of columns in the linked list
+ * \param[in] ncols the number of columns in B
+ * \param[in] next linked list of the columns set for the row
+ * \param[out] cols the sorted columns
+ */
+template <typename idxT, iffInt<idxT> = true>
+inline void sorted_row_columns(
+    idxT head,
+    const idxT length,
+    const idxT ncols,
+    const std::vector<idxT>& next,
+    std::vector<idxT>& cols
+) {
+    cols.clear();
+    if (static_cast<size_t>(length) * 16 > static_cast<size_t>(ncols)) {
+        for (idxT k = 0; k < ncols; ++k) {
+            if (next[k] != -1) {
+                cols.push_back(k);
+            }
+        }
+        return;
+    }
+    for (idxT jj = 0; jj < length; ++jj) {
+        cols.push_back(head);
+        head = next[head];
+    }
+    std::sort(cols.begin(), cols.end());
+}
+
 /*
  * \brief Compute A.dot(B).
  *
@@ -71,6 +111,9 @@ inline idxT sp_matmul_size(
  *
  * \tparam eT   element type of the matrices
  * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam sort_indices store the columns of each row of C in increasing order
  * \param[in] nrows the number of rows in A
  * \param[in] ncols the number of columns in B
  * \param[in] A_data the nonzero elements of A
@@ -83,37 +126,44 @@ inline idxT sp_matmul_size(
  * \param[out] C_indptr array containing the row indices for `C_data`
  * \param[out] C_indices array containing the column indices
  */
-template <typename eT, typename idxT, iffInt<idxT> = true>
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    bool sort_indices = false,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
 void sp_matmul(
     const idxT nrows,
     const idxT ncols,
     const eT* __restrict A_data,
-    const idxT* __restrict A_indptr,
+    const ptrT* __restrict A_indptr,
     const idxT* __restrict A_indices,
     const eT* __restrict B_data,
-    const idxT* __restrict B_indptr,
+    const ptrT* __restrict B_indptr,
     const idxT* __restrict B_indices,
     eT* __restrict C_data,
     idxT* __restrict C_indices
 ) {
     std::vector<idxT> next(ncols, -1);
     std::vector<eT> sums(ncols, 0);
+    std::vector<idxT> cols;
 
-    idxT nnz = 0;
+    ptrT nnz = 0;
 
     for (idxT i = 0; i < nrows; i++) {
         idxT head = -2;
         idxT length = 0;
 
-        idxT jj_start = A_indptr[i];
-        idxT jj_end = A_indptr[i + 1];
-        for (idxT jj = jj_start; jj < jj_end; jj++) {
+        ptrT jj_start = A_indptr[i];
+        ptrT jj_end = A_indptr[i + 1];
+        for (ptrT jj = jj_start; jj < jj_end; jj++) {
             idxT j = A_indices[jj];
             eT v = A_data[jj];
 
-            idxT kk_start = B_indptr[j];
-            idxT kk_end = B_indptr[j + 1];
-            for (idxT kk = kk_start; kk < kk_end; kk++) {
+            ptrT kk_start = B_indptr[j];
+            ptrT kk_end = B_indptr[j + 1];
+            for (ptrT kk = kk_start; kk < kk_end; kk++) {
                 idxT k = B_indices[kk];
 
                 sums[k] += v * B_data[kk];
@@ -126,34 +176,47 @@ void sp_matmul(
             }
         }
 
-        for (idxT jj = 0; jj < length; jj++) {
-            if (sums[head] != 0) {
-                C_indices[nnz] = head;
-                C_data[nnz] = sums[head];
-                nnz++;
+        if constexpr (sort_indices) {
+            sorted_row_columns(head, length, ncols, next, cols);
+            for (const idxT k : cols) {
+                if (sums[k] != 0) {
+                    C_indices[nnz] = k;
+                    C_data[nnz] = sums[k];
+                    nnz++;
+                }
+                next[k] = -1;  // clear arrays
+                sums[k] = 0;
             }
+        } else {
+            for (idxT jj = 0; jj < length; jj++) {
+                if (sums[head] != 0) {
+                    C_indices[nnz] = head;
+                    C_data[nnz] = sums[head];
+                    nnz++;
+                }
 
-            idxT temp = head;
-            head = next[head];
+                idxT temp = head;
+                head = next[head];
 
-            next[temp] = -1;  // clear arrays
-            sums[temp] = 0;
+                next[temp] = -1;  // clear arrays
+                sums[temp] = 0;
+            }
         }
     }
 }
 
 #if defined(SDTN_OMP_ENABLED)
-template <typename idxT, iffInt<idxT> = true>
-inline idxT sp_matmul_size_mt(
+template <typename idxT, typename ptrT, iffInt<idxT> = true, iffInt<ptrT> = true>
+inline ptrT sp_matmul_size_mt(
     const idxT nrows,
     const idxT ncols,
-    const idxT* __restrict A_indptr,
+    const ptrT* __restrict A_indptr,
     const idxT* __restrict A_indices,
-    const idxT* __restrict B_indptr,
+    const ptrT* __restrict B_indptr,
     const idxT* __restrict B_indices,
-    idxT* __restrict C_indptr
+    ptrT* __restrict C_indptr
 ) {
-    idxT nnz = 0;
+    ptrT nnz = 0;
     C_indptr[0] = 0;
 #pragma omp parallel default(none) shared(                                    \
         nrows, ncols, A_indptr, A_indices, B_indptr, B_indices, C_indptr, nnz \
@@ -163,11 +226,11 @@ inline idxT sp_matmul_size_mt(
 #pragma omp for reduction(+ : nnz)
         for (idxT i = 0; i < nrows; i++) {
             idxT row_nnz = 0;
-            idxT A_cidx_start = A_indptr[i];
-            idxT A_cidx_end = A_indptr[i + 1];
-            for (idxT A_cidx = A_cidx_start; A_cidx < A_cidx_end; ++A_cidx) {
+            ptrT A_cidx_start = A_indptr[i];
+            ptrT A_cidx_end = A_indptr[i + 1];
+            for (ptrT A_cidx = A_cidx_start; A_cidx < A_cidx_end; ++A_cidx) {
                 idxT j = A_indices[A_cidx];
-                for (idxT kk = B_indptr[j]; kk < B_indptr[j + 1]; ++kk) {
+                for (ptrT kk = B_indptr[j]; kk < B_indptr[j + 1]; ++kk) {
                     idxT k = B_indices[kk];
                     if (mask[k] != i) {
                         mask[k] = i;
@@ -200,30 +263,42 @@ inline idxT sp_matmul_size_mt(
  *  All modifications copyright INGA WB.
  *
  * \tparam eT   element type of the matrices
- * \tparam idxT integer type of the index arrays, must be at least 32 bit
- * int \param[in] nrows the number of rows in A \param[in] ncols the number
- * of columns in B \param[in] A_data the nonzero elements of A \param[in]
- * A_indptr array containing the row indices for `A_data` \param[in]
- * A_indices array containing the column indices \param[in] B_data the
- * nonzero elements of B \param[in] B_indptr array containing the row
- * indices for `B_data` \param[in] B_indices array containing the column
- * indices \param[out] C_data the nonzero elements of C \param[out] C_indptr
- * array containing the row indices for `C_data` \param[out] C_indices array
- * containing the column indices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam sort_indices store the columns of each row of C in increasing order
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] n_threads number of threads to use
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[out] C_data the nonzero elements of C
+ * \param[out] C_indptr array containing the row indices for `C_data`
+ * \param[out] C_indices array containing the column indices
  */
-template <typename eT, typename idxT, iffInt<idxT> = true>
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    bool sort_indices = false,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
 void sp_matmul_mt(
     const idxT nrows,
     const idxT ncols,
     const int n_threads,
     const eT* __restrict A_data,
-    const idxT* __restrict A_indptr,
+    const ptrT* __restrict A_indptr,
     const idxT* __restrict A_indices,
     const eT* __restrict B_data,
-    const idxT* __restrict B_indptr,
+    const ptrT* __restrict B_indptr,
     const idxT* __restrict B_indices,
     eT* __restrict C_data,
-    idxT* __restrict C_indptr,
+    ptrT* __restrict C_indptr,
     idxT* __restrict C_indices
 ) {
 #pragma omp parallel num_threads(n_threads) default(none) \
@@ -241,6 +316,7 @@ void sp_matmul_mt(
     {
         std::vector<idxT> next(ncols, -1);
         std::vector<eT> sums(ncols, 0);
+        std::vector<idxT> cols;
 
 #pragma omp for
         for (idxT i = 0; i < nrows; i++) {
@@ -250,15 +326,15 @@ void sp_matmul_mt(
             idxT* local_C_indices = C_indices + C_indptr[i];
             eT* local_C_data = C_data + C_indptr[i];
 
-            idxT jj_start = A_indptr[i];
-            idxT jj_end = A_indptr[i + 1];
-            for (idxT jj = jj_start; jj < jj_end; jj++) {
+            ptrT jj_start = A_indptr[i];
+            ptrT jj_end = A_indptr[i + 1];
+            for (ptrT jj = jj_start; jj < jj_end; jj++) {
                 idxT j = A_indices[jj];
                 eT v = A_data[jj];
 
-                idxT kk_start = B_indptr[j];
-                idxT kk_end = B_indptr[j + 1];
-                for (idxT kk = kk_start; kk < kk_end; kk++) {
+                ptrT kk_start = B_indptr[j];
+                ptrT kk_end = B_indptr[j + 1];
+                for (ptrT kk = kk_start; kk < kk_end; kk++) {
                     idxT k = B_indices[kk];
 
                     sums[k] += v * B_data[kk];
@@ -271,18 +347,31 @@ void sp_matmul_mt(
                 }
             }
 
-            for (idxT jj = 0; jj < length; jj++) {
-                if (sums[head] != 0) {
-                    local_C_indices[nnz] = head;
-                    local_C_data[nnz] = sums[head];
-                    nnz++;
+            if constexpr (sort_indices) {
+                sorted_row_columns(head, length, ncols, next, cols);
+                for (const idxT k : cols) {
+                    if (sums[k] != 0) {
+                        local_C_indices[nnz] = k;
+                        local_C_data[nnz] = sums[k];
+                        nnz++;
+                    }
+                    next[k] = -1;  // clear arrays
+                    sums[k] = 0;
                 }
+            } else {
+                for (idxT jj = 0; jj < length; jj++) {
+                    if (sums[head] != 0) {
+                        local_C_indices[nnz] = head;
+                        local_C_data[nnz] = sums[head];
+                        nnz++;
+                    }
 
-                idxT temp = head;
-                head = next[head];
+                    idxT temp = head;
+                    head = next[head];
 
-                next[temp] = -1;  // clear arrays
-                sums[temp] = 0;
+                    next[temp] = -1;  // clear arrays
+                    sums[temp] = 0;
+                }
             }
         }
     }  // #pragma omp parallel
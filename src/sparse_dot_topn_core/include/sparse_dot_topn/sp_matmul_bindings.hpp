@@ -19,7 +19,7 @@
 #include <nanobind/ndarray.h>
 #include <nanobind/stl/optional.h>
 
-#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/common_bindings.hpp>
 #include <sparse_dot_topn/sp_matmul.hpp>
 
 namespace sdtn {
@@ -28,19 +28,25 @@ namespace nb = nanobind;
 
 namespace api {
 
-template <typename eT, typename idxT, core::iffInt<idxT> = true>
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    bool sort_indices = false,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
 inline nb::tuple sp_matmul(
     const idxT nrows,
     const idxT ncols,
     const nb_vec<eT>& A_data,
-    const nb_vec<idxT>& A_indptr,
+    const nb_vec<ptrT>& A_indptr,
     const nb_vec<idxT>& A_indices,
     const nb_vec<eT>& B_data,
-    const nb_vec<idxT>& B_indptr,
+    const nb_vec<ptrT>& B_indptr,
     const nb_vec<idxT>& B_indices
 ) {
-    idxT* C_indptr = new idxT[nrows + 1];
-    idxT result_size = core::sp_matmul_size(
+    ptrT* C_indptr = new ptrT[nrows + 1];
+    ptrT result_size = core::sp_matmul_size(
         nrows,
         ncols,
         A_indptr.data(),
@@ -53,7 +59,7 @@ inline nb::tuple sp_matmul(
     idxT* C_indices = new idxT[result_size];
     eT* C_data = new eT[result_size];
 
-    core::sp_matmul<eT, idxT>(
+    core::sp_matmul<eT, idxT, ptrT, sort_indices>(
         nrows,
         ncols,
         A_data.data(),
@@ -68,26 +74,32 @@ inline nb::tuple sp_matmul(
     return nb::make_tuple(
         to_nbvec<eT>(C_data, result_size),
         to_nbvec<idxT>(C_indices, result_size),
-        to_nbvec<idxT>(C_indptr, nrows + 1)
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
     );
 }
 
 #if defined(SDTN_OMP_ENABLED)
-template <typename eT, typename idxT, core::iffInt<idxT> = true>
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    bool sort_indices = false,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
 inline nb::tuple sp_matmul_mt(
     const idxT nrows,
     const idxT ncols,
     const int n_threads,
     const nb_vec<eT>& A_data,
-    const nb_vec<idxT>& A_indptr,
+    const nb_vec<ptrT>& A_indptr,
     const nb_vec<idxT>& A_indices,
     const nb_vec<eT>& B_data,
-    const nb_vec<idxT>& B_indptr,
+    const nb_vec<ptrT>& B_indptr,
     const nb_vec<idxT>& B_indices
 ) {
-    idxT* C_indptr = new idxT[nrows + 1];
+    ptrT* C_indptr = new ptrT[nrows + 1];
 
-    idxT result_size = core::sp_matmul_size_mt<idxT>(
+    ptrT result_size = core::sp_matmul_size_mt<idxT, ptrT>(
         nrows,
         ncols,
         A_indptr.data(),
@@ -99,7 +111,7 @@ inline nb::tuple sp_matmul_mt(
     idxT* C_indices = new idxT[result_size];
     eT* C_data = new eT[result_size];
 
-    core::sp_matmul_mt<eT, idxT>(
+    core::sp_matmul_mt<eT, idxT, ptrT, sort_indices>(
         nrows,
         ncols,
         n_threads,
@@ -116,7 +128,7 @@ inline nb::tuple sp_matmul_mt(
     return nb::make_tuple(
         to_nbvec<eT>(C_data, result_size),
         to_nbvec<idxT>(C_indices, result_size),
-        to_nbvec<idxT>(C_indptr, nrows + 1)
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
     );
 }
 #endif  // SDTN_OMP_ENABLED
@@ -126,8 +138,10 @@ inline nb::tuple sp_matmul_mt(
 namespace bindings {
 
 void bind_sp_matmul(nb::module_& m);
+void bind_sp_matmul_canonical(nb::module_& m);
 #if defined(SDTN_OMP_ENABLED)
 void bind_sp_matmul_mt(nb::module_& m);
+void bind_sp_matmul_canonical_mt(nb::module_& m);
 #endif  // SDTN_OMP_ENABLED
 
 }  // namespace bindings
@@ -0,0 +1,522 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief The scratch space of a single thread for the masked product.
+ *
+ * \details `mask[k] == i` marks the columns of row `i` of M, `hit[k] == i`
+ * the columns that received a contribution.
+ */
+template <typename eT, typename idxT>
+struct MaskedBuffers {
+    std::vector<idxT> mask;
+    std::vector<idxT> hit;
+    std::vector<eT> sums;
+
+    explicit MaskedBuffers(const idxT ncols)
+        : mask(ncols, -1), hit(ncols, -1), sums(ncols, 0) {}
+};
+
+/**
+ * \brief Accumulate row `i` of A.dot(B) for the columns in row `i` of the
+ * mask M, the other columns are skipped.
+ */
+template <typename eT, typename idxT, typename ptrT>
+inline void sp_matmul_masked_accumulate(
+    const idxT i,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices,
+    MaskedBuffers<eT, idxT>& buf
+) {
+    for (ptrT kk = M_indptr[i]; kk < M_indptr[i + 1]; ++kk) {
+        buf.mask[M_indices[kk]] = i;
+    }
+    for (ptrT A_cidx = A_indptr[i]; A_cidx < A_indptr[i + 1]; ++A_cidx) {
+        const idxT j = A_indices[A_cidx];
+        const eT v = A_data[A_cidx];
+        for (ptrT B_ridx = B_indptr[j]; B_ridx < B_indptr[j + 1]; ++B_ridx) {
+            const idxT k = B_indices[B_ridx];
+            if (buf.mask[k] != i) {
+                continue;
+            }
+            buf.sums[k] += v * B_data[B_ridx];
+            buf.hit[k] = i;
+        }
+    }
+}
+
+/**
+ * \brief Compute row `i` of A.dot(B) * M and store it in the slots of the
+ * row.
+ *
+ * \details The elements are stored in the order of the columns of row `i`
+ * of M, only the positions that received a contribution are stored.
+ *
+ * \returns the number of elements stored
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_masked_row(
+    const idxT i,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices,
+    MaskedBuffers<eT, idxT>& buf,
+    eT* __restrict values,
+    idxT* __restrict indices
+) {
+    sp_matmul_masked_accumulate(
+        i,
+        A_data,
+        A_indptr,
+        A_indices,
+        B_data,
+        B_indptr,
+        B_indices,
+        M_indptr,
+        M_indices,
+        buf
+    );
+    idxT n_set = 0;
+    for (ptrT kk = M_indptr[i]; kk < M_indptr[i + 1]; ++kk) {
+        const idxT k = M_indices[kk];
+        if (buf.hit[k] == i) {
+            values[n_set] = buf.sums[k];
+            indices[n_set] = k;
+            n_set++;
+            // a duplicate column in M is only stored once
+            buf.hit[k] = -1;
+        }
+        buf.sums[k] = 0;
+    }
+    return n_set;
+}
+
+/**
+ * \brief Compute row `i` of A.dot(B) * M and retain the top n values in
+ * `max_heap`.
+ *
+ * \returns the number of values retained in the heap
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_masked_row(
+    const idxT i,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices,
+    MaskedBuffers<eT, idxT>& buf,
+    MaxHeap<eT, idxT>& max_heap
+) {
+    eT min = max_heap.reset();
+    sp_matmul_masked_accumulate(
+        i,
+        A_data,
+        A_indptr,
+        A_indices,
+        B_data,
+        B_indptr,
+        B_indices,
+        M_indptr,
+        M_indices,
+        buf
+    );
+    for (ptrT kk = M_indptr[i]; kk < M_indptr[i + 1]; ++kk) {
+        const idxT k = M_indices[kk];
+        if (buf.hit[k] == i && buf.sums[k] > min) {
+            min = max_heap.push_pop(k, buf.sums[k]);
+        }
+        buf.hit[k] = -1;
+        buf.sums[k] = 0;
+    }
+
+    max_heap.template sort<sort_order>();
+    return max_heap.get_n_set();
+}
+
+/**
+ * \brief Compute A.dot(B) * M, the product restricted to the sparsity
+ * pattern of the mask M.
+ *
+ * \details Only the columns in the row of M are accumulated, the result has
+ * at most as many nonzero elements as M and the columns of a row are in the
+ * order of M. Positions of M without a shared element of A and B are not
+ * stored.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in] M_indptr array containing the row indices of the mask
+ * \param[in] M_indices array containing the column indices of the mask
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_masked(
+    const idxT nrows,
+    const idxT ncols,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices
+) {
+    const size_t n_slots = M_indptr[nrows] - M_indptr[0];
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    auto buf = MaskedBuffers<eT, idxT>(ncols);
+    for (idxT i = 0; i < nrows; ++i) {
+        const ptrT offset = M_indptr[i] - M_indptr[0];
+        row_nset[i] = sp_matmul_masked_row<eT, idxT, ptrT>(
+            i,
+            A_data,
+            A_indptr,
+            A_indices,
+            B_data,
+            B_indptr,
+            B_indices,
+            M_indptr,
+            M_indices,
+            buf,
+            values.get() + offset,
+            indices.get() + offset
+        );
+    }
+    // the slots of row `i` start at `M_indptr[i]`
+    return sp_matmul_compact<eT, idxT, ptrT>(
+        nrows,
+        values.get(),
+        indices.get(),
+        row_nset.get(),
+        [M_indptr](const idxT i) {
+            return static_cast<size_t>(M_indptr[i] - M_indptr[0]);
+        }
+    );
+}
+
+/**
+ * \brief Compute A.dot(B) * M keeping only the top n results, where M is a
+ * mask that restricts the product to its sparsity pattern.
+ *
+ * \details Only the columns in the row of M are accumulated and offered to
+ * the heap.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] threshold minimum values required to store
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in] M_indptr array containing the row indices of the mask
+ * \param[in] M_indices array containing the column indices of the mask
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_masked(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices
+) {
+    // a row holds at most min(top_n, nnz of the row of M) elements
+    const size_t n_slots = M_indptr[nrows] - M_indptr[0];
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    auto buf = MaskedBuffers<eT, idxT>(ncols);
+    auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+    for (idxT i = 0; i < nrows; ++i) {
+        const ptrT offset = M_indptr[i] - M_indptr[0];
+        const idxT n_set
+            = sp_matmul_topn_masked_row<eT, idxT, ptrT, sort_order>(
+                i,
+                A_data,
+                A_indptr,
+                A_indices,
+                B_data,
+                B_indptr,
+                B_indices,
+                M_indptr,
+                M_indices,
+                buf,
+                max_heap
+            );
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            indices[offset + ii] = max_heap.heap[ii].idx;
+            values[offset + ii] = max_heap.heap[ii].val;
+        }
+        row_nset[i] = n_set;
+    }
+    // the slots of row `i` start at `M_indptr[i]`
+    return sp_matmul_compact<eT, idxT, ptrT>(
+        nrows,
+        values.get(),
+        indices.get(),
+        row_nset.get(),
+        [M_indptr](const idxT i) {
+            return static_cast<size_t>(M_indptr[i] - M_indptr[0]);
+        }
+    );
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute A.dot(B) * M using `n_threads`, see `sp_matmul_masked`.
+ *
+ * \param[in] n_threads number of threads to use
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_masked_mt(
+    const idxT nrows,
+    const idxT ncols,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices
+) {
+    const size_t n_slots = M_indptr[nrows] - M_indptr[0];
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+#pragma omp parallel num_threads(n_threads) \
+    shared(nrows,                           \
+               ncols,                       \
+               A_data,                      \
+               A_indptr,                    \
+               A_indices,                   \
+               B_data,                      \
+               B_indptr,                    \
+               B_indices,                   \
+               M_indptr,                    \
+               M_indices,                   \
+               values,                      \
+               indices,                     \
+               row_nset)
+    {
+        auto buf = MaskedBuffers<eT, idxT>(ncols);
+#pragma omp for schedule(dynamic, 64)
+        for (idxT i = 0; i < nrows; ++i) {
+            const ptrT offset = M_indptr[i] - M_indptr[0];
+            row_nset[i] = sp_matmul_masked_row<eT, idxT, ptrT>(
+                i,
+                A_data,
+                A_indptr,
+                A_indices,
+                B_data,
+                B_indptr,
+                B_indices,
+                M_indptr,
+                M_indices,
+                buf,
+                values.get() + offset,
+                indices.get() + offset
+            );
+        }
+    }  // #pragma omp parallel
+    // the slots of row `i` start at `M_indptr[i]`
+    return sp_matmul_compact<eT, idxT, ptrT>(
+        nrows,
+        values.get(),
+        indices.get(),
+        row_nset.get(),
+        [M_indptr](const idxT i) {
+            return static_cast<size_t>(M_indptr[i] - M_indptr[0]);
+        }
+    );
+}
+
+/**
+ * \brief Compute A.dot(B) * M keeping only the top n results using
+ * `n_threads`, see `sp_matmul_topn_masked`.
+ *
+ * \param[in] n_threads number of threads to use
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_masked_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const ptrT* __restrict M_indptr,
+    const idxT* __restrict M_indices
+) {
+    const size_t n_slots = M_indptr[nrows] - M_indptr[0];
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+#pragma omp parallel num_threads(n_threads) \
+    shared(top_n,                           \
+               nrows,                       \
+               ncols,                       \
+               threshold,                   \
+               A_data,                      \
+               A_indptr,                    \
+               A_indices,                   \
+               B_data,                      \
+               B_indptr,                    \
+               B_indices,                   \
+               M_indptr,                    \
+               M_indices,                   \
+               values,                      \
+               indices,                     \
+               row_nset)
+    {
+        auto buf = MaskedBuffers<eT, idxT>(ncols);
+        auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+#pragma omp for schedule(dynamic, 64)
+        for (idxT i = 0; i < nrows; ++i) {
+            const ptrT offset = M_indptr[i] - M_indptr[0];
+            const idxT n_set
+                = sp_matmul_topn_masked_row<eT, idxT, ptrT, sort_order>(
+                    i,
+                    A_data,
+                    A_indptr,
+                    A_indices,
+                    B_data,
+                    B_indptr,
+                    B_indices,
+                    M_indptr,
+                    M_indices,
+                    buf,
+                    max_heap
+                );
+            for (idxT ii = 0; ii < n_set; ++ii) {
+                indices[offset + ii] = max_heap.heap[ii].idx;
+                values[offset + ii] = max_heap.heap[ii].val;
+            }
+            row_nset[i] = n_set;
+        }
+    }  // #pragma omp parallel
+    // the slots of row `i` start at `M_indptr[i]`
+    return sp_matmul_compact<eT, idxT, ptrT>(
+        nrows,
+        values.get(),
+        indices.get(),
+        row_nset.get(),
+        [M_indptr](const idxT i) {
+            return static_cast<size_t>(M_indptr[i] - M_indptr[0]);
+        }
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,284 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif  // __SSE2__
+
+#include <sparse_dot_topn/common.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief The ratio of the lengths of two rows above which the shorter row is
+ * searched in the longer one instead of merging them.
+ */
+inline constexpr std::size_t gallop_ratio = 32;
+
+/**
+ * \brief Dot product of two sparse rows by merging their sorted indices.
+ */
+template <typename eT, typename idxT>
+inline eT sparse_dot_merge(
+    const idxT* __restrict a_idx,
+    const eT* __restrict a_val,
+    const std::size_t a_n,
+    const idxT* __restrict b_idx,
+    const eT* __restrict b_val,
+    const std::size_t b_n
+) {
+    eT acc = 0;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a_n && j < b_n) {
+        const idxT a = a_idx[i];
+        const idxT b = b_idx[j];
+        if (a == b) {
+            acc += a_val[i] * b_val[j];
+        }
+        i += (a <= b);
+        j += (b <= a);
+    }
+    return acc;
+}
+
+/**
+ * \brief Dot product of a short and a long sparse row, the indices of the
+ * short row are located in the long row with an exponential search.
+ */
+template <typename eT, typename idxT>
+inline eT sparse_dot_gallop(
+    const idxT* __restrict a_idx,
+    const eT* __restrict a_val,
+    const std::size_t a_n,
+    const idxT* __restrict b_idx,
+    const eT* __restrict b_val,
+    const std::size_t b_n
+) {
+    eT acc = 0;
+    std::size_t lo = 0;
+    for (std::size_t i = 0; i < a_n && lo < b_n; ++i) {
+        const idxT a = a_idx[i];
+        // b_idx[lo + step / 2] < a <= b_idx[lo + step] after the search
+        std::size_t step = 1;
+        while (lo + step < b_n && b_idx[lo + step] < a) {
+            step *= 2;
+        }
+        const idxT* first = b_idx + lo + step / 2;
+        const idxT* last = b_idx + std::min(lo + step + 1, b_n);
+        lo = std::lower_bound(first, last, a) - b_idx;
+        if (lo < b_n && b_idx[lo] == a) {
+            acc += a_val[i] * b_val[lo];
+        }
+    }
+    return acc;
+}
+
+#if defined(__SSE2__)
+/**
+ * \brief Dot product of two sparse rows with 32 bit indices by intersecting
+ * blocks of four indices at a time.
+ *
+ * \details Every index of the block of `a` is compared with every index of
+ * the block of `b` by comparing against the four rotations of the block of
+ * `b`. The block with the smaller maximum is advanced, the tails are
+ * merged.
+ */
+template <typename eT, typename idxT>
+inline eT sparse_dot_sse2(
+    const idxT* __restrict a_idx,
+    const eT* __restrict a_val,
+    const std::size_t a_n,
+    const idxT* __restrict b_idx,
+    const eT* __restrict b_val,
+    const std::size_t b_n
+) {
+    static_assert(sizeof(idxT) == 4, "requires 32 bit indices");
+    eT acc = 0;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    const std::size_t a_end = a_n & ~std::size_t{3};
+    const std::size_t b_end = b_n & ~std::size_t{3};
+    while (i < a_end && j < b_end) {
+        const __m128i va
+            = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a_idx + i));
+        __m128i vb
+            = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b_idx + j));
+        for (int r = 0; r < 4; ++r) {
+            // lane p of `vb` holds b_idx[j + (p + r) % 4]
+            const int mask = _mm_movemask_ps(
+                _mm_castsi128_ps(_mm_cmpeq_epi32(va, vb))
+            );
+            if (mask) {
+                for (int p = 0; p < 4; ++p) {
+                    if (mask & (1 << p)) {
+                        acc += a_val[i + p] * b_val[j + ((p + r) & 3)];
+                    }
+                }
+            }
+            vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+        }
+        const idxT a_max = a_idx[i + 3];
+        const idxT b_max = b_idx[j + 3];
+        i += (a_max <= b_max) ? 4 : 0;
+        j += (b_max <= a_max) ? 4 : 0;
+    }
+    return acc
+           + sparse_dot_merge(
+               a_idx + i, a_val + i, a_n - i, b_idx + j, b_val + j, b_n - j
+           );
+}
+#endif  // __SSE2__
+
+/**
+ * \brief Dot product of two sparse rows with sorted and unique indices.
+ *
+ * \details Rows of very different lengths are intersected with an
+ * exponential search, otherwise the rows are merged, four indices at a time
+ * when SSE2 is available and the indices are 32 bit.
+ */
+template <typename eT, typename idxT>
+inline eT sparse_dot(
+    const idxT* a_idx,
+    const eT* a_val,
+    std::size_t a_n,
+    const idxT* b_idx,
+    const eT* b_val,
+    std::size_t b_n
+) {
+    if (a_n > b_n) {
+        std::swap(a_idx, b_idx);
+        std::swap(a_val, b_val);
+        std::swap(a_n, b_n);
+    }
+    if (a_n == 0) {
+        return 0;
+    }
+    if (b_n / a_n >= gallop_ratio) {
+        return sparse_dot_gallop(a_idx, a_val, a_n, b_idx, b_val, b_n);
+    }
+#if defined(__SSE2__)
+    if constexpr (sizeof(idxT) == 4) {
+        return sparse_dot_sse2(a_idx, a_val, a_n, b_idx, b_val, b_n);
+    }
+#endif  // __SSE2__
+    return sparse_dot_merge(a_idx, a_val, a_n, b_idx, b_val, b_n);
+}
+
+/**
+ * \brief Compute the dot products of the rows of A and B for the given
+ * pairs, i.e. the elements (rows[k], cols[k]) of A.dot(B.T).
+ *
+ * \details The column indices of the rows of `A` and `B` must be sorted and
+ * unique.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] n_pairs the number of pairs
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in] rows the rows of A of the pairs
+ * \param[in] cols the rows of B of the pairs
+ * \param[out] values the dot product of each pair
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_pairs(
+    const std::size_t n_pairs,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const idxT* __restrict rows,
+    const idxT* __restrict cols,
+    eT* __restrict values
+) {
+    for (std::size_t k = 0; k < n_pairs; ++k) {
+        const ptrT a_start = A_indptr[rows[k]];
+        const ptrT b_start = B_indptr[cols[k]];
+        values[k] = sparse_dot(
+            A_indices + a_start,
+            A_data + a_start,
+            static_cast<std::size_t>(A_indptr[rows[k] + 1] - a_start),
+            B_indices + b_start,
+            B_data + b_start,
+            static_cast<std::size_t>(B_indptr[cols[k] + 1] - b_start)
+        );
+    }
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute the dot products of the rows of A and B for the given
+ * pairs using `n_threads`, see `sp_matmul_pairs`.
+ *
+ * \param[in] n_threads number of threads to use
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_pairs_mt(
+    const std::size_t n_pairs,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const idxT* __restrict rows,
+    const idxT* __restrict cols,
+    eT* __restrict values
+) {
+    // the cost of a pair depends on the lengths of its rows
+#pragma omp parallel for num_threads(n_threads) schedule(dynamic, 1024)
+    for (std::size_t k = 0; k < n_pairs; ++k) {
+        const ptrT a_start = A_indptr[rows[k]];
+        const ptrT b_start = B_indptr[cols[k]];
+        values[k] = sparse_dot(
+            A_indices + a_start,
+            A_data + a_start,
+            static_cast<std::size_t>(A_indptr[rows[k] + 1] - a_start),
+            B_indices + b_start,
+            B_data + b_start,
+            static_cast<std::size_t>(B_indptr[cols[k] + 1] - b_start)
+        );
+    }
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,118 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_pairs.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb_vec<eT> sp_matmul_pairs(
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices,
+    const nb_vec<idxT>& rows,
+    const nb_vec<idxT>& cols
+) {
+    const std::size_t n_pairs = rows.size();
+    if (cols.size() != n_pairs) {
+        throw std::invalid_argument("`rows` and `cols` differ in length");
+    }
+    eT* values = new eT[n_pairs];
+    core::sp_matmul_pairs<eT, idxT, ptrT>(
+        n_pairs,
+        A_data.data(),
+        A_indptr.data(),
+        A_indices.data(),
+        B_data.data(),
+        B_indptr.data(),
+        B_indices.data(),
+        rows.data(),
+        cols.data(),
+        values
+    );
+    return to_nbvec<eT>(values, n_pairs);
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb_vec<eT> sp_matmul_pairs_mt(
+    const int n_threads,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices,
+    const nb_vec<idxT>& rows,
+    const nb_vec<idxT>& cols
+) {
+    const std::size_t n_pairs = rows.size();
+    if (cols.size() != n_pairs) {
+        throw std::invalid_argument("`rows` and `cols` differ in length");
+    }
+    eT* values = new eT[n_pairs];
+    core::sp_matmul_pairs_mt<eT, idxT, ptrT>(
+        n_pairs,
+        n_threads,
+        A_data.data(),
+        A_indptr.data(),
+        A_indices.data(),
+        B_data.data(),
+        B_indptr.data(),
+        B_indices.data(),
+        rows.data(),
+        cols.data(),
+        values
+    );
+    return to_nbvec<eT>(values, n_pairs);
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_pairs(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_pairs_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
@@ -0,0 +1,485 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(SDTN_OMP_ENABLED)
+#include <omp.h>
+#endif  // SDTN_OMP_ENABLED
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief Prefix filtered inverted index over the rows of B.T.
+ *
+ * \details For non-negative matrices the contribution of a set of features
+ * of row `j` of B.T to any product with a row of A is bounded by the sum of
+ * the values times the maximum of the feature in A. The entries of each row
+ * are ordered on decreasing document frequency and the longest leading run,
+ * the residual, whose bound does not exceed the threshold is left out of the
+ * index. A pair can only exceed the threshold when it shares an indexed
+ * feature, the residual is only used to complete the scores of the
+ * candidates. The candidates are additionally pruned with the bound
+ * `||a|| * ||residual||` before they are completed.
+ *
+ * When A or B contain negative values, or the threshold is negative, the
+ * bounds do not hold and every entry is indexed.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+class PrefixIndex {
+    eT threshold;
+    // the bounds are compared to a slightly lower budget such that rounding
+    // in the summation can not cause a match to be pruned
+    eT budget;
+    bool prune;
+    // inverted index over the indexed entries, per feature the rows of B.T
+    std::vector<ptrT> inv_indptr;
+    std::vector<idxT> inv_rows;
+    std::vector<eT> inv_data;
+    // the residual entries of each row of B.T
+    std::vector<ptrT> res_indptr;
+    std::vector<idxT> res_indices;
+    std::vector<eT> res_data;
+    std::vector<double> res_norm;
+
+ public:
+    /**
+     * \brief Build the index.
+     *
+     * \param[in] threshold only pairs with a value greater than are matched
+     * \param[in] n_threads the number of threads to use
+     * \param[in] nrows the number of rows in A
+     * \param[in] ncols the number of columns in B
+     * \param[in] A_ncols the number of columns in A
+     * \param[in] A_data the nonzero elements of A
+     * \param[in] A_indptr array containing the row indices for `A_data`
+     * \param[in] A_indices array containing the column indices
+     * \param[in] Bt_data the nonzero elements of B.T
+     * \param[in] Bt_indptr array containing the row indices for `Bt_data`
+     * \param[in] Bt_indices array containing the column indices
+     */
+    PrefixIndex(
+        const eT threshold,
+        [[maybe_unused]] const int n_threads,
+        const idxT nrows,
+        const idxT ncols,
+        const idxT A_ncols,
+        const eT* __restrict A_data,
+        const ptrT* __restrict A_indptr,
+        const idxT* __restrict A_indices,
+        const eT* __restrict Bt_data,
+        const ptrT* __restrict Bt_indptr,
+        const idxT* __restrict Bt_indices
+    )
+        : threshold{threshold},
+          budget{threshold},
+          inv_indptr(A_ncols + 1, 0),
+          res_indptr(ncols + 1, 0),
+          res_norm(ncols, 0.0) {
+        if constexpr (std::is_floating_point_v<eT>) {
+            budget -= threshold * 64 * std::numeric_limits<eT>::epsilon();
+        }
+        const ptrT A_start = A_indptr[0];
+        const ptrT A_end = A_indptr[nrows];
+        const ptrT Bt_start = Bt_indptr[0];
+        const ptrT Bt_end = Bt_indptr[ncols];
+        prune = threshold >= 0
+                && std::all_of(
+                    A_data + A_start,
+                    A_data + A_end,
+                    [](const eT v) { return v >= 0; }
+                )
+                && std::all_of(
+                    Bt_data + Bt_start,
+                    Bt_data + Bt_end,
+                    [](const eT v) { return v >= 0; }
+                );
+
+        // the maximum of each feature in A and the document frequency of
+        // each feature in B.T
+        std::vector<eT> A_max(A_ncols, 0);
+        std::vector<ptrT> freq(A_ncols, 0);
+        if (prune) {
+            for (ptrT k = A_start; k < A_end; ++k) {
+                A_max[A_indices[k]] = std::max(A_max[A_indices[k]], A_data[k]);
+            }
+            for (ptrT k = Bt_start; k < Bt_end; ++k) {
+                freq[Bt_indices[k]]++;
+            }
+        }
+
+        // split each row of B.T in the residual and the indexed entries
+        std::vector<char> indexed(Bt_end - Bt_start, 1);
+        if (prune) {
+#if defined(SDTN_OMP_ENABLED)
+#pragma omp parallel num_threads(n_threads)
+#endif  // SDTN_OMP_ENABLED
+            {
+                std::vector<ptrT> order;
+#if defined(SDTN_OMP_ENABLED)
+#pragma omp for schedule(dynamic, 256)
+#endif  // SDTN_OMP_ENABLED
+                for (idxT j = 0; j < ncols; ++j) {
+                    order.resize(Bt_indptr[j + 1] - Bt_indptr[j]);
+                    std::iota(order.begin(), order.end(), Bt_indptr[j]);
+                    std::sort(order.begin(), order.end(), [&](ptrT l, ptrT r) {
+                        const ptrT fl = freq[Bt_indices[l]];
+                        const ptrT fr = freq[Bt_indices[r]];
+                        return fl > fr
+                               || (fl == fr && Bt_indices[l] < Bt_indices[r]);
+                    });
+                    eT bound = 0;
+                    for (const ptrT k : order) {
+                        bound += Bt_data[k] * A_max[Bt_indices[k]];
+                        if (bound > budget) {
+                            break;
+                        }
+                        indexed[k - Bt_start] = 0;
+                    }
+                }
+            }
+        }
+
+        // compact the residual entries and count the indexed entries
+        for (idxT j = 0; j < ncols; ++j) {
+            double norm = 0.0;
+            for (ptrT k = Bt_indptr[j]; k < Bt_indptr[j + 1]; ++k) {
+                if (indexed[k - Bt_start]) {
+                    inv_indptr[Bt_indices[k] + 1]++;
+                } else {
+                    res_indices.push_back(Bt_indices[k]);
+                    res_data.push_back(Bt_data[k]);
+                    norm += static_cast<double>(Bt_data[k]) * Bt_data[k];
+                }
+            }
+            res_indptr[j + 1] = static_cast<ptrT>(res_indices.size());
+            res_norm[j] = std::sqrt(norm);
+        }
+        std::partial_sum(
+            inv_indptr.begin(), inv_indptr.end(), inv_indptr.begin()
+        );
+
+        // fill the inverted index, the rows of each feature are increasing
+        inv_rows.resize(inv_indptr[A_ncols]);
+        inv_data.resize(inv_indptr[A_ncols]);
+        std::vector<ptrT> fill(inv_indptr.begin(), inv_indptr.end() - 1);
+        for (idxT j = 0; j < ncols; ++j) {
+            for (ptrT k = Bt_indptr[j]; k < Bt_indptr[j + 1]; ++k) {
+                if (indexed[k - Bt_start]) {
+                    const ptrT dst = fill[Bt_indices[k]]++;
+                    inv_rows[dst] = j;
+                    inv_data[dst] = Bt_data[k];
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Call `emit(j, val)` for every column `j` of row `i` of A.dot(B)
+     * with a value greater than the threshold.
+     *
+     * \details `dense`, `sums` and `next` are scratch arrays initialised with
+     * 0, 0 and -1 of length `A_ncols`, `ncols` and `ncols` respectively, they
+     * are reset on return.
+     */
+    template <typename Func>
+    void query(
+        const idxT i,
+        const eT* __restrict A_data,
+        const ptrT* __restrict A_indptr,
+        const idxT* __restrict A_indices,
+        std::vector<eT>& dense,
+        std::vector<eT>& sums,
+        std::vector<idxT>& next,
+        Func&& emit
+    ) const {
+        idxT head = -2;
+        idxT length = 0;
+        double A_norm = 0.0;
+        for (ptrT k = A_indptr[i]; k < A_indptr[i + 1]; ++k) {
+            const idxT f = A_indices[k];
+            const eT v = A_data[k];
+            dense[f] += v;
+            A_norm += static_cast<double>(v) * v;
+            // the inverted index is in CSR format with a row per feature
+            sp_matmul_accumulate<eT, idxT, ptrT>(
+                v,
+                f,
+                inv_data.data(),
+                inv_indptr.data(),
+                inv_rows.data(),
+                next,
+                sums,
+                head,
+                length
+            );
+        }
+        A_norm = std::sqrt(A_norm);
+
+        sp_matmul_drain<idxT, PlusTimes<eT>>(
+            head,
+            length,
+            next,
+            sums,
+            [&](const idxT j, eT val) {
+                bool candidate = true;
+                if constexpr (std::is_floating_point_v<eT>) {
+                    candidate = !prune || val + A_norm * res_norm[j] > budget;
+                }
+                if (!candidate) {
+                    return;
+                }
+                for (ptrT k = res_indptr[j]; k < res_indptr[j + 1]; ++k) {
+                    val += dense[res_indices[k]] * res_data[k];
+                }
+                if (val > threshold) {
+                    emit(j, val);
+                }
+            }
+        );
+        for (ptrT k = A_indptr[i]; k < A_indptr[i + 1]; ++k) {
+            dense[A_indices[k]] = 0;
+        }
+    }
+};
+
+/**
+ * \brief Compute all elements of A.dot(B) greater than `threshold`.
+ *
+ * \details In contrast to `sp_matmul_topn` the number of values per row is
+ * not bounded and C is sized to the number of matches. B is passed
+ * transposed, i.e. as B.T in CSR format, see `PrefixIndex` for the pruning.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] A_ncols the number of columns in A
+ * \param[in] threshold only store values greater than
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] Bt_data the nonzero elements of B.T
+ * \param[in] Bt_indptr array containing the row indices for `Bt_data`
+ * \param[in] Bt_indices array containing the column indices
+ * \param[out] C_data the nonzero elements of C
+ * \param[out] C_indptr array containing the row indices for `C_data`
+ * \param[out] C_indices array containing the column indices
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_threshold(
+    const idxT nrows,
+    const idxT ncols,
+    const idxT A_ncols,
+    const eT threshold,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict Bt_data,
+    const ptrT* __restrict Bt_indptr,
+    const idxT* __restrict Bt_indices,
+    std::vector<eT>& C_data,
+    std::vector<ptrT>& C_indptr,
+    std::vector<idxT>& C_indices
+) {
+    const auto index = PrefixIndex<eT, idxT, ptrT>(
+        threshold,
+        1,
+        nrows,
+        ncols,
+        A_ncols,
+        A_data,
+        A_indptr,
+        A_indices,
+        Bt_data,
+        Bt_indptr,
+        Bt_indices
+    );
+    std::vector<eT> dense(A_ncols, 0);
+    std::vector<eT> sums(ncols, 0);
+    std::vector<idxT> next(ncols, -1);
+
+    C_indptr[0] = 0;
+    for (idxT i = 0; i < nrows; ++i) {
+        index.query(
+            i,
+            A_data,
+            A_indptr,
+            A_indices,
+            dense,
+            sums,
+            next,
+            [&](const idxT j, const eT val) {
+                C_indices.push_back(j);
+                C_data.push_back(val);
+            }
+        );
+        C_indptr[i + 1] = static_cast<ptrT>(C_indices.size());
+    }
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute all elements of A.dot(B) greater than `threshold` using
+ * `n_threads`.
+ *
+ * \details The matches are collected in a buffer per thread after which they
+ * are copied into the exactly sized C.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] A_ncols the number of columns in A
+ * \param[in] threshold only store values greater than
+ * \param[in] n_threads number of threads to use
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] Bt_data the nonzero elements of B.T
+ * \param[in] Bt_indptr array containing the row indices for `Bt_data`
+ * \param[in] Bt_indices array containing the column indices
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_threshold_mt(
+    const idxT nrows,
+    const idxT ncols,
+    const idxT A_ncols,
+    const eT threshold,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict Bt_data,
+    const ptrT* __restrict Bt_indptr,
+    const idxT* __restrict Bt_indices
+) {
+    const auto index = PrefixIndex<eT, idxT, ptrT>(
+        threshold,
+        n_threads,
+        nrows,
+        ncols,
+        A_ncols,
+        A_data,
+        A_indptr,
+        A_indices,
+        Bt_data,
+        Bt_indptr,
+        Bt_indices
+    );
+
+    // location of the matches of each row in the buffers of the threads
+    auto row_thread = std::unique_ptr<int[]>(new int[nrows]);
+    auto row_start = std::unique_ptr<size_t[]>(new size_t[nrows]);
+    ptrT* C_indptr = new ptrT[nrows + 1];
+    std::vector<std::vector<eT>> thread_data(n_threads);
+    std::vector<std::vector<idxT>> thread_indices(n_threads);
+
+#pragma omp parallel num_threads(n_threads)
+    {
+        const int tid = omp_get_thread_num();
+        auto& local_data = thread_data[tid];
+        auto& local_indices = thread_indices[tid];
+        std::vector<eT> dense(A_ncols, 0);
+        std::vector<eT> sums(ncols, 0);
+        std::vector<idxT> next(ncols, -1);
+
+#pragma omp for schedule(dynamic, 64)
+        for (idxT i = 0; i < nrows; ++i) {
+            row_thread[i] = tid;
+            row_start[i] = local_indices.size();
+            index.query(
+                i,
+                A_data,
+                A_indptr,
+                A_indices,
+                dense,
+                sums,
+                next,
+                [&](const idxT j, const eT val) {
+                    local_indices.push_back(j);
+                    local_data.push_back(val);
+                }
+            );
+            C_indptr[i + 1] = static_cast<ptrT>(
+                local_indices.size() - row_start[i]
+            );
+        }
+    }  // #pragma omp parallel
+
+    C_indptr[0] = 0;
+    for (idxT i = 0; i < nrows; ++i) {
+        C_indptr[i + 1] += C_indptr[i];
+    }
+    const auto total_nonzero = static_cast<size_t>(C_indptr[nrows]);
+    idxT* C_indices = new idxT[total_nonzero];
+    eT* C_data = new eT[total_nonzero];
+#pragma omp parallel for num_threads(n_threads) schedule(static)
+    for (idxT i = 0; i < nrows; ++i) {
+        const size_t n_set = C_indptr[i + 1] - C_indptr[i];
+        const size_t src = row_start[i];
+        const int tid = row_thread[i];
+        std::copy_n(
+            thread_indices[tid].begin() + src, n_set, C_indices + C_indptr[i]
+        );
+        std::copy_n(
+            thread_data[tid].begin() + src, n_set, C_data + C_indptr[i]
+        );
+    }
+    return std::make_tuple(total_nonzero, C_data, C_indices, C_indptr);
+}  // sp_matmul_threshold_mt
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,134 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_threshold.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_threshold(
+    const idxT nrows,
+    const idxT ncols,
+    const idxT A_ncols,
+    std::optional<eT> threshold,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& Bt_data,
+    const nb_vec<ptrT>& Bt_indptr,
+    const nb_vec<idxT>& Bt_indices
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    std::vector<eT> C_data;
+    std::vector<idxT> C_indices;
+    std::vector<ptrT> C_indptr(nrows + 1);
+    core::sp_matmul_threshold<eT, idxT, ptrT>(
+        nrows,
+        ncols,
+        A_ncols,
+        local_threshold,
+        A_data.data(),
+        A_indptr.data(),
+        A_indices.data(),
+        Bt_data.data(),
+        Bt_indptr.data(),
+        Bt_indices.data(),
+        C_data,
+        C_indptr,
+        C_indices
+    );
+    C_data.shrink_to_fit();
+    C_indices.shrink_to_fit();
+    return nb::make_tuple(
+        to_nbvec<eT>(std::move(C_data)),
+        to_nbvec<idxT>(std::move(C_indices)),
+        to_nbvec<ptrT>(std::move(C_indptr))
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_threshold_mt(
+    const idxT nrows,
+    const idxT ncols,
+    const idxT A_ncols,
+    std::optional<eT> threshold,
+    const int n_threads,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& Bt_data,
+    const nb_vec<ptrT>& Bt_indptr,
+    const nb_vec<idxT>& Bt_indices
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::sp_matmul_threshold_mt<eT, idxT, ptrT>(
+            nrows,
+            ncols,
+            A_ncols,
+            local_threshold,
+            n_threads,
+            A_data.data(),
+            A_indptr.data(),
+            A_indices.data(),
+            Bt_data.data(),
+            Bt_indptr.data(),
+            Bt_indices.data()
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_threshold(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_threshold_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
@@ -18,49 +18,432 @@
 #pragma once
 
 #include <algorithm>
-#include <cstring>
 #include <limits>
 #include <memory>
-#include <numeric>
 #include <tuple>
 #include <vector>
 
 #include <sparse_dot_topn/common.hpp>
 #include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/semiring.hpp>
 
 namespace sdtn::core {
 
-template <typename idxT, iffInt<idxT> = true>
-inline idxT sp_matmul_topn_size(
+/**
+ * \brief Upper bound on the number of nonzero elements of the top n product.
+ *
+ * \details The number of nonzero elements of row `i` of A.dot(B) is at most
+ * the sum of the number of elements of the rows of B selected by row `i` of
+ * A. In contrast to the exact count this only requires the index pointer of B
+ * and is therefore linear in the number of nonzero elements of A.
+ *
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \returns the upper bound on the number of nonzero elements, as `size_t` as
+ * it can exceed the range of `ptrT` when C is returned in COO format
+ */
+template <typename idxT, typename ptrT, iffInt<idxT> = true, iffInt<ptrT> = true>
+inline size_t sp_matmul_topn_size(
     const idxT top_n,
     const idxT nrows,
-    const idxT ncols,
-    const idxT* __restrict A_indptr,
+    const ptrT* __restrict A_indptr,
     const idxT* __restrict A_indices,
-    const idxT* __restrict B_indptr,
-    const idxT* __restrict B_indices
+    const ptrT* __restrict B_indptr
 ) {
-    idxT nnz = 0;
-    std::vector<idxT> mask(ncols, -1);
+    size_t nnz = 0;
     for (idxT i = 0; i < nrows; i++) {
-        idxT row_nnz = 0;
-        idxT A_cidx_start = A_indptr[i];
-        idxT A_cidx_end = A_indptr[i + 1];
-        for (idxT A_cidx = A_cidx_start; A_cidx < A_cidx_end; ++A_cidx) {
+        ptrT row_nnz = 0;
+        ptrT A_cidx_start = A_indptr[i];
+        ptrT A_cidx_end = A_indptr[i + 1];
+        for (ptrT A_cidx = A_cidx_start; A_cidx < A_cidx_end; ++A_cidx) {
             idxT j = A_indices[A_cidx];
-            for (idxT kk = B_indptr[j]; kk < B_indptr[j + 1]; ++kk) {
-                idxT k = B_indices[kk];
-                if (mask[k] != i) {
-                    mask[k] = i;
-                    row_nnz++;
-                }
+            row_nnz += (B_indptr[j + 1] - B_indptr[j]);
+            if (row_nnz >= top_n) {
+                break;
             }
         }
-        nnz += std::min(top_n, row_nnz);
+        nnz += static_cast<size_t>(std::min<ptrT>(top_n, row_nnz));
     }
     return nnz;
 }
 
+/**
+ * \brief Accumulate `v` times row `j` of B in `sums`.
+ *
+ * \details The columns that are set for the first time are prepended to the
+ * linked list in `next` that starts at `head` and holds `length` columns.
+ * `next` and `sums` are the scratch arrays of length `ncols`, unset columns
+ * are -1 in `next` and the list is terminated by -2. A row is started with
+ * `head = -2` and `length = 0`, see `sp_matmul_drain` to visit and reset the
+ * columns.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam Semiring the scoring operations, see `PlusTimes`
+ * \param[in] v the value of A in (i, j) in the accumulator type
+ * \param[in] j the row of B
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in,out] next linked list of the columns set for the row
+ * \param[in,out] sums the accumulated values for the row
+ * \param[in,out] head the first column of the linked list
+ * \param[in,out] length the number of columns in the linked list
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    typename Semiring = PlusTimes<eT>,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_accumulate(
+    const typename Semiring::value_type v,
+    const idxT j,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    std::vector<idxT>& next,
+    std::vector<typename Semiring::value_type>& sums,
+    idxT& head,
+    idxT& length
+) {
+    using accT = typename Semiring::value_type;
+    ptrT B_ridx_start = B_indptr[j];
+    ptrT B_ridx_end = B_indptr[j + 1];
+    for (ptrT B_ridx = B_ridx_start; B_ridx < B_ridx_end; B_ridx++) {
+        idxT k = B_indices[B_ridx];  // kth column of B in row j
+
+        // multiply with value of B in (j,k) and accumulate to the
+        // result for kth column of row i
+        sums[k] = Semiring::accumulate(
+            sums[k], Semiring::combine(v, static_cast<accT>(B_data[B_ridx]))
+        );
+
+        if (next[k] == -1) {
+            // keep a linked list, every element points to the next
+            // column index
+            next[k] = head;
+            head = k;
+            length++;
+        }
+    }
+}
+
+/**
+ * \brief Accumulate row `i` of A.dot(B) in `sums`.
+ *
+ * \details See `sp_matmul_accumulate` for the linked list of the columns
+ * that are set. The elements are converted to the accumulator type of
+ * `Semiring` before they are combined.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam Semiring the scoring operations, see `PlusTimes`
+ * \param[in] i the row of A
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in,out] next linked list of the columns set for the row
+ * \param[in,out] sums the accumulated values for the row
+ * \param[in,out] head the first column of the linked list
+ * \param[in,out] length the number of columns in the linked list
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    typename Semiring = PlusTimes<eT>,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_accumulate_row(
+    const idxT i,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    std::vector<idxT>& next,
+    std::vector<typename Semiring::value_type>& sums,
+    idxT& head,
+    idxT& length
+) {
+    using accT = typename Semiring::value_type;
+    // A_cidx: column index for A
+    ptrT A_cidx_start = A_indptr[i];
+    ptrT A_cidx_end = A_indptr[i + 1];
+    for (ptrT A_cidx = A_cidx_start; A_cidx < A_cidx_end; A_cidx++) {
+        // value of A in (i,j)
+        sp_matmul_accumulate<eT, idxT, ptrT, Semiring>(
+            static_cast<accT>(A_data[A_cidx]),
+            A_indices[A_cidx],
+            B_data,
+            B_indptr,
+            B_indices,
+            next,
+            sums,
+            head,
+            length
+        );
+    }
+}
+
+/**
+ * \brief Call `func(k, val)` for the columns in the linked list of
+ * `sp_matmul_accumulate` and reset `next` and `sums`.
+ *
+ * \details `val` is the finalised accumulated value of column `k`, the
+ * columns are visited in the order of the linked list.
+ *
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam Semiring the scoring operations, see `PlusTimes`
+ * \param[in] head the first column of the linked list
+ * \param[in] length the number of columns in the linked list
+ * \param[in,out] next linked list of the columns set for the row
+ * \param[in,out] sums the accumulated values for the row
+ * \param[in] func called with the column and its value
+ */
+template <typename idxT, typename Semiring, typename Func, iffInt<idxT> = true>
+inline void sp_matmul_drain(
+    idxT head,
+    const idxT length,
+    std::vector<idxT>& next,
+    std::vector<typename Semiring::value_type>& sums,
+    Func&& func
+) {
+    for (idxT jj = 0; jj < length; jj++) {
+        // length = number of columns set (may include 0s)
+        func(head, Semiring::finalize(sums[head]));
+
+        idxT temp = head;
+        // iterate over columns
+        head = next[head];
+
+        // clear arrays
+        next[temp] = -1;
+        sums[temp] = Semiring::zero();
+    }
+}
+
+/**
+ * \brief Retain the top n of the columns in the linked list of
+ * `sp_matmul_accumulate` in `max_heap`.
+ *
+ * \details The columns are ranked on `score(k, val)` where `val` is the
+ * finalised accumulated value of column `k`, e.g. to fuse it with another
+ * score. `next` and `sums` are reset, see `sp_matmul_drain`. The heap is
+ * reset before use and sorted on return, on insertion order, value or column
+ * index depending on `sort_order`.
+ *
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam sort_order the order of the retained values
+ * \tparam Semiring the scoring operations, see `PlusTimes`
+ * \param[in] head the first column of the linked list
+ * \param[in] length the number of columns in the linked list
+ * \param[in,out] next linked list of the columns set for the row
+ * \param[in,out] sums the accumulated values for the row
+ * \param[in,out] max_heap the heap to collect the top n values in
+ * \param[in] score maps the column and its value to the value it is ranked on
+ * \returns the number of values retained in the heap
+ */
+template <
+    typename idxT,
+    SortOrder sort_order,
+    typename Semiring,
+    typename Func,
+    iffInt<idxT> = true>
+inline idxT sp_matmul_topn_drain(
+    const idxT head,
+    const idxT length,
+    std::vector<idxT>& next,
+    std::vector<typename Semiring::value_type>& sums,
+    MaxHeap<typename Semiring::value_type, idxT>& max_heap,
+    Func&& score
+) {
+    using accT = typename Semiring::value_type;
+    accT min = max_heap.reset();
+    sp_matmul_drain<idxT, Semiring>(
+        head,
+        length,
+        next,
+        sums,
+        [&](const idxT k, const accT val) {
+            const accT s = score(k, val);
+            if (s > min) {
+                min = max_heap.push_pop(k, s);
+            }
+        }
+    );
+    max_heap.template sort<sort_order>();
+    return max_heap.get_n_set();
+}
+
+/**
+ * \brief Copy the rows stored in slots to exactly sized arrays of C in CSR
+ * format.
+ *
+ * \details Row `i` holds `row_nset[i]` elements starting at `slot_offset(i)`
+ * in `values` and `indices`, see `sp_matmul_topn_compact` for rows with
+ * `top_n` slots each.
+ *
+ * \tparam eT   element type of the slots
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] nrows the number of rows in C
+ * \param[in] values the values stored in the slots
+ * \param[in] indices the column indices stored in the slots
+ * \param[in] row_nset the number of elements stored for each row
+ * \param[in] slot_offset maps a row to the offset of its first slot
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    typename Func,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_compact(
+    const idxT nrows,
+    const eT* __restrict values,
+    const idxT* __restrict indices,
+    const idxT* __restrict row_nset,
+    Func&& slot_offset
+) {
+    auto C_indptr = std::unique_ptr<ptrT[]>(new ptrT[nrows + 1]);
+    C_indptr[0] = 0;
+    for (idxT i = 0; i < nrows; ++i) {
+        C_indptr[i + 1] = C_indptr[i] + row_nset[i];
+    }
+    const auto nnz = static_cast<size_t>(C_indptr[nrows]);
+    auto C_data = std::unique_ptr<eT[]>(new eT[nnz]);
+    auto C_indices = std::unique_ptr<idxT[]>(new idxT[nnz]);
+    for (idxT i = 0; i < nrows; ++i) {
+        const size_t offset = slot_offset(i);
+        std::copy_n(
+            indices + offset, row_nset[i], C_indices.get() + C_indptr[i]
+        );
+        std::copy_n(values + offset, row_nset[i], C_data.get() + C_indptr[i]);
+    }
+    return {nnz, C_data.release(), C_indices.release(), C_indptr.release()};
+}
+
+/**
+ * \brief Copy the rows stored in `top_n` slots per row to exactly sized
+ * arrays of C in CSR format, see `sp_matmul_compact`.
+ *
+ * \param[in] top_n the number of slots per row
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_compact(
+    const idxT top_n,
+    const idxT nrows,
+    const eT* __restrict values,
+    const idxT* __restrict indices,
+    const idxT* __restrict row_nset
+) {
+    // `nrows * top_n` can exceed the range of `idxT`
+    return sp_matmul_compact<eT, idxT, ptrT>(
+        nrows, values, indices, row_nset, [top_n](const idxT i) {
+            return static_cast<size_t>(i) * top_n;
+        }
+    );
+}
+
+/**
+ * \brief Compute row `i` of A.dot(B) and retain the top n values in `max_heap`.
+ *
+ * \details `next` and `sums` are the scratch arrays of length `ncols`, they
+ * must be initialised with -1 and 0 respectively and are reset on return.
+ * The heap is reset before use and sorted on return, on insertion order,
+ * value or column index depending on `sort_order`.
+ * The elements are converted to the accumulator type of `Semiring` before
+ * they are combined.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam Semiring the scoring operations, see `PlusTimes`
+ * \param[in] i the row of A
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in,out] next linked list of the columns set for the row
+ * \param[in,out] sums the accumulated values for the row
+ * \param[in,out] max_heap the heap to collect the top n values in
+ * \returns the number of values retained in the heap
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    typename Semiring = PlusTimes<eT>,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_row(
+    const idxT i,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    std::vector<idxT>& next,
+    std::vector<typename Semiring::value_type>& sums,
+    MaxHeap<typename Semiring::value_type, idxT>& max_heap
+) {
+    using accT = typename Semiring::value_type;
+    idxT head = -2;
+    idxT length = 0;
+    sp_matmul_accumulate_row<eT, idxT, ptrT, Semiring>(
+        i,
+        A_data,
+        A_indptr,
+        A_indices,
+        B_data,
+        B_indptr,
+        B_indices,
+        next,
+        sums,
+        head,
+        length
+    );
+    return sp_matmul_topn_drain<idxT, sort_order, Semiring>(
+        head,
+        length,
+        next,
+        sums,
+        max_heap,
+        [](const idxT, const accT val) { return val; }
+    );
+}
+
 /**
  * \brief Compute A.dot(B) keeping only the top n results.
  *
@@ -79,6 +462,11 @@ inline idxT sp_matmul_topn_size(
  *
  * \tparam eT   element type of the matrices
  * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam Semiring the scoring operations, see `PlusTimes`
+ * \tparam oT   element type of C, defaults to the accumulator type of
+ * `Semiring`
  * \param[in] top_n the top n values to store
  * \param[in] nrows the number of rows in A
  * \param[in] ncols the number of columns in B
@@ -94,88 +482,56 @@ inline idxT sp_matmul_topn_size(
  * \param[out] C_indptr array containing the row indices for `C_data`
  * \param[out] C_indices array containing the column indices
  */
-template <typename eT, typename idxT, bool insertion_sort, iffInt<idxT> = true>
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    typename Semiring = PlusTimes<eT>,
+    typename oT = typename Semiring::value_type,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
 inline void sp_matmul_topn(
     const idxT top_n,
     const idxT nrows,
     const idxT ncols,
-    const eT threshold,
+    const typename Semiring::value_type threshold,
     const eT* __restrict A_data,
-    const idxT* __restrict A_indptr,
+    const ptrT* __restrict A_indptr,
     const idxT* __restrict A_indices,
     const eT* __restrict B_data,
-    const idxT* __restrict B_indptr,
+    const ptrT* __restrict B_indptr,
     const idxT* __restrict B_indices,
-    std::vector<eT>& C_data,
-    std::vector<idxT>& C_indptr,
+    std::vector<oT>& C_data,
+    std::vector<ptrT>& C_indptr,
     std::vector<idxT>& C_indices
 ) {
+    using accT = typename Semiring::value_type;
     std::vector<idxT> next(ncols, -1);
-    std::vector<eT> sums(ncols, 0);
+    std::vector<accT> sums(ncols, Semiring::zero());
 
-    auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
-    idxT nnz = 0;
+    auto max_heap = MaxHeap<accT, idxT>(top_n, threshold);
+    ptrT nnz = 0;
 
     C_indptr[0] = 0;
 
     for (idxT i = 0; i < nrows; i++) {
-        idxT head = -2;
-        idxT length = 0;
-        eT min = max_heap.reset();
-
-        // A_cidx: column index for A
-        idxT A_cidx_start = A_indptr[i];
-        idxT A_cidx_end = A_indptr[i + 1];
-        for (idxT A_cidx = A_cidx_start; A_cidx < A_cidx_end; A_cidx++) {
-            idxT j = A_indices[A_cidx];
-            // value of A in (i,j)
-            eT v = A_data[A_cidx];
-
-            idxT B_ridx_start = B_indptr[j];
-            idxT B_ridx_end = B_indptr[j + 1];
-            for (idxT B_ridx = B_ridx_start; B_ridx < B_ridx_end; B_ridx++) {
-                idxT k = B_indices[B_ridx];  // kth column of B in row j
-
-                // multiply with value of B in (j,k) and accumulate to the
-                // result for kth column of row i
-                sums[k] += v * B_data[B_ridx];
-
-                if (next[k] == -1) {
-                    // keep a linked list, every element points to the next
-                    // column index
-                    next[k] = head;
-                    head = k;
-                    length++;
-                }
-            }
-        }
-
-        for (idxT jj = 0; jj < length; jj++) {
-            // length = number of columns set (may include 0s)
-            if (sums[head] > min) {
-                min = max_heap.push_pop(head, sums[head]);
-            }
-
-            idxT temp = head;
-            // iterate over columns
-            head = next[head];
-
-            // clear arrays
-            next[temp] = -1;
-            sums[temp] = 0;
-        }
-
-        if constexpr (insertion_sort) {
-            // sort the heap s.t. the original matrix order is maintained
-            max_heap.insertion_sort();
-        } else {
-            // sort the heap s.t. the first value is the largest
-            max_heap.value_sort();
-        }
-        int n_set = max_heap.get_n_set();
-        for (int ii = 0; ii < n_set; ++ii) {
+        idxT n_set
+            = sp_matmul_topn_row<eT, idxT, ptrT, sort_order, Semiring>(
+                i,
+                A_data,
+                A_indptr,
+                A_indices,
+                B_data,
+                B_indptr,
+                B_indices,
+                next,
+                sums,
+                max_heap
+            );
+        for (idxT ii = 0; ii < n_set; ++ii) {
             C_indices.push_back(max_heap.heap[ii].idx);
-            C_data.push_back(max_heap.heap[ii].val);
+            C_data.push_back(static_cast<oT>(max_heap.heap[ii].val));
         }
         nnz += n_set;
         C_indptr[i + 1] = nnz;
@@ -183,66 +539,6 @@ inline void sp_matmul_topn(
 }
 
 #if defined(SDTN_OMP_ENABLED)
-template <typename idxT, iffInt<idxT> = true>
-inline idxT sp_matmul_topn_size_mt(
-    const idxT top_n,
-    const idxT nrows,
-    const idxT* __restrict A_indptr,
-    const idxT* __restrict A_indices,
-    const idxT* __restrict B_indptr
-) {
-    idxT nnz = 0;
-#pragma omp parallel for default(none) \
-    shared(top_n, A_indptr, A_indices, B_indptr) reduction(+ : nnz)
-    for (idxT i = 0; i < nrows; i++) {
-        idxT row_nnz = 0;
-        idxT A_cidx_start = A_indptr[i];
-        idxT A_cidx_end = A_indptr[i + 1];
-        for (idxT A_cidx = A_cidx_start; A_cidx < A_cidx_end; ++A_cidx) {
-            idxT j = A_indices[A_cidx];
-            row_nnz += (B_indptr[j + 1] - B_indptr[j]);
-        }
-        nnz += std::min(top_n, row_nnz);
-    }
-    return nnz;
-}
-
-template <typename idxT, iffInt<idxT> = true>
-inline idxT sp_matmul_topn_size_mt(
-    const idxT top_n,
-    const idxT nrows,
-    const idxT ncols,
-    const idxT* __restrict A_indptr,
-    const idxT* __restrict A_indices,
-    const idxT* __restrict B_indptr,
-    const idxT* __restrict B_indices
-) {
-    idxT nnz = 0;
-#pragma omp parallel default(none) \
-    shared(top_n, nrows, ncols, A_indptr, A_indices, B_indptr)
-    {
-        std::vector<idxT> mask(ncols, -1);
-#pragma omp for reduction(+ : nnz)
-        for (idxT i = 0; i < nrows; i++) {
-            idxT row_nnz = 0;
-            idxT A_cidx_start = A_indptr[i];
-            idxT A_cidx_end = A_indptr[i + 1];
-            for (idxT A_cidx = A_cidx_start; A_cidx < A_cidx_end; ++A_cidx) {
-                idxT j = A_indices[A_cidx];
-                for (idxT kk = B_indptr[j]; kk < B_indptr[j + 1]; ++kk) {
-                    idxT k = B_indices[kk];
-                    if (mask[k] != i) {
-                        mask[k] = i;
-                        row_nnz++;
-                    }
-                }
-            }
-            nnz += std::min(top_n, row_nnz);
-        }
-    }
-    return nnz;
-}
-
 /**
  * \brief Compute A.dot(B) keeping only the top n results.
  *
@@ -261,6 +557,11 @@ inline idxT sp_matmul_topn_size_mt(
  *
  * \tparam eT   element type of the matrices
  * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam Semiring the scoring operations, see `PlusTimes`
+ * \tparam oT   element type of C, defaults to the accumulator type of
+ * `Semiring`
  * \param[in] top_n the top n values to store
  * \param[in] nrows the number of rows in A
  * \param[in] ncols the number of columns in B
@@ -276,22 +577,34 @@ inline idxT sp_matmul_topn_size_mt(
  * \param[out] C_indptr array containing the row indices for `C_data`
  * \param[out] C_indices array containing the column indices
  */
-template <typename eT, typename idxT, bool insertion_sort, iffInt<idxT> = true>
-inline std::tuple<size_t, eT*, idxT*, idxT*> sp_matmul_topn_mt(
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    typename Semiring = PlusTimes<eT>,
+    typename oT = typename Semiring::value_type,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, oT*, idxT*, ptrT*> sp_matmul_topn_mt(
     const idxT top_n,
     const idxT nrows,
     const idxT ncols,
-    const eT threshold,
+    const typename Semiring::value_type threshold,
     const int n_threads,
     const eT* __restrict A_data,
-    const idxT* __restrict A_indptr,
+    const ptrT* __restrict A_indptr,
     const idxT* __restrict A_indices,
     const eT* __restrict B_data,
-    const idxT* __restrict B_indptr,
+    const ptrT* __restrict B_indptr,
     const idxT* __restrict B_indices
 ) {
-    auto values = std::unique_ptr<eT[]>(new eT[nrows * top_n]);
-    auto indices = std::unique_ptr<idxT[]>(new idxT[nrows * top_n]);
+    using accT = typename Semiring::value_type;
+    // `nrows * top_n` can exceed the range of `idxT`
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    // the slots are stored in the output type to bound the peak memory
+    auto values = std::unique_ptr<oT[]>(new oT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
     auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
 #pragma omp parallel num_threads(n_threads) \
     shared(top_n,                           \
@@ -309,107 +622,40 @@ inline std::tuple<size_t, eT*, idxT*, idxT*> sp_matmul_topn_mt(
                row_nset)
     {
         std::vector<idxT> next(ncols, -1);
-        std::vector<eT> sums(ncols, 0);
+        std::vector<accT> sums(ncols, Semiring::zero());
 
-        auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+        auto max_heap = MaxHeap<accT, idxT>(top_n, threshold);
 
 #pragma omp for
         for (idxT i = 0; i < nrows; i++) {
-            idxT head = -2;
-            idxT length = 0;
-
-            idxT offset = i * top_n;
-            eT* local_vals = values.get() + offset;
+            size_t offset = static_cast<size_t>(i) * top_n;
+            oT* local_vals = values.get() + offset;
             idxT* local_idxs = indices.get() + offset;
 
-            eT min = max_heap.reset();
-
-            // A_cidx: column index for A
-            idxT A_cidx_start = A_indptr[i];
-            idxT A_cidx_end = A_indptr[i + 1];
-            for (idxT A_cidx = A_cidx_start; A_cidx < A_cidx_end; A_cidx++) {
-                idxT j = A_indices[A_cidx];
-                // value of A in (i,j)
-                eT v = A_data[A_cidx];
-
-                idxT B_ridx_start = B_indptr[j];
-                idxT B_ridx_end = B_indptr[j + 1];
-                for (idxT B_ridx = B_ridx_start; B_ridx < B_ridx_end;
-                     B_ridx++) {
-                    idxT k = B_indices[B_ridx];  // kth column of B in row j
-
-                    // multiply with value of B in (j,k) and accumulate to the
-                    // result for kth column of row i
-                    sums[k] += v * B_data[B_ridx];
-
-                    if (next[k] == -1) {
-                        // keep a linked list, every element points to the next
-                        // column index
-                        next[k] = head;
-                        head = k;
-                        length++;
-                    }
-                }
-            }
-
-            for (idxT jj = 0; jj < length; jj++) {
-                // length = number of columns set (may include 0s)
-                if (sums[head] > min) {
-                    min = max_heap.push_pop(head, sums[head]);
-                }
-
-                idxT temp = head;
-                // iterate over columns
-                head = next[head];
-
-                // clear arrays
-                next[temp] = -1;
-                sums[temp] = 0;
-            }
-
-            if constexpr (insertion_sort) {
-                // sort the heap s.t. the original matrix order is maintained
-                max_heap.insertion_sort();
-            } else {
-                // sort the heap s.t. the first value is the largest
-                max_heap.value_sort();
-            }
-            int n_set = max_heap.get_n_set();
-            for (int ii = 0; ii < n_set; ++ii) {
+            idxT n_set
+                = sp_matmul_topn_row<eT, idxT, ptrT, sort_order, Semiring>(
+                    i,
+                    A_data,
+                    A_indptr,
+                    A_indices,
+                    B_data,
+                    B_indptr,
+                    B_indices,
+                    next,
+                    sums,
+                    max_heap
+                );
+            for (idxT ii = 0; ii < n_set; ++ii) {
                 local_idxs[ii] = max_heap.heap[ii].idx;
-                local_vals[ii] = max_heap.heap[ii].val;
+                local_vals[ii] = static_cast<oT>(max_heap.heap[ii].val);
             }
             row_nset[i] = n_set;
         }
     }  // #pragma omp parallel
 
-    // check how many non-zero elements are in C
-    size_t total_nonzero
-        = std::accumulate(row_nset.get(), row_nset.get() + nrows, 0);
-    idxT* C_indptr = new idxT[nrows + 1];
-    C_indptr[0] = 0;
-    idxT* C_indices = new idxT[total_nonzero];
-    eT* C_data = new eT[total_nonzero];
-    // create ptr that will be shifted
-    idxT* C_idx_ptr = C_indices;
-    eT* C_data_ptr = C_data;
-
-    int nnz = 0;
-    idxT* idx_ptr = indices.get();
-    eT* vals_ptr = values.get();
-
-    for (int i = 0; i < nrows; ++i) {
-        idxT n_set = row_nset[i];
-        std::memcpy(C_idx_ptr, idx_ptr, n_set * sizeof(idxT));
-        std::memcpy(C_data_ptr, vals_ptr, n_set * sizeof(eT));
-        nnz += n_set;
-        C_indptr[i + 1] = nnz;
-        C_idx_ptr += n_set;
-        C_data_ptr += n_set;
-        idx_ptr += top_n;
-        vals_ptr += top_n;
-    }
-    return std::make_tuple(total_nonzero, C_data, C_indices, C_indptr);
+    return sp_matmul_topn_compact<oT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
 }  // sp_matmul_topn_mt
 #endif  // SDTN_OMP_ENABLED
 
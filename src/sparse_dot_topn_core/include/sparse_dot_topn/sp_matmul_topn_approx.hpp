@@ -0,0 +1,492 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief Finalizer of splitmix64, a cheap 64 bit mixing function.
+ */
+inline uint64_t mix_hash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * \brief Banded MinHash index over the rows of a CSR matrix.
+ *
+ * \details The MinHash signature of a row consists of `n_bands * band_size`
+ * minima of hashes of its column indices, the values are not used. The
+ * signature is split in `n_bands` bands of `band_size` minima which are
+ * hashed into a single key per band. Two rows with Jaccard similarity `s`
+ * of their column sets share at least one band key with probability
+ * `1 - (1 - s^band_size)^n_bands`, increasing `n_bands` increases the recall
+ * and increasing `band_size` reduces the number of dissimilar candidates.
+ *
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ */
+template <typename idxT, typename ptrT, iffInt<idxT> = true, iffInt<ptrT> = true>
+class LshIndex {
+    using Entry = std::pair<uint64_t, idxT>;
+    idxT n_bands;
+    idxT band_size;
+    uint64_t seed;
+    // per band the (key, row) pairs of the indexed rows sorted on key
+    std::vector<std::vector<Entry>> buckets;
+
+ public:
+    LshIndex(const idxT n_bands, const idxT band_size, const uint64_t seed)
+        : n_bands{n_bands},
+          band_size{band_size},
+          seed{mix_hash(seed)},
+          buckets(n_bands) {}
+
+    [[nodiscard]] idxT get_n_bands() const { return n_bands; }
+
+    /**
+     * \brief Compute the band keys of row `i`.
+     *
+     * \param[in] i the row
+     * \param[in] indptr array containing the row indices
+     * \param[in] indices array containing the column indices
+     * \param[in,out] sig scratch array of size `n_bands * band_size`
+     * \param[out] keys array of size `n_bands`
+     * \returns false if the row is empty, the keys are not set in that case
+     */
+    bool band_keys(
+        const idxT i,
+        const ptrT* __restrict indptr,
+        const idxT* __restrict indices,
+        std::vector<uint64_t>& sig,
+        uint64_t* __restrict keys
+    ) const {
+        if (indptr[i] == indptr[i + 1]) {
+            return false;
+        }
+        std::fill(sig.begin(), sig.end(), std::numeric_limits<uint64_t>::max());
+        const size_t n_hashes = sig.size();
+        for (ptrT k = indptr[i]; k < indptr[i + 1]; ++k) {
+            const uint64_t base
+                = mix_hash(static_cast<uint64_t>(indices[k]) ^ seed);
+            for (size_t h = 0; h < n_hashes; ++h) {
+                sig[h] = std::min(
+                    sig[h], mix_hash(base + (h + 1) * 0x9e3779b97f4a7c15ULL)
+                );
+            }
+        }
+        for (idxT b = 0; b < n_bands; ++b) {
+            uint64_t key = static_cast<uint64_t>(b);
+            const size_t start = static_cast<size_t>(b) * band_size;
+            for (idxT r = 0; r < band_size; ++r) {
+                key = mix_hash(key + sig[start + r]);
+            }
+            keys[b] = key;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Index the rows of M.
+     *
+     * \param[in] nrows the number of rows in M
+     * \param[in] indptr array containing the row indices of M
+     * \param[in] indices array containing the column indices of M
+     */
+    void build(
+        const idxT nrows,
+        const ptrT* __restrict indptr,
+        const idxT* __restrict indices
+    ) {
+        std::vector<uint64_t> sig(static_cast<size_t>(n_bands) * band_size);
+        std::vector<uint64_t> keys(n_bands);
+        for (idxT i = 0; i < nrows; ++i) {
+            if (band_keys(i, indptr, indices, sig, keys.data())) {
+                for (idxT b = 0; b < n_bands; ++b) {
+                    buckets[b].emplace_back(keys[b], i);
+                }
+            }
+        }
+        for (auto& band : buckets) {
+            std::sort(band.begin(), band.end());
+        }
+    }
+
+#if defined(SDTN_OMP_ENABLED)
+    /**
+     * \brief Index the rows of M using `n_threads`.
+     *
+     * \param[in] n_threads the number of threads to use
+     * \param[in] nrows the number of rows in M
+     * \param[in] indptr array containing the row indices of M
+     * \param[in] indices array containing the column indices of M
+     */
+    void build_mt(
+        const int n_threads,
+        const idxT nrows,
+        const ptrT* __restrict indptr,
+        const idxT* __restrict indices
+    ) {
+        // the keys are stored per row such that empty rows can be skipped
+        // when the buckets are filled
+        auto keys = std::unique_ptr<uint64_t[]>(
+            new uint64_t[static_cast<size_t>(nrows) * n_bands]
+        );
+        auto is_set = std::unique_ptr<bool[]>(new bool[nrows]);
+#pragma omp parallel num_threads(n_threads)
+        {
+            std::vector<uint64_t> sig(static_cast<size_t>(n_bands) * band_size);
+#pragma omp for schedule(dynamic, 256)
+            for (idxT i = 0; i < nrows; ++i) {
+                is_set[i] = band_keys(
+                    i,
+                    indptr,
+                    indices,
+                    sig,
+                    keys.get() + static_cast<size_t>(i) * n_bands
+                );
+            }
+#pragma omp for schedule(dynamic, 1)
+            for (idxT b = 0; b < n_bands; ++b) {
+                auto& band = buckets[b];
+                for (idxT i = 0; i < nrows; ++i) {
+                    if (is_set[i]) {
+                        band.emplace_back(
+                            keys[static_cast<size_t>(i) * n_bands + b], i
+                        );
+                    }
+                }
+                std::sort(band.begin(), band.end());
+            }
+        }
+    }
+#endif  // SDTN_OMP_ENABLED
+
+    /**
+     * \brief Call `func` with the indexed rows sharing a band key in `keys`.
+     *
+     * \details A row is passed once for every band it shares with `keys`.
+     */
+    template <typename Func>
+    void for_each_candidate(
+        const uint64_t* __restrict keys,
+        Func&& func
+    ) const {
+        for (idxT b = 0; b < n_bands; ++b) {
+            const auto& band = buckets[b];
+            auto it = std::lower_bound(
+                band.begin(),
+                band.end(),
+                Entry{keys[b], std::numeric_limits<idxT>::min()}
+            );
+            for (; it != band.end() && it->first == keys[b]; ++it) {
+                func(it->second);
+            }
+        }
+    }
+};
+
+/**
+ * \brief Score the LSH candidates of row `i` of A exactly and collect the top
+ * n in `max_heap`.
+ *
+ * \details `dense`, `seen` are scratch arrays of length `A_ncols` and `ncols`
+ * initialised with 0 and -1 respectively, `dense` is reset on return.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] i the row of A
+ * \param[in] index the LSH index over the rows of B.T
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] Bt_data the nonzero elements of B.T
+ * \param[in] Bt_indptr array containing the row indices for `Bt_data`
+ * \param[in] Bt_indices array containing the column indices
+ * \param[in,out] sig scratch array for the MinHash signature
+ * \param[in,out] keys scratch array for the band keys
+ * \param[in,out] dense row `i` of A as dense vector
+ * \param[in,out] seen the last row of A a candidate was scored for
+ * \param[in,out] max_heap the heap to collect the top n values in
+ * \returns the number of values retained in the heap
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_approx_row(
+    const idxT i,
+    const LshIndex<idxT, ptrT>& index,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict Bt_data,
+    const ptrT* __restrict Bt_indptr,
+    const idxT* __restrict Bt_indices,
+    std::vector<uint64_t>& sig,
+    std::vector<uint64_t>& keys,
+    std::vector<eT>& dense,
+    std::vector<idxT>& seen,
+    MaxHeap<eT, idxT>& max_heap
+) {
+    eT min = max_heap.reset();
+    if (!index.band_keys(i, A_indptr, A_indices, sig, keys.data())) {
+        return 0;
+    }
+    for (ptrT k = A_indptr[i]; k < A_indptr[i + 1]; ++k) {
+        dense[A_indices[k]] += A_data[k];
+    }
+    index.for_each_candidate(keys.data(), [&](const idxT j) {
+        if (seen[j] == i) {
+            return;
+        }
+        seen[j] = i;
+        eT val = 0;
+        for (ptrT k = Bt_indptr[j]; k < Bt_indptr[j + 1]; ++k) {
+            val += dense[Bt_indices[k]] * Bt_data[k];
+        }
+        if (val > min) {
+            min = max_heap.push_pop(j, val);
+        }
+    });
+    for (ptrT k = A_indptr[i]; k < A_indptr[i + 1]; ++k) {
+        dense[A_indices[k]] = 0;
+    }
+
+    max_heap.template sort<sort_order>();
+    return max_heap.get_n_set();
+}
+
+/**
+ * \brief Compute the top n results of A.dot(B) approximately.
+ *
+ * \details Rather than computing the full product only the pairs of rows of
+ * A and columns of B that share a band of their MinHash signatures are
+ * scored, see `LshIndex`. The candidates are scored exactly, C therefore
+ * only contains values of A.dot(B) but can miss pairs that have not been
+ * generated as candidate. B is passed transposed, i.e. as B.T in CSR format,
+ * such that a candidate can be scored with a single pass over its row.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] A_ncols the number of columns in A
+ * \param[in] threshold minimum values required to store
+ * \param[in] n_bands the number of LSH bands
+ * \param[in] band_size the number of MinHash values per band
+ * \param[in] seed the seed of the hash functions
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] Bt_data the nonzero elements of B.T
+ * \param[in] Bt_indptr array containing the row indices for `Bt_data`
+ * \param[in] Bt_indices array containing the column indices
+ * \param[out] C_data the nonzero elements of C
+ * \param[out] C_indptr array containing the row indices for `C_data`
+ * \param[out] C_indices array containing the column indices
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_topn_approx(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const idxT A_ncols,
+    const eT threshold,
+    const idxT n_bands,
+    const idxT band_size,
+    const uint64_t seed,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict Bt_data,
+    const ptrT* __restrict Bt_indptr,
+    const idxT* __restrict Bt_indices,
+    std::vector<eT>& C_data,
+    std::vector<ptrT>& C_indptr,
+    std::vector<idxT>& C_indices
+) {
+    auto index = LshIndex<idxT, ptrT>(n_bands, band_size, seed);
+    index.build(ncols, Bt_indptr, Bt_indices);
+
+    std::vector<uint64_t> sig(static_cast<size_t>(n_bands) * band_size);
+    std::vector<uint64_t> keys(n_bands);
+    std::vector<eT> dense(A_ncols, 0);
+    std::vector<idxT> seen(ncols, -1);
+    auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+    ptrT nnz = 0;
+
+    C_indptr[0] = 0;
+    for (idxT i = 0; i < nrows; ++i) {
+        idxT n_set = sp_matmul_topn_approx_row<eT, idxT, ptrT, sort_order>(
+            i,
+            index,
+            A_data,
+            A_indptr,
+            A_indices,
+            Bt_data,
+            Bt_indptr,
+            Bt_indices,
+            sig,
+            keys,
+            dense,
+            seen,
+            max_heap
+        );
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            C_indices.push_back(max_heap.heap[ii].idx);
+            C_data.push_back(max_heap.heap[ii].val);
+        }
+        nnz += n_set;
+        C_indptr[i + 1] = nnz;
+    }
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute the top n results of A.dot(B) approximately using
+ * `n_threads`.
+ *
+ * \details See `sp_matmul_topn_approx`, both the signatures and the scoring
+ * of the candidates are computed in parallel.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] A_ncols the number of columns in A
+ * \param[in] threshold minimum values required to store
+ * \param[in] n_bands the number of LSH bands
+ * \param[in] band_size the number of MinHash values per band
+ * \param[in] seed the seed of the hash functions
+ * \param[in] n_threads number of threads to use
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] Bt_data the nonzero elements of B.T
+ * \param[in] Bt_indptr array containing the row indices for `Bt_data`
+ * \param[in] Bt_indices array containing the column indices
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_approx_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const idxT A_ncols,
+    const eT threshold,
+    const idxT n_bands,
+    const idxT band_size,
+    const uint64_t seed,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict Bt_data,
+    const ptrT* __restrict Bt_indptr,
+    const idxT* __restrict Bt_indices
+) {
+    auto index = LshIndex<idxT, ptrT>(n_bands, band_size, seed);
+    index.build_mt(n_threads, ncols, Bt_indptr, Bt_indices);
+
+    // `nrows * top_n` can exceed the range of `idxT`
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+#pragma omp parallel num_threads(n_threads)
+    {
+        std::vector<uint64_t> sig(static_cast<size_t>(n_bands) * band_size);
+        std::vector<uint64_t> keys(n_bands);
+        std::vector<eT> dense(A_ncols, 0);
+        std::vector<idxT> seen(ncols, -1);
+        auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+#pragma omp for schedule(dynamic, 64)
+        for (idxT i = 0; i < nrows; ++i) {
+            const size_t offset = static_cast<size_t>(i) * top_n;
+            idxT n_set = sp_matmul_topn_approx_row<eT, idxT, ptrT, sort_order>(
+                i,
+                index,
+                A_data,
+                A_indptr,
+                A_indices,
+                Bt_data,
+                Bt_indptr,
+                Bt_indices,
+                sig,
+                keys,
+                dense,
+                seen,
+                max_heap
+            );
+            for (idxT ii = 0; ii < n_set; ++ii) {
+                indices[offset + ii] = max_heap.heap[ii].idx;
+                values[offset + ii] = max_heap.heap[ii].val;
+            }
+            row_nset[i] = n_set;
+        }
+    }  // #pragma omp parallel
+
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}  // sp_matmul_topn_approx_mt
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -24,7 +24,7 @@
 #include <utility>
 #include <vector>
 
-#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/common_bindings.hpp>
 #include <sparse_dot_topn/sp_matmul_topn.hpp>
 
 namespace sdtn {
@@ -36,44 +36,43 @@ namespace api {
 template <
     typename eT,
     typename idxT,
-    bool insertion_sort,
-    core::iffInt<idxT> = true>
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
 inline nb::tuple sp_matmul_topn(
     const idxT top_n,
     const idxT nrows,
     const idxT ncols,
     std::optional<eT> threshold,
-    const double density,
+    std::optional<double> density,
     const nb_vec<eT>& A_data,
-    const nb_vec<idxT>& A_indptr,
+    const nb_vec<ptrT>& A_indptr,
     const nb_vec<idxT>& A_indices,
     const nb_vec<eT>& B_data,
-    const nb_vec<idxT>& B_indptr,
+    const nb_vec<ptrT>& B_indptr,
     const nb_vec<idxT>& B_indices
 ) {
-    idxT result_size;
-    eT local_threshold;
-    if (threshold.has_value()) {
-        result_size = static_cast<idxT>(ceil(density * top_n * nrows));
-        local_threshold = threshold.value();
+    // without an expected density C is sized using an upper bound that only
+    // requires the index pointer of B, rather than a symbolic pass over A * B,
+    // the excess capacity is released after the product has been computed
+    size_t result_size;
+    if (density.has_value()) {
+        result_size = static_cast<size_t>(
+            ceil(density.value() * static_cast<double>(top_n) * nrows)
+        );
     } else {
         result_size = core::sp_matmul_topn_size(
-            top_n,
-            nrows,
-            ncols,
-            A_indptr.data(),
-            A_indices.data(),
-            B_indptr.data(),
-            B_indices.data()
+            top_n, nrows, A_indptr.data(), A_indices.data(), B_indptr.data()
         );
-        local_threshold = std::numeric_limits<eT>::min();
     }
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
     std::vector<eT> C_data;
     C_data.reserve(result_size);
     std::vector<idxT> C_indices;
     C_indices.reserve(result_size);
-    std::vector<idxT> C_indptr(nrows + 1);
-    core::sp_matmul_topn<eT, idxT, insertion_sort>(
+    std::vector<ptrT> C_indptr(nrows + 1);
+    core::sp_matmul_topn<eT, idxT, ptrT, sort_order>(
         top_n,
         nrows,
         ncols,
@@ -88,10 +87,12 @@ inline nb::tuple sp_matmul_topn(
         C_indptr,
         C_indices
     );
+    C_data.shrink_to_fit();
+    C_indices.shrink_to_fit();
     return nb::make_tuple(
         to_nbvec<eT>(std::move(C_data)),
         to_nbvec<idxT>(std::move(C_indices)),
-        to_nbvec<idxT>(std::move(C_indptr))
+        to_nbvec<ptrT>(std::move(C_indptr))
     );
 }
 
@@ -99,8 +100,10 @@ inline nb::tuple sp_matmul_topn(
 template <
     typename eT,
     typename idxT,
-    bool insertion_sort,
-    core::iffInt<idxT> = true>
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
 inline nb::tuple sp_matmul_topn_mt(
     const idxT top_n,
     const idxT nrows,
@@ -108,15 +111,15 @@ inline nb::tuple sp_matmul_topn_mt(
     std::optional<eT> threshold,
     const int n_threads,
     const nb_vec<eT>& A_data,
-    const nb_vec<idxT>& A_indptr,
+    const nb_vec<ptrT>& A_indptr,
     const nb_vec<idxT>& A_indices,
     const nb_vec<eT>& B_data,
-    const nb_vec<idxT>& B_indptr,
+    const nb_vec<ptrT>& B_indptr,
     const nb_vec<idxT>& B_indices
 ) {
     eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
     auto [total_nonzero, C_data, C_indices, C_indptr]
-        = core::sp_matmul_topn_mt<eT, idxT, insertion_sort>(
+        = core::sp_matmul_topn_mt<eT, idxT, ptrT, sort_order>(
             top_n,
             nrows,
             ncols,
@@ -132,7 +135,7 @@ inline nb::tuple sp_matmul_topn_mt(
     return nb::make_tuple(
         to_nbvec<eT>(C_data, total_nonzero),
         to_nbvec<idxT>(C_indices, total_nonzero),
-        to_nbvec<idxT>(C_indptr, nrows + 1)
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
     );
 }
 #endif  // SDTN_OMP_ENABLED
@@ -143,9 +146,11 @@ namespace bindings {
 
 void bind_sp_matmul_topn(nb::module_& m);
 void bind_sp_matmul_topn_sorted(nb::module_& m);
+void bind_sp_matmul_topn_canonical(nb::module_& m);
 #ifdef SDTN_OMP_ENABLED
 void bind_sp_matmul_topn_mt(nb::module_& m);
 void bind_sp_matmul_topn_sorted_mt(nb::module_& m);
+void bind_sp_matmul_topn_canonical_mt(nb::module_& m);
 #endif  // SDTN_OMP_ENABLED
 }  // namespace bindings
 }  // namespace sdtn
@@ -0,0 +1,334 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief The scratch space of a single thread for the chained product.
+ *
+ * \details The intermediate row of A.dot(B) only lives in `inter_heap`, the
+ * arrays are reset after each row.
+ */
+template <typename eT, typename idxT>
+struct ChainBuffers {
+    std::vector<idxT> inter_next;
+    std::vector<eT> inter_sums;
+    MaxHeap<eT, idxT> inter_heap;
+    std::vector<idxT> next;
+    std::vector<eT> sums;
+    MaxHeap<eT, idxT> max_heap;
+
+    ChainBuffers(
+        const idxT top_n,
+        const idxT ncols,
+        const eT threshold,
+        const idxT inter_top_n,
+        const idxT inter_ncols,
+        const eT inter_threshold
+    )
+        : inter_next(inter_ncols, -1),
+          inter_sums(inter_ncols, 0),
+          inter_heap(inter_top_n, inter_threshold),
+          next(ncols, -1),
+          sums(ncols, 0),
+          max_heap(top_n, threshold) {}
+};
+
+/**
+ * \brief Compute row `i` of A.dot(B).dot(C) where the intermediate row of
+ * A.dot(B) is pruned to its top n, and retain the top n values in
+ * `buf.max_heap`.
+ *
+ * \details The intermediate row is sorted on column index before it is
+ * multiplied with C such that the rows of C are visited in order.
+ *
+ * \returns the number of values retained in `buf.max_heap`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_chain_row(
+    const idxT i,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const eT* __restrict C_data,
+    const ptrT* __restrict C_indptr,
+    const idxT* __restrict C_indices,
+    ChainBuffers<eT, idxT>& buf
+) {
+    const idxT n_inter = sp_matmul_topn_row<eT, idxT, ptrT, SortOrder::index>(
+        i,
+        A_data,
+        A_indptr,
+        A_indices,
+        B_data,
+        B_indptr,
+        B_indices,
+        buf.inter_next,
+        buf.inter_sums,
+        buf.inter_heap
+    );
+
+    idxT head = -2;
+    idxT length = 0;
+    for (idxT jj = 0; jj < n_inter; ++jj) {
+        sp_matmul_accumulate<eT, idxT, ptrT>(
+            buf.inter_heap.heap[jj].val,
+            buf.inter_heap.heap[jj].idx,
+            C_data,
+            C_indptr,
+            C_indices,
+            buf.next,
+            buf.sums,
+            head,
+            length
+        );
+    }
+    return sp_matmul_topn_drain<idxT, sort_order, PlusTimes<eT>>(
+        head,
+        length,
+        buf.next,
+        buf.sums,
+        buf.max_heap,
+        [](const idxT, const eT val) { return val; }
+    );
+}
+
+/**
+ * \brief Compute A.dot(B).dot(C) keeping only the top n results, the rows of
+ * the intermediate product A.dot(B) are pruned to their top n.
+ *
+ * \details The intermediate product is never materialised, each row is
+ * computed, pruned and multiplied with C before the next row is started.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in C
+ * \param[in] threshold minimum values required to store
+ * \param[in] inter_top_n the top n values to retain of the rows of A.dot(B)
+ * \param[in] inter_ncols the number of columns in B
+ * \param[in] inter_threshold minimum values required to retain in A.dot(B)
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in] C_data the nonzero elements of C
+ * \param[in] C_indptr array containing the row indices for `C_data`
+ * \param[in] C_indices array containing the column indices
+ * \param[out] Z_data the nonzero elements of the result
+ * \param[out] Z_indptr array containing the row indices for `Z_data`
+ * \param[out] Z_indices array containing the column indices
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_topn_chain(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const idxT inter_top_n,
+    const idxT inter_ncols,
+    const eT inter_threshold,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const eT* __restrict C_data,
+    const ptrT* __restrict C_indptr,
+    const idxT* __restrict C_indices,
+    std::vector<eT>& Z_data,
+    std::vector<ptrT>& Z_indptr,
+    std::vector<idxT>& Z_indices
+) {
+    auto buf = ChainBuffers<eT, idxT>(
+        top_n, ncols, threshold, inter_top_n, inter_ncols, inter_threshold
+    );
+    ptrT nnz = 0;
+    Z_indptr[0] = 0;
+
+    for (idxT i = 0; i < nrows; ++i) {
+        idxT n_set = sp_matmul_topn_chain_row<eT, idxT, ptrT, sort_order>(
+            i,
+            A_data,
+            A_indptr,
+            A_indices,
+            B_data,
+            B_indptr,
+            B_indices,
+            C_data,
+            C_indptr,
+            C_indices,
+            buf
+        );
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            Z_indices.push_back(buf.max_heap.heap[ii].idx);
+            Z_data.push_back(buf.max_heap.heap[ii].val);
+        }
+        nnz += n_set;
+        Z_indptr[i + 1] = nnz;
+    }
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute A.dot(B).dot(C) keeping only the top n results using
+ * `n_threads`, the rows of the intermediate product A.dot(B) are pruned to
+ * their top n.
+ *
+ * \details Every thread holds a single intermediate row at a time.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in C
+ * \param[in] threshold minimum values required to store
+ * \param[in] inter_top_n the top n values to retain of the rows of A.dot(B)
+ * \param[in] inter_ncols the number of columns in B
+ * \param[in] inter_threshold minimum values required to retain in A.dot(B)
+ * \param[in] n_threads number of threads to use
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in] C_data the nonzero elements of C
+ * \param[in] C_indptr array containing the row indices for `C_data`
+ * \param[in] C_indices array containing the column indices
+ * \returns tuple of the number of nonzero elements, Z_data, Z_indices and
+ * Z_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_chain_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const idxT inter_top_n,
+    const idxT inter_ncols,
+    const eT inter_threshold,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const eT* __restrict C_data,
+    const ptrT* __restrict C_indptr,
+    const idxT* __restrict C_indices
+) {
+    // `nrows * top_n` can exceed the range of `idxT`
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+#pragma omp parallel num_threads(n_threads) \
+    shared(top_n,                           \
+               nrows,                       \
+               ncols,                       \
+               threshold,                   \
+               inter_top_n,                 \
+               inter_ncols,                 \
+               inter_threshold,             \
+               A_data,                      \
+               A_indptr,                    \
+               A_indices,                   \
+               B_data,                      \
+               B_indptr,                    \
+               B_indices,                   \
+               C_data,                      \
+               C_indptr,                    \
+               C_indices,                   \
+               values,                      \
+               indices,                     \
+               row_nset)
+    {
+        auto buf = ChainBuffers<eT, idxT>(
+            top_n, ncols, threshold, inter_top_n, inter_ncols, inter_threshold
+        );
+
+#pragma omp for
+        for (idxT i = 0; i < nrows; ++i) {
+            const size_t offset = static_cast<size_t>(i) * top_n;
+            idxT n_set = sp_matmul_topn_chain_row<eT, idxT, ptrT, sort_order>(
+                i,
+                A_data,
+                A_indptr,
+                A_indices,
+                B_data,
+                B_indptr,
+                B_indices,
+                C_data,
+                C_indptr,
+                C_indices,
+                buf
+            );
+            for (idxT ii = 0; ii < n_set; ++ii) {
+                indices[offset + ii] = buf.max_heap.heap[ii].idx;
+                values[offset + ii] = buf.max_heap.heap[ii].val;
+            }
+            row_nset[i] = n_set;
+        }
+    }  // #pragma omp parallel
+
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}  // sp_matmul_topn_chain_mt
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
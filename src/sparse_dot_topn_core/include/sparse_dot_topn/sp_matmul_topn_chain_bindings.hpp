@@ -0,0 +1,168 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_chain.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_chain(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const idxT intermediate_top_n,
+    const idxT intermediate_ncols,
+    std::optional<eT> intermediate_threshold,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices,
+    const nb_vec<eT>& C_data,
+    const nb_vec<ptrT>& C_indptr,
+    const nb_vec<idxT>& C_indices
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    eT local_inter_threshold
+        = intermediate_threshold.value_or(std::numeric_limits<eT>::min());
+    // the size of Z can not be bounded without the intermediate product, the
+    // arrays grow as needed
+    std::vector<eT> Z_data;
+    std::vector<idxT> Z_indices;
+    std::vector<ptrT> Z_indptr(nrows + 1);
+    core::sp_matmul_topn_chain<eT, idxT, ptrT, sort_order>(
+        top_n,
+        nrows,
+        ncols,
+        local_threshold,
+        intermediate_top_n,
+        intermediate_ncols,
+        local_inter_threshold,
+        A_data.data(),
+        A_indptr.data(),
+        A_indices.data(),
+        B_data.data(),
+        B_indptr.data(),
+        B_indices.data(),
+        C_data.data(),
+        C_indptr.data(),
+        C_indices.data(),
+        Z_data,
+        Z_indptr,
+        Z_indices
+    );
+    Z_data.shrink_to_fit();
+    Z_indices.shrink_to_fit();
+    return nb::make_tuple(
+        to_nbvec<eT>(std::move(Z_data)),
+        to_nbvec<idxT>(std::move(Z_indices)),
+        to_nbvec<ptrT>(std::move(Z_indptr))
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_chain_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const idxT intermediate_top_n,
+    const idxT intermediate_ncols,
+    std::optional<eT> intermediate_threshold,
+    const int n_threads,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices,
+    const nb_vec<eT>& C_data,
+    const nb_vec<ptrT>& C_indptr,
+    const nb_vec<idxT>& C_indices
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    eT local_inter_threshold
+        = intermediate_threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, Z_data, Z_indices, Z_indptr]
+        = core::sp_matmul_topn_chain_mt<eT, idxT, ptrT, sort_order>(
+            top_n,
+            nrows,
+            ncols,
+            local_threshold,
+            intermediate_top_n,
+            intermediate_ncols,
+            local_inter_threshold,
+            n_threads,
+            A_data.data(),
+            A_indptr.data(),
+            A_indices.data(),
+            B_data.data(),
+            B_indptr.data(),
+            B_indices.data(),
+            C_data.data(),
+            C_indptr.data(),
+            C_indices.data()
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(Z_data, total_nonzero),
+        to_nbvec<idxT>(Z_indices, total_nonzero),
+        to_nbvec<ptrT>(Z_indptr, nrows + 1)
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_topn_chain(nb::module_& m);
+void bind_sp_matmul_topn_chain_sorted(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_chain_mt(nb::module_& m);
+void bind_sp_matmul_topn_chain_sorted_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
@@ -0,0 +1,295 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if defined(SDTN_OMP_ENABLED)
+#include <omp.h>
+#endif  // SDTN_OMP_ENABLED
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief Lock-free disjoint set of the integers [0, n).
+ *
+ * \details The larger root is always linked under the smaller root such that
+ * the root of a set is its smallest element, independent of the order in
+ * which the sets are united. `find` halves the path with compare-and-swap,
+ * `unite` retries the link when another thread changed the root.
+ *
+ * \tparam idxT integer type of the elements, must be at least 32 bit int
+ */
+template <typename idxT, iffInt<idxT> = true>
+class UnionFind {
+    std::unique_ptr<std::atomic<idxT>[]> parent;
+    idxT n;
+
+ public:
+    explicit UnionFind(const idxT n)
+        : parent{std::make_unique<std::atomic<idxT>[]>(n)}, n{n} {
+        for (idxT i = 0; i < n; ++i) {
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    idxT find(idxT x) {
+        while (true) {
+            idxT p = parent[x].load(std::memory_order_acquire);
+            if (p == x) {
+                return x;
+            }
+            const idxT gp = parent[p].load(std::memory_order_acquire);
+            if (p != gp) {
+                parent[x].compare_exchange_weak(
+                    p, gp, std::memory_order_acq_rel
+                );
+            }
+            x = gp;
+        }
+    }
+
+    void unite(idxT a, idxT b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return;
+            }
+            if (a > b) {
+                std::swap(a, b);
+            }
+            idxT expected = b;
+            if (parent[b].compare_exchange_strong(
+                    expected, a, std::memory_order_acq_rel
+                )) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * \brief Label the sets 0, 1, ... in the order of their smallest element.
+     *
+     * \returns the number of sets
+     */
+    idxT labels(idxT* __restrict labels) {
+        idxT n_sets = 0;
+        for (idxT i = 0; i < n; ++i) {
+            const idxT root = find(i);
+            labels[i] = root == i ? n_sets++ : labels[root];
+        }
+        return n_sets;
+    }
+};
+
+/**
+ * \brief Compute the connected components of the top n of A.dot(B) without
+ * storing the product.
+ *
+ * \details The retained elements of each row are united with their row as
+ * soon as the row has been computed, the graph is treated as undirected.
+ * The elements are only stored when `with_edges` is set.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A, equal to the number of columns
+ * in B
+ * \param[in] threshold minimum values required to connect two nodes
+ * \param[in] with_edges store the retained elements in `E_*`
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[out] labels the component of each node, of length `nrows`
+ * \param[out] E_data the retained elements
+ * \param[out] E_rows the row indices of the retained elements
+ * \param[out] E_cols the column indices of the retained elements
+ * \returns the number of components
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_components(
+    const idxT top_n,
+    const idxT nrows,
+    const eT threshold,
+    const bool with_edges,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    idxT* __restrict labels,
+    std::vector<eT>& E_data,
+    std::vector<idxT>& E_rows,
+    std::vector<idxT>& E_cols
+) {
+    auto components = UnionFind<idxT>(nrows);
+    std::vector<idxT> next(nrows, -1);
+    std::vector<eT> sums(nrows, 0);
+    auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+    for (idxT i = 0; i < nrows; ++i) {
+        idxT n_set
+            = sp_matmul_topn_row<eT, idxT, ptrT, SortOrder::insertion>(
+                i,
+                A_data,
+                A_indptr,
+                A_indices,
+                B_data,
+                B_indptr,
+                B_indices,
+                next,
+                sums,
+                max_heap
+            );
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            components.unite(i, max_heap.heap[ii].idx);
+            if (with_edges) {
+                E_data.push_back(max_heap.heap[ii].val);
+                E_rows.push_back(i);
+                E_cols.push_back(max_heap.heap[ii].idx);
+            }
+        }
+    }
+    return components.labels(labels);
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute the connected components of the top n of A.dot(B) without
+ * storing the product using `n_threads`.
+ *
+ * \details The threads unite the retained elements of their rows in a shared
+ * lock-free `UnionFind`, the labels do not depend on the number of threads.
+ * The edges of each thread are concatenated in thread order.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A, equal to the number of columns
+ * in B
+ * \param[in] threshold minimum values required to connect two nodes
+ * \param[in] with_edges store the retained elements in `E_*`
+ * \param[in] n_threads number of threads to use
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[out] labels the component of each node, of length `nrows`
+ * \param[out] E_data the retained elements
+ * \param[out] E_rows the row indices of the retained elements
+ * \param[out] E_cols the column indices of the retained elements
+ * \returns the number of components
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_components_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const eT threshold,
+    const bool with_edges,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    idxT* __restrict labels,
+    std::vector<eT>& E_data,
+    std::vector<idxT>& E_rows,
+    std::vector<idxT>& E_cols
+) {
+    auto components = UnionFind<idxT>(nrows);
+    std::vector<std::vector<eT>> local_data(n_threads);
+    std::vector<std::vector<idxT>> local_rows(n_threads);
+    std::vector<std::vector<idxT>> local_cols(n_threads);
+
+#pragma omp parallel num_threads(n_threads)
+    {
+        const int tid = omp_get_thread_num();
+        std::vector<idxT> next(nrows, -1);
+        std::vector<eT> sums(nrows, 0);
+        auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+#pragma omp for schedule(dynamic, 64)
+        for (idxT i = 0; i < nrows; ++i) {
+            idxT n_set
+                = sp_matmul_topn_row<eT, idxT, ptrT, SortOrder::insertion>(
+                    i,
+                    A_data,
+                    A_indptr,
+                    A_indices,
+                    B_data,
+                    B_indptr,
+                    B_indices,
+                    next,
+                    sums,
+                    max_heap
+                );
+            for (idxT ii = 0; ii < n_set; ++ii) {
+                components.unite(i, max_heap.heap[ii].idx);
+                if (with_edges) {
+                    local_data[tid].push_back(max_heap.heap[ii].val);
+                    local_rows[tid].push_back(i);
+                    local_cols[tid].push_back(max_heap.heap[ii].idx);
+                }
+            }
+        }
+    }  // #pragma omp parallel
+
+    if (with_edges) {
+        for (int t = 0; t < n_threads; ++t) {
+            const auto& data = local_data[t];
+            const auto& rows = local_rows[t];
+            const auto& cols = local_cols[t];
+            E_data.insert(E_data.end(), data.begin(), data.end());
+            E_rows.insert(E_rows.end(), rows.begin(), rows.end());
+            E_cols.insert(E_cols.end(), cols.begin(), cols.end());
+        }
+    }
+    return components.labels(labels);
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,145 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_components.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_components(
+    const idxT top_n,
+    const idxT nrows,
+    std::optional<eT> threshold,
+    const bool with_edges,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    std::vector<idxT> labels(nrows);
+    std::vector<eT> E_data;
+    std::vector<idxT> E_rows;
+    std::vector<idxT> E_cols;
+    idxT n_components = core::sp_matmul_topn_components<eT, idxT, ptrT>(
+        top_n,
+        nrows,
+        local_threshold,
+        with_edges,
+        A_data.data(),
+        A_indptr.data(),
+        A_indices.data(),
+        B_data.data(),
+        B_indptr.data(),
+        B_indices.data(),
+        labels.data(),
+        E_data,
+        E_rows,
+        E_cols
+    );
+    return nb::make_tuple(
+        n_components,
+        to_nbvec<idxT>(std::move(labels)),
+        to_nbvec<eT>(std::move(E_data)),
+        to_nbvec<idxT>(std::move(E_rows)),
+        to_nbvec<idxT>(std::move(E_cols))
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_components_mt(
+    const idxT top_n,
+    const idxT nrows,
+    std::optional<eT> threshold,
+    const bool with_edges,
+    const int n_threads,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    std::vector<idxT> labels(nrows);
+    std::vector<eT> E_data;
+    std::vector<idxT> E_rows;
+    std::vector<idxT> E_cols;
+    idxT n_components = core::sp_matmul_topn_components_mt<eT, idxT, ptrT>(
+        top_n,
+        nrows,
+        local_threshold,
+        with_edges,
+        n_threads,
+        A_data.data(),
+        A_indptr.data(),
+        A_indices.data(),
+        B_data.data(),
+        B_indptr.data(),
+        B_indices.data(),
+        labels.data(),
+        E_data,
+        E_rows,
+        E_cols
+    );
+    return nb::make_tuple(
+        n_components,
+        to_nbvec<idxT>(std::move(labels)),
+        to_nbvec<eT>(std::move(E_data)),
+        to_nbvec<idxT>(std::move(E_rows)),
+        to_nbvec<idxT>(std::move(E_cols))
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_topn_components(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_components_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
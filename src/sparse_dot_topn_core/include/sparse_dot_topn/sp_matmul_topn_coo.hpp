@@ -0,0 +1,250 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief Compute A.dot(B) keeping only the top n results in COO format.
+ *
+ * \details This function will return a matrix C in COO format, where
+ * C = [sorted top n results > lower_bound for each row of A * B].
+ * The row index, column index and value of each retained element are
+ * appended to `C_rows`, `C_cols` and `C_data` respectively, such that
+ * they can be used directly as an edge list. The values are cast to `oT`
+ * when they are stored.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam oT   element type of the stored values
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] threshold minimum values required to store
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[out] C_data the nonzero elements of C
+ * \param[out] C_rows the row indices of `C_data`
+ * \param[out] C_cols the column indices of `C_data`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    typename oT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_topn_coo(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    std::vector<oT>& C_data,
+    std::vector<idxT>& C_rows,
+    std::vector<idxT>& C_cols
+) {
+    std::vector<idxT> next(ncols, -1);
+    std::vector<eT> sums(ncols, 0);
+
+    auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+    for (idxT i = 0; i < nrows; i++) {
+        idxT n_set = sp_matmul_topn_row<eT, idxT, ptrT, sort_order>(
+            i,
+            A_data,
+            A_indptr,
+            A_indices,
+            B_data,
+            B_indptr,
+            B_indices,
+            next,
+            sums,
+            max_heap
+        );
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            C_rows.push_back(i);
+            C_cols.push_back(max_heap.heap[ii].idx);
+            C_data.push_back(static_cast<oT>(max_heap.heap[ii].val));
+        }
+    }
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute A.dot(B) keeping only the top n results in COO format.
+ *
+ * \details The top n results of each row are stored in a slot of `top_n`
+ * elements, after which the offset of each row in the output is determined
+ * and the row indices, column indices and values are written in parallel.
+ * The values are cast to `oT` when they are stored.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam oT   element type of the stored values
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] threshold minimum values required to store
+ * \param[in] n_threads number of threads to use
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \returns tuple of the number of nonzero elements, `C_data`, `C_rows` and
+ * `C_cols`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    typename oT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, oT*, idxT*, idxT*> sp_matmul_topn_coo_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices
+) {
+    // `nrows * top_n` can exceed the range of `idxT`
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_offset = std::unique_ptr<size_t[]>(new size_t[nrows + 1]);
+    size_t total_nonzero = 0;
+    oT* C_data = nullptr;
+    idxT* C_rows = nullptr;
+    idxT* C_cols = nullptr;
+
+#pragma omp parallel num_threads(n_threads) \
+    shared(top_n,                           \
+               nrows,                       \
+               ncols,                       \
+               threshold,                   \
+               A_data,                      \
+               A_indptr,                    \
+               A_indices,                   \
+               B_data,                      \
+               B_indptr,                    \
+               B_indices,                   \
+               values,                      \
+               indices,                     \
+               row_offset,                  \
+               total_nonzero,               \
+               C_data,                      \
+               C_rows,                      \
+               C_cols)
+    {
+        {
+            std::vector<idxT> next(ncols, -1);
+            std::vector<eT> sums(ncols, 0);
+
+            auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+#pragma omp for
+            for (idxT i = 0; i < nrows; i++) {
+                size_t offset = static_cast<size_t>(i) * top_n;
+                eT* local_vals = values.get() + offset;
+                idxT* local_idxs = indices.get() + offset;
+
+                idxT n_set = sp_matmul_topn_row<eT, idxT, ptrT, sort_order>(
+                    i,
+                    A_data,
+                    A_indptr,
+                    A_indices,
+                    B_data,
+                    B_indptr,
+                    B_indices,
+                    next,
+                    sums,
+                    max_heap
+                );
+                for (idxT ii = 0; ii < n_set; ++ii) {
+                    local_idxs[ii] = max_heap.heap[ii].idx;
+                    local_vals[ii] = max_heap.heap[ii].val;
+                }
+                // shifted by one such that the scan yields the row offsets
+                row_offset[i + 1] = n_set;
+            }
+        }  // release the scratch arrays before the output is allocated
+
+#pragma omp single
+        {
+            row_offset[0] = 0;
+            std::partial_sum(
+                row_offset.get(), row_offset.get() + nrows + 1, row_offset.get()
+            );
+            total_nonzero = row_offset[nrows];
+            C_data = new oT[total_nonzero];
+            C_rows = new idxT[total_nonzero];
+            C_cols = new idxT[total_nonzero];
+        }  // implicit barrier
+
+#pragma omp for
+        for (idxT i = 0; i < nrows; i++) {
+            size_t start = row_offset[i];
+            size_t n_set = row_offset[i + 1] - start;
+            const size_t offset = static_cast<size_t>(i) * top_n;
+            const eT* local_vals = values.get() + offset;
+            const idxT* local_idxs = indices.get() + offset;
+            for (size_t ii = 0; ii < n_set; ++ii) {
+                C_data[start + ii] = static_cast<oT>(local_vals[ii]);
+                C_rows[start + ii] = i;
+                C_cols[start + ii] = local_idxs[ii];
+            }
+        }
+    }  // #pragma omp parallel
+    return std::make_tuple(total_nonzero, C_data, C_rows, C_cols);
+}  // sp_matmul_topn_coo_mt
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,167 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/string.h>
+
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_coo.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_coo(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    std::optional<double> density,
+    const std::string& value_dtype,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices
+) {
+    // without an expected density C is sized using an upper bound that only
+    // requires the index pointer of B, rather than a symbolic pass over A * B,
+    // the excess capacity is released after the product has been computed
+    size_t result_size;
+    if (density.has_value()) {
+        result_size = static_cast<size_t>(
+            ceil(density.value() * static_cast<double>(top_n) * nrows)
+        );
+    } else {
+        result_size = core::sp_matmul_topn_size(
+            top_n, nrows, A_indptr.data(), A_indices.data(), B_indptr.data()
+        );
+    }
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    return visit_value_dtype<eT>(value_dtype, [&](auto tag) {
+        using oT = typename decltype(tag)::type;
+        std::vector<oT> C_data;
+        C_data.reserve(result_size);
+        std::vector<idxT> C_rows;
+        C_rows.reserve(result_size);
+        std::vector<idxT> C_cols;
+        C_cols.reserve(result_size);
+        core::sp_matmul_topn_coo<eT, idxT, ptrT, oT, sort_order>(
+            top_n,
+            nrows,
+            ncols,
+            local_threshold,
+            A_data.data(),
+            A_indptr.data(),
+            A_indices.data(),
+            B_data.data(),
+            B_indptr.data(),
+            B_indices.data(),
+            C_data,
+            C_rows,
+            C_cols
+        );
+        C_data.shrink_to_fit();
+        C_rows.shrink_to_fit();
+        C_cols.shrink_to_fit();
+        return nb::make_tuple(
+            to_nbvec<oT>(std::move(C_data)),
+            to_nbvec<idxT>(std::move(C_rows)),
+            to_nbvec<idxT>(std::move(C_cols))
+        );
+    });
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_coo_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const int n_threads,
+    const std::string& value_dtype,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    return visit_value_dtype<eT>(value_dtype, [&](auto tag) {
+        using oT = typename decltype(tag)::type;
+        auto [total_nonzero, C_data, C_rows, C_cols]
+            = core::sp_matmul_topn_coo_mt<eT, idxT, ptrT, oT, sort_order>(
+                top_n,
+                nrows,
+                ncols,
+                local_threshold,
+                n_threads,
+                A_data.data(),
+                A_indptr.data(),
+                A_indices.data(),
+                B_data.data(),
+                B_indptr.data(),
+                B_indices.data()
+            );
+        return nb::make_tuple(
+            to_nbvec<oT>(C_data, total_nonzero),
+            to_nbvec<idxT>(C_rows, total_nonzero),
+            to_nbvec<idxT>(C_cols, total_nonzero)
+        );
+    });
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_topn_coo(nb::module_& m);
+void bind_sp_matmul_topn_sorted_coo(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_coo_mt(nb::module_& m);
+void bind_sp_matmul_topn_sorted_coo_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
@@ -0,0 +1,452 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+// the threads are managed by the kernels, Eigen's matrix product must not
+// start threads of its own
+#ifndef EIGEN_DONT_PARALLELIZE
+#define EIGEN_DONT_PARALLELIZE
+#endif  // EIGEN_DONT_PARALLELIZE
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief The number of rows and columns of a tile of scores, a tile of
+ * doubles is 256KB and fits in the L2 cache.
+ */
+inline constexpr int dense_row_block = 64;
+inline constexpr int dense_col_block = 512;
+
+template <typename eT>
+using RowMajorMatrix
+    = Eigen::Matrix<eT, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+template <typename eT>
+using ConstRowMajorMap = Eigen::Map<const RowMajorMatrix<eT>>;
+
+/**
+ * \brief The scratch space of a single thread, the tile of scores and a
+ * heap per row of the block of rows.
+ */
+template <typename eT, typename idxT>
+struct DenseTopnBuffers {
+    RowMajorMatrix<eT> tile;
+    std::vector<MaxHeap<eT, idxT>> heaps;
+    std::vector<eT> mins;
+
+    DenseTopnBuffers(const idxT top_n, const idxT ncols, const eT threshold)
+        : tile(dense_row_block, std::min<idxT>(dense_col_block, ncols)),
+          heaps(dense_row_block, MaxHeap<eT, idxT>(top_n, threshold)),
+          mins(dense_row_block) {}
+};
+
+/**
+ * \brief Retain the top n values of the rows `i0, ..., i0 + n_rows - 1` of
+ * the product in `buf.heaps`.
+ *
+ * \details The product is computed one tile of `dense_row_block` rows and
+ * `dense_col_block` columns at a time by `fill_tile`, the values of a tile
+ * are pushed into the heaps before the next tile overwrites it such that the
+ * scores are never stored in full. The heaps are sorted on return, on
+ * insertion order, which is the column order, or value depending on
+ * `sort_order`.
+ *
+ * \param[in] n_rows the number of rows of the block, at most
+ * `dense_row_block`
+ * \param[in] ncols the number of columns of the product
+ * \param[in] fill_tile callable `fill_tile(tile, c0, n_cols)` that stores
+ * the product of the block of rows and the columns `c0, ..., c0 + n_cols - 1`
+ * in `tile`
+ * \param[in,out] buf the scratch space
+ */
+template <typename eT, typename idxT, SortOrder sort_order, typename FillTile>
+inline void dense_topn_block(
+    const idxT n_rows,
+    const idxT ncols,
+    FillTile&& fill_tile,
+    DenseTopnBuffers<eT, idxT>& buf
+) {
+    for (idxT r = 0; r < n_rows; ++r) {
+        buf.mins[r] = buf.heaps[r].reset();
+    }
+    for (idxT c0 = 0; c0 < ncols; c0 += dense_col_block) {
+        const idxT n_cols = std::min<idxT>(dense_col_block, ncols - c0);
+        auto tile = buf.tile.topLeftCorner(n_rows, n_cols);
+        fill_tile(tile, c0, n_cols);
+        for (idxT r = 0; r < n_rows; ++r) {
+            const eT* scores = buf.tile.data() + r * buf.tile.cols();
+            eT min = buf.mins[r];
+            for (idxT j = 0; j < n_cols; ++j) {
+                if (scores[j] > min) {
+                    min = buf.heaps[r].push_pop(c0 + j, scores[j]);
+                }
+            }
+            buf.mins[r] = min;
+        }
+    }
+    for (idxT r = 0; r < n_rows; ++r) {
+        if constexpr (sort_order == SortOrder::value) {
+            // sort the heap s.t. the first value is the largest
+            buf.heaps[r].value_sort();
+        } else {
+            // the columns are pushed in increasing order
+            buf.heaps[r].insertion_sort();
+        }
+    }
+}
+
+/**
+ * \brief Compute the top n of the rows `i0, ..., i0 + n_rows - 1` of Q.dot(E.T)
+ * for the dense row-major matrices Q and E.
+ */
+template <typename eT, typename idxT, SortOrder sort_order>
+inline void dense_dense_topn_block(
+    const idxT i0,
+    const idxT n_rows,
+    const ConstRowMajorMap<eT>& Q,
+    const ConstRowMajorMap<eT>& E,
+    DenseTopnBuffers<eT, idxT>& buf
+) {
+    const auto Q_block = Q.middleRows(i0, n_rows);
+    dense_topn_block<eT, idxT, sort_order>(
+        n_rows,
+        static_cast<idxT>(E.rows()),
+        [&](auto& tile, const idxT c0, const idxT n_cols) {
+            tile.noalias() = Q_block * E.middleRows(c0, n_cols).transpose();
+        },
+        buf
+    );
+}
+
+/**
+ * \brief Compute the top n of the rows `i0, ..., i0 + n_rows - 1` of A.dot(D)
+ * for the sparse CSR matrix A and the dense row-major matrix D.
+ */
+template <typename eT, typename idxT, typename ptrT, SortOrder sort_order>
+inline void sparse_dense_topn_block(
+    const idxT i0,
+    const idxT n_rows,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const ConstRowMajorMap<eT>& D,
+    DenseTopnBuffers<eT, idxT>& buf
+) {
+    dense_topn_block<eT, idxT, sort_order>(
+        n_rows,
+        static_cast<idxT>(D.cols()),
+        [&](auto& tile, const idxT c0, const idxT n_cols) {
+            tile.setZero();
+            for (idxT r = 0; r < n_rows; ++r) {
+                const idxT i = i0 + r;
+                for (ptrT kk = A_indptr[i]; kk < A_indptr[i + 1]; ++kk) {
+                    tile.row(r) += A_data[kk]
+                                   * D.block(A_indices[kk], c0, 1, n_cols);
+                }
+            }
+        },
+        buf
+    );
+}
+
+/**
+ * \brief Copy the top n values of the block of rows to the slots of the
+ * rows, each row has `top_n` slots.
+ */
+template <typename eT, typename idxT>
+inline void dense_topn_store(
+    const idxT i0,
+    const idxT n_rows,
+    const idxT top_n,
+    const DenseTopnBuffers<eT, idxT>& buf,
+    eT* __restrict values,
+    idxT* __restrict indices,
+    idxT* __restrict row_nset
+) {
+    for (idxT r = 0; r < n_rows; ++r) {
+        const auto& max_heap = buf.heaps[r];
+        const size_t offset = static_cast<size_t>(i0 + r) * top_n;
+        const idxT n_set = max_heap.get_n_set();
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            indices[offset + ii] = max_heap.heap[ii].idx;
+            values[offset + ii] = max_heap.heap[ii].val;
+        }
+        row_nset[i0 + r] = n_set;
+    }
+}
+
+/**
+ * \brief Compute Q.dot(E.T) keeping only the top n results, for the dense
+ * matrices Q and E, e.g. the embeddings of the queries and the entities.
+ *
+ * \details The scores are computed in tiles by Eigen's blocked matrix
+ * product and streamed into a heap per row, the full matrix of scores is
+ * never stored. C is returned in CSR format.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam sort_order order of the values of a row, the insertion order is
+ * the column order
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in Q
+ * \param[in] ncols the number of rows in E
+ * \param[in] dim the number of columns in Q and E
+ * \param[in] threshold minimum values required to store
+ * \param[in] Q_data the elements of Q in row-major order
+ * \param[in] E_data the elements of E in row-major order
+ * \returns the number of nonzero elements of C, `C_data`, `C_indices` and
+ * `C_indptr`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> dense_matmul_topn(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const idxT dim,
+    const eT threshold,
+    const eT* __restrict Q_data,
+    const eT* __restrict E_data
+) {
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    const ConstRowMajorMap<eT> Q(Q_data, nrows, dim);
+    const ConstRowMajorMap<eT> E(E_data, ncols, dim);
+    DenseTopnBuffers<eT, idxT> buf(top_n, ncols, threshold);
+    for (idxT i0 = 0; i0 < nrows; i0 += dense_row_block) {
+        const idxT n_rows = std::min<idxT>(dense_row_block, nrows - i0);
+        dense_dense_topn_block<eT, idxT, sort_order>(i0, n_rows, Q, E, buf);
+        dense_topn_store<eT, idxT>(
+            i0, n_rows, top_n, buf, values.get(), indices.get(), row_nset.get()
+        );
+    }
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}
+
+/**
+ * \brief Compute A.dot(D) keeping only the top n results, for the sparse
+ * matrix A and the dense matrix D.
+ *
+ * \details D is typically the transpose of the embeddings of the columns.
+ * The product is computed in tiles that are streamed into a heap per row,
+ * see `dense_matmul_topn`.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \tparam sort_order order of the values of a row, the insertion order is
+ * the column order
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in D
+ * \param[in] dim the number of columns in A and rows in D
+ * \param[in] threshold minimum values required to store
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] D_data the elements of D in row-major order
+ * \returns the number of nonzero elements of C, `C_data`, `C_indices` and
+ * `C_indptr`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sparse_dense_matmul_topn(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const idxT dim,
+    const eT threshold,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict D_data
+) {
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    const ConstRowMajorMap<eT> D(D_data, dim, ncols);
+    DenseTopnBuffers<eT, idxT> buf(top_n, ncols, threshold);
+    for (idxT i0 = 0; i0 < nrows; i0 += dense_row_block) {
+        const idxT n_rows = std::min<idxT>(dense_row_block, nrows - i0);
+        sparse_dense_topn_block<eT, idxT, ptrT, sort_order>(
+            i0, n_rows, A_data, A_indptr, A_indices, D, buf
+        );
+        dense_topn_store<eT, idxT>(
+            i0, n_rows, top_n, buf, values.get(), indices.get(), row_nset.get()
+        );
+    }
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute Q.dot(E.T) keeping only the top n results using
+ * `n_threads`, see `dense_matmul_topn`.
+ *
+ * \details The blocks of rows are distributed over the threads, Eigen's
+ * matrix product is single threaded within a thread.
+ *
+ * \param[in] n_threads number of threads to use
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> dense_matmul_topn_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const idxT dim,
+    const eT threshold,
+    const int n_threads,
+    const eT* __restrict Q_data,
+    const eT* __restrict E_data
+) {
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    const ConstRowMajorMap<eT> Q(Q_data, nrows, dim);
+    const ConstRowMajorMap<eT> E(E_data, ncols, dim);
+#pragma omp parallel num_threads(n_threads) \
+    shared(top_n, nrows, ncols, threshold, Q, E, values, indices, row_nset)
+    {
+        DenseTopnBuffers<eT, idxT> buf(top_n, ncols, threshold);
+#pragma omp for schedule(static)
+        for (idxT i0 = 0; i0 < nrows; i0 += dense_row_block) {
+            const idxT n_rows = std::min<idxT>(dense_row_block, nrows - i0);
+            dense_dense_topn_block<eT, idxT, sort_order>(
+                i0, n_rows, Q, E, buf
+            );
+            dense_topn_store<eT, idxT>(
+                i0,
+                n_rows,
+                top_n,
+                buf,
+                values.get(),
+                indices.get(),
+                row_nset.get()
+            );
+        }
+    }  // #pragma omp parallel
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}
+
+/**
+ * \brief Compute A.dot(D) keeping only the top n results using `n_threads`,
+ * see `sparse_dense_matmul_topn`.
+ *
+ * \param[in] n_threads number of threads to use
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sparse_dense_matmul_topn_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const idxT dim,
+    const eT threshold,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict D_data
+) {
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    const ConstRowMajorMap<eT> D(D_data, dim, ncols);
+#pragma omp parallel num_threads(n_threads) \
+    shared(top_n,                           \
+               nrows,                       \
+               ncols,                       \
+               threshold,                   \
+               A_data,                      \
+               A_indptr,                    \
+               A_indices,                   \
+               D,                           \
+               values,                      \
+               indices,                     \
+               row_nset)
+    {
+        DenseTopnBuffers<eT, idxT> buf(top_n, ncols, threshold);
+        // the number of nonzero elements per block of rows varies
+#pragma omp for schedule(dynamic, 1)
+        for (idxT i0 = 0; i0 < nrows; i0 += dense_row_block) {
+            const idxT n_rows = std::min<idxT>(dense_row_block, nrows - i0);
+            sparse_dense_topn_block<eT, idxT, ptrT, sort_order>(
+                i0, n_rows, A_data, A_indptr, A_indices, D, buf
+            );
+            dense_topn_store<eT, idxT>(
+                i0,
+                n_rows,
+                top_n,
+                buf,
+                values.get(),
+                indices.get(),
+                row_nset.get()
+            );
+        }
+    }  // #pragma omp parallel
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,198 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_dense.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple dense_matmul_topn(
+    const idxT top_n,
+    std::optional<eT> threshold,
+    const nb_mat<eT>& Q,
+    const nb_mat<eT>& E
+) {
+    if (Q.shape(1) != E.shape(1)) {
+        throw std::invalid_argument("`Q` and `E` differ in number of columns");
+    }
+    const auto nrows = static_cast<idxT>(Q.shape(0));
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::dense_matmul_topn<eT, idxT, ptrT, sort_order>(
+            top_n,
+            nrows,
+            static_cast<idxT>(E.shape(0)),
+            static_cast<idxT>(Q.shape(1)),
+            local_threshold,
+            Q.data(),
+            E.data()
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sparse_dense_matmul_topn(
+    const idxT top_n,
+    const idxT nrows,
+    std::optional<eT> threshold,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_mat<eT>& D
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::sparse_dense_matmul_topn<eT, idxT, ptrT, sort_order>(
+            top_n,
+            nrows,
+            static_cast<idxT>(D.shape(1)),
+            static_cast<idxT>(D.shape(0)),
+            local_threshold,
+            A_data.data(),
+            A_indptr.data(),
+            A_indices.data(),
+            D.data()
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple dense_matmul_topn_mt(
+    const idxT top_n,
+    std::optional<eT> threshold,
+    const int n_threads,
+    const nb_mat<eT>& Q,
+    const nb_mat<eT>& E
+) {
+    if (Q.shape(1) != E.shape(1)) {
+        throw std::invalid_argument("`Q` and `E` differ in number of columns");
+    }
+    const auto nrows = static_cast<idxT>(Q.shape(0));
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::dense_matmul_topn_mt<eT, idxT, ptrT, sort_order>(
+            top_n,
+            nrows,
+            static_cast<idxT>(E.shape(0)),
+            static_cast<idxT>(Q.shape(1)),
+            local_threshold,
+            n_threads,
+            Q.data(),
+            E.data()
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sparse_dense_matmul_topn_mt(
+    const idxT top_n,
+    const idxT nrows,
+    std::optional<eT> threshold,
+    const int n_threads,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_mat<eT>& D
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::sparse_dense_matmul_topn_mt<eT, idxT, ptrT, sort_order>(
+            top_n,
+            nrows,
+            static_cast<idxT>(D.shape(1)),
+            static_cast<idxT>(D.shape(0)),
+            local_threshold,
+            n_threads,
+            A_data.data(),
+            A_indptr.data(),
+            A_indices.data(),
+            D.data()
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_dense_matmul_topn(nb::module_& m);
+void bind_dense_matmul_topn_sorted(nb::module_& m);
+void bind_sparse_dense_matmul_topn(nb::module_& m);
+void bind_sparse_dense_matmul_topn_sorted(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_dense_matmul_topn_mt(nb::module_& m);
+void bind_dense_matmul_topn_sorted_mt(nb::module_& m);
+void bind_sparse_dense_matmul_topn_mt(nb::module_& m);
+void bind_sparse_dense_matmul_topn_sorted_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
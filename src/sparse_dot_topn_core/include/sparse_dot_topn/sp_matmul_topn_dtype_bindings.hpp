@@ -0,0 +1,211 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/string.h>
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/semiring.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+/**
+ * \brief Compute the top n of A.dot(B) with a separate accumulator and output
+ * type.
+ *
+ * \details The products are accumulated in the type named by `acc_dtype` and
+ * C is stored in the type named by `value_dtype`, an empty name selects the
+ * type of `A_data` respectively the accumulator type. The accumulator can not
+ * be narrower than the input, the output can, e.g. to compute in float64 but
+ * return float32 values.
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_dtype(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<double> threshold,
+    std::optional<double> density,
+    const std::string& acc_dtype,
+    const std::string& value_dtype,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices
+) {
+    size_t result_size;
+    if (density.has_value()) {
+        result_size = static_cast<size_t>(
+            ceil(density.value() * static_cast<double>(top_n) * nrows)
+        );
+    } else {
+        result_size = core::sp_matmul_topn_size(
+            top_n, nrows, A_indptr.data(), A_indices.data(), B_indptr.data()
+        );
+    }
+    return visit_acc_dtype<eT>(acc_dtype, [&](auto acc_tag) -> nb::tuple {
+        using accT = typename decltype(acc_tag)::type;
+        if constexpr (sizeof(accT) < sizeof(eT)) {
+            throw std::invalid_argument(
+                "`acc_dtype` can not be narrower than the dtype of `A_data`"
+            );
+        } else {
+            accT local_threshold = threshold.has_value()
+                ? static_cast<accT>(threshold.value())
+                : std::numeric_limits<accT>::min();
+            return visit_value_dtype<accT>(value_dtype, [&](auto tag) {
+                using oT = typename decltype(tag)::type;
+                std::vector<oT> C_data;
+                C_data.reserve(result_size);
+                std::vector<idxT> C_indices;
+                C_indices.reserve(result_size);
+                std::vector<ptrT> C_indptr(nrows + 1);
+                core::sp_matmul_topn<
+                    eT,
+                    idxT,
+                    ptrT,
+                    sort_order,
+                    core::PlusTimes<accT>,
+                    oT>(
+                    top_n,
+                    nrows,
+                    ncols,
+                    local_threshold,
+                    A_data.data(),
+                    A_indptr.data(),
+                    A_indices.data(),
+                    B_data.data(),
+                    B_indptr.data(),
+                    B_indices.data(),
+                    C_data,
+                    C_indptr,
+                    C_indices
+                );
+                C_data.shrink_to_fit();
+                C_indices.shrink_to_fit();
+                return nb::make_tuple(
+                    to_nbvec<oT>(std::move(C_data)),
+                    to_nbvec<idxT>(std::move(C_indices)),
+                    to_nbvec<ptrT>(std::move(C_indptr))
+                );
+            });
+        }
+    });
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_dtype_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<double> threshold,
+    const int n_threads,
+    const std::string& acc_dtype,
+    const std::string& value_dtype,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices
+) {
+    return visit_acc_dtype<eT>(acc_dtype, [&](auto acc_tag) -> nb::tuple {
+        using accT = typename decltype(acc_tag)::type;
+        if constexpr (sizeof(accT) < sizeof(eT)) {
+            throw std::invalid_argument(
+                "`acc_dtype` can not be narrower than the dtype of `A_data`"
+            );
+        } else {
+            accT local_threshold = threshold.has_value()
+                ? static_cast<accT>(threshold.value())
+                : std::numeric_limits<accT>::min();
+            return visit_value_dtype<accT>(value_dtype, [&](auto tag) {
+                using oT = typename decltype(tag)::type;
+                auto [total_nonzero, C_data, C_indices, C_indptr]
+                    = core::sp_matmul_topn_mt<
+                        eT,
+                        idxT,
+                        ptrT,
+                        sort_order,
+                        core::PlusTimes<accT>,
+                        oT>(
+                        top_n,
+                        nrows,
+                        ncols,
+                        local_threshold,
+                        n_threads,
+                        A_data.data(),
+                        A_indptr.data(),
+                        A_indices.data(),
+                        B_data.data(),
+                        B_indptr.data(),
+                        B_indices.data()
+                    );
+                return nb::make_tuple(
+                    to_nbvec<oT>(C_data, total_nonzero),
+                    to_nbvec<idxT>(C_indices, total_nonzero),
+                    to_nbvec<ptrT>(C_indptr, nrows + 1)
+                );
+            });
+        }
+    });
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_topn_dtype(nb::module_& m);
+void bind_sp_matmul_topn_dtype_sorted(nb::module_& m);
+void bind_sp_matmul_topn_dtype_canonical(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_dtype_mt(nb::module_& m);
+void bind_sp_matmul_topn_dtype_sorted_mt(nb::module_& m);
+void bind_sp_matmul_topn_dtype_canonical_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
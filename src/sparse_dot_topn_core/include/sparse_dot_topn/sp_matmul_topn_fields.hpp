@@ -0,0 +1,227 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief The operands of a single field of the weighted product
+ * `sum_k weight_k * A_k.dot(B_k)`.
+ *
+ * \details `A` and `B` are in CSR format, all fields share the rows of `A`
+ * and the columns of `B`.
+ */
+template <typename eT, typename idxT, typename ptrT>
+struct Field {
+    eT weight;
+    const eT* A_data;
+    const ptrT* A_indptr;
+    const idxT* A_indices;
+    const eT* B_data;
+    const ptrT* B_indptr;
+    const idxT* B_indices;
+};
+
+/**
+ * \brief Compute row `i` of `sum_k weight_k * A_k.dot(B_k)` and retain the
+ * top n values in `max_heap`.
+ *
+ * \details The fields are accumulated in the same `sums` such that the
+ * weighted sum is only materialised for a single row. `next` and `sums` are
+ * the scratch arrays of length `ncols`, they must be initialised with -1 and
+ * 0 respectively and are reset on return.
+ *
+ * \returns the number of values retained in the heap
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_fields_row(
+    const idxT i,
+    const std::vector<Field<eT, idxT, ptrT>>& fields,
+    std::vector<idxT>& next,
+    std::vector<eT>& sums,
+    MaxHeap<eT, idxT>& max_heap
+) {
+    idxT head = -2;
+    idxT length = 0;
+    for (const auto& field : fields) {
+        const eT* __restrict A_data = field.A_data;
+        const ptrT* __restrict A_indptr = field.A_indptr;
+        const idxT* __restrict A_indices = field.A_indices;
+        for (ptrT A_cidx = A_indptr[i]; A_cidx < A_indptr[i + 1]; ++A_cidx) {
+            // fold the weight into the value of A in (i,j)
+            sp_matmul_accumulate<eT, idxT, ptrT>(
+                field.weight * A_data[A_cidx],
+                A_indices[A_cidx],
+                field.B_data,
+                field.B_indptr,
+                field.B_indices,
+                next,
+                sums,
+                head,
+                length
+            );
+        }
+    }
+    return sp_matmul_topn_drain<idxT, sort_order, PlusTimes<eT>>(
+        head,
+        length,
+        next,
+        sums,
+        max_heap,
+        [](const idxT, const eT val) { return val; }
+    );
+}
+
+/**
+ * \brief Compute `sum_k weight_k * A_k.dot(B_k)` keeping only the top n
+ * results.
+ *
+ * \details Equivalent to the top n of the sum of the products of the fields
+ * but requires the memory of a single top n product.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in the `A` of the fields
+ * \param[in] ncols the number of columns in the `B` of the fields
+ * \param[in] threshold minimum values required to store
+ * \param[in] fields the weighted operands
+ * \param[out] C_data the nonzero elements of C
+ * \param[out] C_indptr array containing the row indices for `C_data`
+ * \param[out] C_indices array containing the column indices
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline void sp_matmul_topn_fields(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const std::vector<Field<eT, idxT, ptrT>>& fields,
+    std::vector<eT>& C_data,
+    std::vector<ptrT>& C_indptr,
+    std::vector<idxT>& C_indices
+) {
+    std::vector<idxT> next(ncols, -1);
+    std::vector<eT> sums(ncols, 0);
+
+    auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+    ptrT nnz = 0;
+    C_indptr[0] = 0;
+
+    for (idxT i = 0; i < nrows; ++i) {
+        idxT n_set = sp_matmul_topn_fields_row<eT, idxT, ptrT, sort_order>(
+            i, fields, next, sums, max_heap
+        );
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            C_indices.push_back(max_heap.heap[ii].idx);
+            C_data.push_back(max_heap.heap[ii].val);
+        }
+        nnz += n_set;
+        C_indptr[i + 1] = nnz;
+    }
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute `sum_k weight_k * A_k.dot(B_k)` keeping only the top n
+ * results using `n_threads`.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in the `A` of the fields
+ * \param[in] ncols the number of columns in the `B` of the fields
+ * \param[in] threshold minimum values required to store
+ * \param[in] n_threads number of threads to use
+ * \param[in] fields the weighted operands
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_fields_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const int n_threads,
+    const std::vector<Field<eT, idxT, ptrT>>& fields
+) {
+    // `nrows * top_n` can exceed the range of `idxT`
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+#pragma omp parallel num_threads(n_threads) \
+    shared(top_n, nrows, ncols, threshold, fields, values, indices, row_nset)
+    {
+        std::vector<idxT> next(ncols, -1);
+        std::vector<eT> sums(ncols, 0);
+
+        auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+#pragma omp for
+        for (idxT i = 0; i < nrows; ++i) {
+            const size_t offset = static_cast<size_t>(i) * top_n;
+            idxT n_set
+                = sp_matmul_topn_fields_row<eT, idxT, ptrT, sort_order>(
+                    i, fields, next, sums, max_heap
+                );
+            for (idxT ii = 0; ii < n_set; ++ii) {
+                indices[offset + ii] = max_heap.heap[ii].idx;
+                values[offset + ii] = max_heap.heap[ii].val;
+            }
+            row_nset[i] = n_set;
+        }
+    }  // #pragma omp parallel
+
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}  // sp_matmul_topn_fields_mt
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
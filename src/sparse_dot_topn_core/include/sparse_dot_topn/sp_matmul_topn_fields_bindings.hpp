@@ -0,0 +1,184 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/vector.h>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_fields.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+/**
+ * \brief Collect the operands of the fields, the lists must have an element
+ * per weight.
+ */
+template <typename eT, typename idxT, typename ptrT>
+inline std::vector<core::Field<eT, idxT, ptrT>> to_fields(
+    const nb_vec<eT>& weights,
+    const std::vector<nb_vec<eT>>& A_data,
+    const std::vector<nb_vec<ptrT>>& A_indptr,
+    const std::vector<nb_vec<idxT>>& A_indices,
+    const std::vector<nb_vec<eT>>& B_data,
+    const std::vector<nb_vec<ptrT>>& B_indptr,
+    const std::vector<nb_vec<idxT>>& B_indices
+) {
+    const size_t n_fields = weights.size();
+    if (A_data.size() != n_fields || A_indptr.size() != n_fields
+        || A_indices.size() != n_fields || B_data.size() != n_fields
+        || B_indptr.size() != n_fields || B_indices.size() != n_fields) {
+        throw std::invalid_argument(
+            "the operands must have an element per weight"
+        );
+    }
+    std::vector<core::Field<eT, idxT, ptrT>> fields;
+    fields.reserve(n_fields);
+    for (size_t f = 0; f < n_fields; ++f) {
+        fields.push_back(
+            {weights.data()[f],
+             A_data[f].data(),
+             A_indptr[f].data(),
+             A_indices[f].data(),
+             B_data[f].data(),
+             B_indptr[f].data(),
+             B_indices[f].data()}
+        );
+    }
+    return fields;
+}
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_fields(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const nb_vec<eT>& weights,
+    const std::vector<nb_vec<eT>>& A_data,
+    const std::vector<nb_vec<ptrT>>& A_indptr,
+    const std::vector<nb_vec<idxT>>& A_indices,
+    const std::vector<nb_vec<eT>>& B_data,
+    const std::vector<nb_vec<ptrT>>& B_indptr,
+    const std::vector<nb_vec<idxT>>& B_indices
+) {
+    const auto fields = to_fields<eT, idxT, ptrT>(
+        weights, A_data, A_indptr, A_indices, B_data, B_indptr, B_indices
+    );
+    // the sum of the bounds of the fields, a row holds at most top_n
+    size_t result_size = 0;
+    for (const auto& field : fields) {
+        result_size += core::sp_matmul_topn_size(
+            top_n, nrows, field.A_indptr, field.A_indices, field.B_indptr
+        );
+    }
+    result_size
+        = std::min(result_size, static_cast<size_t>(nrows) * top_n);
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    std::vector<eT> C_data;
+    C_data.reserve(result_size);
+    std::vector<idxT> C_indices;
+    C_indices.reserve(result_size);
+    std::vector<ptrT> C_indptr(nrows + 1);
+    core::sp_matmul_topn_fields<eT, idxT, ptrT, sort_order>(
+        top_n,
+        nrows,
+        ncols,
+        local_threshold,
+        fields,
+        C_data,
+        C_indptr,
+        C_indices
+    );
+    C_data.shrink_to_fit();
+    C_indices.shrink_to_fit();
+    return nb::make_tuple(
+        to_nbvec<eT>(std::move(C_data)),
+        to_nbvec<idxT>(std::move(C_indices)),
+        to_nbvec<ptrT>(std::move(C_indptr))
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_fields_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const int n_threads,
+    const nb_vec<eT>& weights,
+    const std::vector<nb_vec<eT>>& A_data,
+    const std::vector<nb_vec<ptrT>>& A_indptr,
+    const std::vector<nb_vec<idxT>>& A_indices,
+    const std::vector<nb_vec<eT>>& B_data,
+    const std::vector<nb_vec<ptrT>>& B_indptr,
+    const std::vector<nb_vec<idxT>>& B_indices
+) {
+    const auto fields = to_fields<eT, idxT, ptrT>(
+        weights, A_data, A_indptr, A_indices, B_data, B_indptr, B_indices
+    );
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::sp_matmul_topn_fields_mt<eT, idxT, ptrT, sort_order>(
+            top_n, nrows, ncols, local_threshold, n_threads, fields
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_topn_fields(nb::module_& m);
+void bind_sp_matmul_topn_fields_sorted(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_fields_mt(nb::module_& m);
+void bind_sp_matmul_topn_fields_sorted_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
@@ -0,0 +1,285 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_dense.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief Compute row `i` of `alpha * A.dot(B) + beta * Q.dot(E.T)` for the
+ * columns set in row `i` of A.dot(B) and retain the top n values in
+ * `max_heap`.
+ *
+ * \details The sparse product generates the candidates, the dot product of
+ * the embeddings is only computed for the columns it touches before the
+ * fused score is compared with the heap. `next` and `sums` are the scratch
+ * arrays of length `ncols`, they must be initialised with -1 and 0
+ * respectively and are reset on return.
+ *
+ * \returns the number of values retained in the heap
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_hybrid_row(
+    const idxT i,
+    const eT alpha,
+    const eT beta,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const ConstRowMajorMap<eT>& Q,
+    const ConstRowMajorMap<eT>& E,
+    std::vector<idxT>& next,
+    std::vector<eT>& sums,
+    MaxHeap<eT, idxT>& max_heap
+) {
+    idxT head = -2;
+    idxT length = 0;
+    sp_matmul_accumulate_row<eT, idxT, ptrT>(
+        i,
+        A_data,
+        A_indptr,
+        A_indices,
+        B_data,
+        B_indptr,
+        B_indices,
+        next,
+        sums,
+        head,
+        length
+    );
+
+    const auto q = Q.row(i);
+    return sp_matmul_topn_drain<idxT, sort_order, PlusTimes<eT>>(
+        head,
+        length,
+        next,
+        sums,
+        max_heap,
+        [&](const idxT k, const eT val) {
+            return alpha * val + beta * q.dot(E.row(k));
+        }
+    );
+}
+
+/**
+ * \brief Compute `alpha * A.dot(B) + beta * Q.dot(E.T)` over the columns
+ * set in A.dot(B) keeping only the top n results.
+ *
+ * \details A single pass that selects the top n on the fused score, e.g. of
+ * the cosine similarity of TF-IDF vectors and of embeddings. Columns that
+ * do not share an element with a row of A are not scored.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A and Q
+ * \param[in] ncols the number of columns in B and rows in E
+ * \param[in] dim the number of columns in Q and E
+ * \param[in] threshold minimum values required to store
+ * \param[in] alpha the weight of the sparse product
+ * \param[in] beta the weight of the dense product
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \param[in] Q_data the embeddings of the rows in row-major order
+ * \param[in] E_data the embeddings of the columns in row-major order
+ * \returns the number of nonzero elements of C, `C_data`, `C_indices` and
+ * `C_indptr`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_hybrid(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const idxT dim,
+    const eT threshold,
+    const eT alpha,
+    const eT beta,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const eT* __restrict Q_data,
+    const eT* __restrict E_data
+) {
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    const ConstRowMajorMap<eT> Q(Q_data, nrows, dim);
+    const ConstRowMajorMap<eT> E(E_data, ncols, dim);
+
+    std::vector<idxT> next(ncols, -1);
+    std::vector<eT> sums(ncols, 0);
+    auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+    for (idxT i = 0; i < nrows; ++i) {
+        const size_t offset = static_cast<size_t>(i) * top_n;
+        const idxT n_set
+            = sp_matmul_topn_hybrid_row<eT, idxT, ptrT, sort_order>(
+                i,
+                alpha,
+                beta,
+                A_data,
+                A_indptr,
+                A_indices,
+                B_data,
+                B_indptr,
+                B_indices,
+                Q,
+                E,
+                next,
+                sums,
+                max_heap
+            );
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            indices[offset + ii] = max_heap.heap[ii].idx;
+            values[offset + ii] = max_heap.heap[ii].val;
+        }
+        row_nset[i] = n_set;
+    }
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute `alpha * A.dot(B) + beta * Q.dot(E.T)` over the columns
+ * set in A.dot(B) keeping only the top n results using `n_threads`, see
+ * `sp_matmul_topn_hybrid`.
+ *
+ * \param[in] n_threads number of threads to use
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_hybrid_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const idxT dim,
+    const eT threshold,
+    const eT alpha,
+    const eT beta,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    const eT* __restrict Q_data,
+    const eT* __restrict E_data
+) {
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    const ConstRowMajorMap<eT> Q(Q_data, nrows, dim);
+    const ConstRowMajorMap<eT> E(E_data, ncols, dim);
+#pragma omp parallel num_threads(n_threads) \
+    shared(top_n,                           \
+               nrows,                       \
+               ncols,                       \
+               threshold,                   \
+               alpha,                       \
+               beta,                        \
+               A_data,                      \
+               A_indptr,                    \
+               A_indices,                   \
+               B_data,                      \
+               B_indptr,                    \
+               B_indices,                   \
+               Q,                           \
+               E,                           \
+               values,                      \
+               indices,                     \
+               row_nset)
+    {
+        std::vector<idxT> next(ncols, -1);
+        std::vector<eT> sums(ncols, 0);
+        auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+#pragma omp for schedule(dynamic, 64)
+        for (idxT i = 0; i < nrows; ++i) {
+            const size_t offset = static_cast<size_t>(i) * top_n;
+            const idxT n_set
+                = sp_matmul_topn_hybrid_row<eT, idxT, ptrT, sort_order>(
+                    i,
+                    alpha,
+                    beta,
+                    A_data,
+                    A_indptr,
+                    A_indices,
+                    B_data,
+                    B_indptr,
+                    B_indices,
+                    Q,
+                    E,
+                    next,
+                    sums,
+                    max_heap
+                );
+            for (idxT ii = 0; ii < n_set; ++ii) {
+                indices[offset + ii] = max_heap.heap[ii].idx;
+                values[offset + ii] = max_heap.heap[ii].val;
+            }
+            row_nset[i] = n_set;
+        }
+    }  // #pragma omp parallel
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values.get(), indices.get(), row_nset.get()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,177 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_hybrid.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+/**
+ * \brief Check that the embeddings have a row per row and column of the
+ * product and the same dimension.
+ */
+inline void check_embeddings(
+    const std::size_t nrows,
+    const std::size_t ncols,
+    const std::size_t Q_nrows,
+    const std::size_t Q_dim,
+    const std::size_t E_nrows,
+    const std::size_t E_dim
+) {
+    if (Q_nrows != nrows || E_nrows != ncols) {
+        throw std::invalid_argument(
+            "the embeddings must have a row per row and column of C"
+        );
+    }
+    if (Q_dim != E_dim) {
+        throw std::invalid_argument("`Q` and `E` differ in number of columns");
+    }
+}
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_hybrid(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const eT alpha,
+    const eT beta,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices,
+    const nb_mat<eT>& Q,
+    const nb_mat<eT>& E
+) {
+    check_embeddings(
+        nrows, ncols, Q.shape(0), Q.shape(1), E.shape(0), E.shape(1)
+    );
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::sp_matmul_topn_hybrid<eT, idxT, ptrT, sort_order>(
+            top_n,
+            nrows,
+            ncols,
+            static_cast<idxT>(Q.shape(1)),
+            local_threshold,
+            alpha,
+            beta,
+            A_data.data(),
+            A_indptr.data(),
+            A_indices.data(),
+            B_data.data(),
+            B_indptr.data(),
+            B_indices.data(),
+            Q.data(),
+            E.data()
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_hybrid_mt(
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const eT alpha,
+    const eT beta,
+    const int n_threads,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices,
+    const nb_mat<eT>& Q,
+    const nb_mat<eT>& E
+) {
+    check_embeddings(
+        nrows, ncols, Q.shape(0), Q.shape(1), E.shape(0), E.shape(1)
+    );
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = core::sp_matmul_topn_hybrid_mt<eT, idxT, ptrT, sort_order>(
+            top_n,
+            nrows,
+            ncols,
+            static_cast<idxT>(Q.shape(1)),
+            local_threshold,
+            alpha,
+            beta,
+            n_threads,
+            A_data.data(),
+            A_indptr.data(),
+            A_indices.data(),
+            B_data.data(),
+            B_indptr.data(),
+            B_indices.data(),
+            Q.data(),
+            E.data()
+        );
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_topn_hybrid(nb::module_& m);
+void bind_sp_matmul_topn_hybrid_sorted(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_hybrid_mt(nb::module_& m);
+void bind_sp_matmul_topn_hybrid_sorted_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
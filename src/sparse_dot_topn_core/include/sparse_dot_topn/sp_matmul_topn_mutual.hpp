@@ -0,0 +1,468 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#if defined(SDTN_OMP_ENABLED)
+#include <omp.h>
+#endif  // SDTN_OMP_ENABLED
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief Which top-n results of A.dot(B) are returned.
+ *
+ * \details `row` the top n of each row, `column` the top n of each column
+ * and `mutual` the elements that are in the top n of both their row and
+ * their column.
+ */
+enum class MutualMode { row, column, mutual };
+
+/**
+ * \brief The top n values of each column of a matrix.
+ *
+ * \details Each column holds a heap of at most `top_n` (value, row) pairs
+ * where the root is the worst pair. Pairs are ranked on value and on the row
+ * for equal values, such that the result does not depend on the order in
+ * which the rows are pushed.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ */
+template <typename eT, typename idxT, iffInt<idxT> = true>
+class ColumnTopN {
+    struct Entry {
+        eT val;
+        idxT row;
+    };
+    idxT top_n;
+    eT threshold;
+    std::vector<Entry> heaps;
+    std::vector<idxT> col_nset;
+
+    // `l` is ranked above `r`, as comparator the root of the heap is the
+    // lowest ranked entry
+    static bool ranks_above(const Entry& l, const Entry& r) {
+        return l.val > r.val || (l.val == r.val && l.row < r.row);
+    }
+
+ public:
+    ColumnTopN(const idxT top_n, const idxT ncols, const eT threshold)
+        : top_n{top_n},
+          threshold{threshold},
+          heaps(static_cast<size_t>(ncols) * top_n),
+          col_nset(ncols, 0) {}
+
+    /**
+     * \brief Offer the value `val` of row `i` to column `k`.
+     */
+    void push(const idxT k, const idxT i, const eT val) {
+        if (!(val > threshold) || top_n == 0) {
+            return;
+        }
+        const auto first = heaps.begin() + static_cast<size_t>(k) * top_n;
+        const Entry entry{val, i};
+        idxT& n_set = col_nset[k];
+        if (n_set < top_n) {
+            first[n_set++] = entry;
+            std::push_heap(first, first + n_set, ranks_above);
+        } else if (ranks_above(entry, first[0])) {
+            std::pop_heap(first, first + n_set, ranks_above);
+            first[n_set - 1] = entry;
+            std::push_heap(first, first + n_set, ranks_above);
+        }
+    }
+
+    /**
+     * \brief Offer the entries of column `k` of `other` to column `k`.
+     */
+    void merge(const idxT k, const ColumnTopN& other) {
+        const auto first
+            = other.heaps.begin() + static_cast<size_t>(k) * top_n;
+        for (idxT ii = 0; ii < other.col_nset[k]; ++ii) {
+            push(k, first[ii].row, first[ii].val);
+        }
+    }
+
+    /**
+     * \brief Whether row `i` is in the top n of column `k`.
+     */
+    [[nodiscard]] bool contains(const idxT k, const idxT i) const {
+        const auto first = heaps.begin() + static_cast<size_t>(k) * top_n;
+        return std::any_of(first, first + col_nset[k], [i](const Entry& e) {
+            return e.row == i;
+        });
+    }
+
+    /**
+     * \brief Call `func(i, val)` for the entries of column `k`.
+     */
+    template <typename Func>
+    void for_each(const idxT k, Func&& func) const {
+        const auto first = heaps.begin() + static_cast<size_t>(k) * top_n;
+        for (idxT ii = 0; ii < col_nset[k]; ++ii) {
+            func(first[ii].row, first[ii].val);
+        }
+    }
+};
+
+/**
+ * \brief Compute row `i` of A.dot(B), keep the top n in `max_heap` and offer
+ * every value to the column top n.
+ *
+ * \details `next` and `sums` are the scratch arrays of length `ncols`, they
+ * must be initialised with -1 and 0 respectively and are reset on return.
+ * `col_topn` is a nullptr when only the row top n is required.
+ *
+ * \returns the number of values retained in the heap
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline idxT sp_matmul_topn_mutual_row(
+    const idxT i,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices,
+    std::vector<idxT>& next,
+    std::vector<eT>& sums,
+    MaxHeap<eT, idxT>& max_heap,
+    ColumnTopN<eT, idxT>* col_topn
+) {
+    idxT head = -2;
+    idxT length = 0;
+    sp_matmul_accumulate_row<eT, idxT, ptrT>(
+        i,
+        A_data,
+        A_indptr,
+        A_indices,
+        B_data,
+        B_indptr,
+        B_indices,
+        next,
+        sums,
+        head,
+        length
+    );
+    return sp_matmul_topn_drain<idxT, sort_order, PlusTimes<eT>>(
+        head,
+        length,
+        next,
+        sums,
+        max_heap,
+        [&](const idxT k, const eT val) {
+            if (col_topn) {
+                col_topn->push(k, i, val);
+            }
+            return val;
+        }
+    );
+}
+
+/**
+ * \brief Assemble C from the row slots and the column top n.
+ *
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_mutual_collect(
+    const MutualMode mode,
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    eT* values,
+    idxT* indices,
+    idxT* row_nset,
+    const ColumnTopN<eT, idxT>& col_topn
+) {
+    if (mode == MutualMode::column) {
+        // scatter the columns over the rows, the column indices of each row
+        // are increasing
+        auto C_indptr = std::unique_ptr<ptrT[]>(new ptrT[nrows + 1]);
+        std::fill(C_indptr.get(), C_indptr.get() + nrows + 1, ptrT(0));
+        for (idxT k = 0; k < ncols; ++k) {
+            col_topn.for_each(k, [&](const idxT i, const eT) {
+                C_indptr[i + 1]++;
+            });
+        }
+        std::partial_sum(
+            C_indptr.get(), C_indptr.get() + nrows + 1, C_indptr.get()
+        );
+        const auto nnz = static_cast<size_t>(C_indptr[nrows]);
+        auto C_data = std::unique_ptr<eT[]>(new eT[nnz]);
+        auto C_indices = std::unique_ptr<idxT[]>(new idxT[nnz]);
+        std::vector<ptrT> fill(C_indptr.get(), C_indptr.get() + nrows);
+        for (idxT k = 0; k < ncols; ++k) {
+            col_topn.for_each(k, [&](const idxT i, const eT val) {
+                const ptrT dst = fill[i]++;
+                C_indices[dst] = k;
+                C_data[dst] = val;
+            });
+        }
+        return {nnz, C_data.release(), C_indices.release(), C_indptr.release()};
+    }
+
+    if (mode == MutualMode::mutual) {
+        // compact the slots to the elements also in the column top n
+        for (idxT i = 0; i < nrows; ++i) {
+            const size_t offset = static_cast<size_t>(i) * top_n;
+            idxT n_keep = 0;
+            for (idxT ii = 0; ii < row_nset[i]; ++ii) {
+                if (col_topn.contains(indices[offset + ii], i)) {
+                    indices[offset + n_keep] = indices[offset + ii];
+                    values[offset + n_keep] = values[offset + ii];
+                    n_keep++;
+                }
+            }
+            row_nset[i] = n_keep;
+        }
+    }
+    return sp_matmul_topn_compact<eT, idxT, ptrT>(
+        top_n, nrows, values, indices, row_nset
+    );
+}
+
+/**
+ * \brief Compute the row, column or mutual top n of A.dot(B).
+ *
+ * \details A single pass over A.dot(B) keeps both the top n of each row and
+ * the top n of each column, see `MutualMode` for the returned elements.
+ * The column top n requires `ncols * top_n` elements of memory.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] mode the top n to return
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] threshold minimum values required to store
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_mutual(
+    const MutualMode mode,
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices
+) {
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    // the row top n does not need the column top n
+    const bool with_columns = mode != MutualMode::row;
+    auto col_topn
+        = ColumnTopN<eT, idxT>(with_columns ? top_n : 0, ncols, threshold);
+
+    std::vector<idxT> next(ncols, -1);
+    std::vector<eT> sums(ncols, 0);
+    auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+    for (idxT i = 0; i < nrows; ++i) {
+        const size_t offset = static_cast<size_t>(i) * top_n;
+        idxT n_set = sp_matmul_topn_mutual_row<eT, idxT, ptrT, sort_order>(
+            i,
+            A_data,
+            A_indptr,
+            A_indices,
+            B_data,
+            B_indptr,
+            B_indices,
+            next,
+            sums,
+            max_heap,
+            with_columns ? &col_topn : nullptr
+        );
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            indices[offset + ii] = max_heap.heap[ii].idx;
+            values[offset + ii] = max_heap.heap[ii].val;
+        }
+        row_nset[i] = n_set;
+    }
+    return sp_matmul_topn_mutual_collect<eT, idxT, ptrT>(
+        mode,
+        top_n,
+        nrows,
+        ncols,
+        values.get(),
+        indices.get(),
+        row_nset.get(),
+        col_topn
+    );
+}
+
+#if defined(SDTN_OMP_ENABLED)
+/**
+ * \brief Compute the row, column or mutual top n of A.dot(B) using
+ * `n_threads`.
+ *
+ * \details Every thread keeps the column top n of the rows it processed, the
+ * per thread column top n are merged column-wise in parallel afterwards.
+ * This requires `n_threads * ncols * top_n` elements of memory.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ * \param[in] mode the top n to return
+ * \param[in] top_n the top n values to store
+ * \param[in] nrows the number of rows in A
+ * \param[in] ncols the number of columns in B
+ * \param[in] threshold minimum values required to store
+ * \param[in] n_threads number of threads to use
+ * \param[in] A_data the nonzero elements of A
+ * \param[in] A_indptr array containing the row indices for `A_data`
+ * \param[in] A_indices array containing the column indices
+ * \param[in] B_data the nonzero elements of B
+ * \param[in] B_indptr array containing the row indices for `B_data`
+ * \param[in] B_indices array containing the column indices
+ * \returns tuple of the number of nonzero elements, C_data, C_indices and
+ * C_indptr where the arrays have been allocated with `new[]`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    SortOrder sort_order,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+inline std::tuple<size_t, eT*, idxT*, ptrT*> sp_matmul_topn_mutual_mt(
+    const MutualMode mode,
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    const eT threshold,
+    const int n_threads,
+    const eT* __restrict A_data,
+    const ptrT* __restrict A_indptr,
+    const idxT* __restrict A_indices,
+    const eT* __restrict B_data,
+    const ptrT* __restrict B_indptr,
+    const idxT* __restrict B_indices
+) {
+    const size_t n_slots = static_cast<size_t>(nrows) * top_n;
+    auto values = std::unique_ptr<eT[]>(new eT[n_slots]);
+    auto indices = std::unique_ptr<idxT[]>(new idxT[n_slots]);
+    auto row_nset = std::unique_ptr<idxT[]>(new idxT[nrows]);
+    // the row top n does not need the column top n
+    const int n_col_topn = mode == MutualMode::row ? 1 : n_threads;
+    std::vector<ColumnTopN<eT, idxT>> col_topn;
+    col_topn.reserve(n_col_topn);
+    for (int t = 0; t < n_col_topn; ++t) {
+        col_topn.emplace_back(
+            mode == MutualMode::row ? 0 : top_n, ncols, threshold
+        );
+    }
+
+#pragma omp parallel num_threads(n_threads)
+    {
+        const int tid = omp_get_thread_num();
+        auto* local_col_topn
+            = mode == MutualMode::row ? nullptr : &col_topn[tid];
+        std::vector<idxT> next(ncols, -1);
+        std::vector<eT> sums(ncols, 0);
+        auto max_heap = MaxHeap<eT, idxT>(top_n, threshold);
+
+#pragma omp for schedule(dynamic, 64)
+        for (idxT i = 0; i < nrows; ++i) {
+            const size_t offset = static_cast<size_t>(i) * top_n;
+            idxT n_set = sp_matmul_topn_mutual_row<eT, idxT, ptrT, sort_order>(
+                i,
+                A_data,
+                A_indptr,
+                A_indices,
+                B_data,
+                B_indptr,
+                B_indices,
+                next,
+                sums,
+                max_heap,
+                local_col_topn
+            );
+            for (idxT ii = 0; ii < n_set; ++ii) {
+                indices[offset + ii] = max_heap.heap[ii].idx;
+                values[offset + ii] = max_heap.heap[ii].val;
+            }
+            row_nset[i] = n_set;
+        }
+
+        // merge the column top n of the threads into the first
+#pragma omp for schedule(static)
+        for (idxT k = 0; k < ncols; ++k) {
+            for (int t = 1; t < n_col_topn; ++t) {
+                col_topn[0].merge(k, col_topn[t]);
+            }
+        }
+    }  // #pragma omp parallel
+
+    return sp_matmul_topn_mutual_collect<eT, idxT, ptrT>(
+        mode,
+        top_n,
+        nrows,
+        ncols,
+        values.get(),
+        indices.get(),
+        row_nset.get(),
+        col_topn[0]
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::core
@@ -0,0 +1,181 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/string.h>
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sparse_dot_topn/common_bindings.hpp>
+#include <sparse_dot_topn/semiring.hpp>
+#include <sparse_dot_topn/sp_matmul_topn.hpp>
+
+namespace sdtn {
+
+namespace nb = nanobind;
+
+namespace api {
+
+/**
+ * \brief Call `func` with the `type_tag` of the semiring named `semiring`.
+ *
+ * \tparam eT the element type
+ * \param[in] semiring the name of the semiring
+ * \param[in] func generic callable taking a `type_tag`
+ */
+template <typename eT, typename Func>
+inline decltype(auto) visit_semiring(const std::string& semiring, Func&& func) {
+    if (semiring == "plus_times") {
+        return func(type_tag<core::PlusTimes<eT>>{});
+    } else if (semiring == "max_times") {
+        return func(type_tag<core::MaxTimes<eT>>{});
+    } else if (semiring == "min_plus") {
+        return func(type_tag<core::MinPlus<eT>>{});
+    } else if (semiring == "plus_min") {
+        return func(type_tag<core::PlusMin<eT>>{});
+    }
+    throw std::invalid_argument(
+        "`semiring` must be one of {'plus_times', 'max_times', 'min_plus', "
+        "'plus_min'}, got: "
+        + semiring
+    );
+}
+
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_semiring(
+    const std::string& semiring,
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices
+) {
+    const size_t result_size = core::sp_matmul_topn_size(
+        top_n, nrows, A_indptr.data(), A_indices.data(), B_indptr.data()
+    );
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    std::vector<eT> C_data;
+    C_data.reserve(result_size);
+    std::vector<idxT> C_indices;
+    C_indices.reserve(result_size);
+    std::vector<ptrT> C_indptr(nrows + 1);
+    visit_semiring<eT>(semiring, [&](auto tag) {
+        using Semiring = typename decltype(tag)::type;
+        core::sp_matmul_topn<eT, idxT, ptrT, sort_order, Semiring>(
+            top_n,
+            nrows,
+            ncols,
+            local_threshold,
+            A_data.data(),
+            A_indptr.data(),
+            A_indices.data(),
+            B_data.data(),
+            B_indptr.data(),
+            B_indices.data(),
+            C_data,
+            C_indptr,
+            C_indices
+        );
+    });
+    C_data.shrink_to_fit();
+    C_indices.shrink_to_fit();
+    return nb::make_tuple(
+        to_nbvec<eT>(std::move(C_data)),
+        to_nbvec<idxT>(std::move(C_indices)),
+        to_nbvec<ptrT>(std::move(C_indptr))
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::SortOrder sort_order,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+inline nb::tuple sp_matmul_topn_semiring_mt(
+    const std::string& semiring,
+    const idxT top_n,
+    const idxT nrows,
+    const idxT ncols,
+    std::optional<eT> threshold,
+    const int n_threads,
+    const nb_vec<eT>& A_data,
+    const nb_vec<ptrT>& A_indptr,
+    const nb_vec<idxT>& A_indices,
+    const nb_vec<eT>& B_data,
+    const nb_vec<ptrT>& B_indptr,
+    const nb_vec<idxT>& B_indices
+) {
+    eT local_threshold = threshold.value_or(std::numeric_limits<eT>::min());
+    auto [total_nonzero, C_data, C_indices, C_indptr]
+        = visit_semiring<eT>(semiring, [&](auto tag) {
+              using Semiring = typename decltype(tag)::type;
+              return core::
+                  sp_matmul_topn_mt<eT, idxT, ptrT, sort_order, Semiring>(
+                      top_n,
+                      nrows,
+                      ncols,
+                      local_threshold,
+                      n_threads,
+                      A_data.data(),
+                      A_indptr.data(),
+                      A_indices.data(),
+                      B_data.data(),
+                      B_indptr.data(),
+                      B_indices.data()
+                  );
+          });
+    return nb::make_tuple(
+        to_nbvec<eT>(C_data, total_nonzero),
+        to_nbvec<idxT>(C_indices, total_nonzero),
+        to_nbvec<ptrT>(C_indptr, nrows + 1)
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace api
+
+namespace bindings {
+
+void bind_sp_matmul_topn_semiring(nb::module_& m);
+void bind_sp_matmul_topn_semiring_sorted(nb::module_& m);
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_semiring_mt(nb::module_& m);
+void bind_sp_matmul_topn_semiring_sorted_mt(nb::module_& m);
+#endif  // SDTN_OMP_ENABLED
+}  // namespace bindings
+}  // namespace sdtn
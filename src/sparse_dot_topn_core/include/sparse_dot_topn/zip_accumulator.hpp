@@ -0,0 +1,216 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/maxheap.hpp>
+
+namespace sdtn::core {
+
+/**
+ * \brief Incrementally zip C = zip_j C_j = zip_j A.dot(B_j) keeping only the
+ * top-n of the zipped results.
+ *
+ * \details The accumulator retains a slot of `top_n` values per row of C. Each
+ * sub-matrix `C_j` is merged into the slots when it is added after which it is
+ * no longer referenced, such that only a single `C_j` has to be in memory at
+ * a time. The column indices of `C_j` are offset by the number of columns of
+ * the sub-matrices that were added before it. The slots are kept sorted such
+ * that the first value of each row is the largest.
+ *
+ * \tparam eT   element type of the matrices
+ * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
+class ZipAccumulator {
+    idxT top_n;
+    idxT nrows;
+    idxT ncols = 0;
+    std::vector<eT> values;
+    std::vector<idxT> indices;
+    std::vector<idxT> row_nset;
+
+    /**
+     * \brief Merge row `i` of `C_j` into the slot of row `i`.
+     *
+     * \details Consistent with `zip_sp_matmul_topn` the elements of the
+     * sub-matrix added last are inserted first.
+     */
+    void merge_row(
+        MaxHeap<eT, idxT>& max_heap,
+        const idxT i,
+        const eT* __restrict C_data,
+        const ptrT* __restrict C_indptr,
+        const idxT* __restrict C_indices
+    ) {
+        eT min = max_heap.reset();
+        for (ptrT k = C_indptr[i]; k < C_indptr[i + 1]; ++k) {
+            eT val = C_data[k];
+            if (val > min) {
+                min = max_heap.push_pop(ncols + C_indices[k], val);
+            }
+        }
+        const size_t slot = static_cast<size_t>(i) * top_n;
+        for (idxT k = 0; k < row_nset[i]; ++k) {
+            eT val = values[slot + k];
+            if (val > min) {
+                min = max_heap.push_pop(indices[slot + k], val);
+            }
+        }
+
+        // sort the heap s.t. the first value is the largest
+        max_heap.value_sort();
+        const idxT n_set = max_heap.get_n_set();
+        for (idxT k = 0; k < n_set; ++k) {
+            values[slot + k] = max_heap.heap[k].val;
+            indices[slot + k] = max_heap.heap[k].idx;
+        }
+        row_nset[i] = n_set;
+    }
+
+ public:
+    /**
+     * \brief Instantiate the accumulator.
+     *
+     * \param top_n the top n values to store
+     * \param nrows the number of rows in A
+     */
+    ZipAccumulator(const idxT top_n, const idxT nrows)
+        : top_n{top_n},
+          nrows{nrows},
+          values(static_cast<size_t>(nrows) * top_n),
+          indices(static_cast<size_t>(nrows) * top_n),
+          row_nset(nrows, idxT(0)) {}
+
+    [[nodiscard]] idxT get_nrows() const { return nrows; }
+
+    [[nodiscard]] idxT get_ncols() const { return ncols; }
+
+    /**
+     * \brief Number of nonzero elements currently retained.
+     */
+    [[nodiscard]] size_t get_nnz() const {
+        return std::accumulate(row_nset.begin(), row_nset.end(), size_t{0});
+    }
+
+    /**
+     * \brief Merge the sub-matrix `C_j` = A.dot(B_j).
+     *
+     * \param[in] C_ncols the number of columns of C_j
+     * \param[in] C_data the nonzero elements of C_j
+     * \param[in] C_indptr array containing the row indices for `C_data`
+     * \param[in] C_indices array containing the column indices of C_j
+     */
+    void add(
+        const idxT C_ncols,
+        const eT* __restrict C_data,
+        const ptrT* __restrict C_indptr,
+        const idxT* __restrict C_indices
+    ) {
+        // threshold is already consistent between matrices, so accept every
+        // line.
+        auto max_heap
+            = MaxHeap<eT, idxT>(top_n, std::numeric_limits<eT>::min());
+        for (idxT i = 0; i < nrows; ++i) {
+            merge_row(max_heap, i, C_data, C_indptr, C_indices);
+        }
+        ncols += C_ncols;
+    }
+
+#if defined(SDTN_OMP_ENABLED)
+    /**
+     * \brief Merge the sub-matrix `C_j` = A.dot(B_j) using `n_threads`.
+     *
+     * \param[in] n_threads the number of threads to use
+     * \param[in] C_ncols the number of columns of C_j
+     * \param[in] C_data the nonzero elements of C_j
+     * \param[in] C_indptr array containing the row indices for `C_data`
+     * \param[in] C_indices array containing the column indices of C_j
+     */
+    void add_mt(
+        const int n_threads,
+        const idxT C_ncols,
+        const eT* __restrict C_data,
+        const ptrT* __restrict C_indptr,
+        const idxT* __restrict C_indices
+    ) {
+#pragma omp parallel num_threads(n_threads)
+        {
+            auto max_heap
+                = MaxHeap<eT, idxT>(top_n, std::numeric_limits<eT>::min());
+#pragma omp for schedule(dynamic, 64)
+            for (idxT i = 0; i < nrows; ++i) {
+                merge_row(max_heap, i, C_data, C_indptr, C_indices);
+            }
+        }
+        ncols += C_ncols;
+    }
+#endif  // SDTN_OMP_ENABLED
+
+    /**
+     * \brief Compact the slots into an exactly sized CSR matrix Z.
+     *
+     * \details The slots are released, the accumulator must not be used
+     * afterwards.
+     *
+     * \returns tuple of the number of nonzero elements, Z_data, Z_indices and
+     * Z_indptr where the arrays have been allocated with `new[]`
+     */
+    std::tuple<size_t, eT*, idxT*, ptrT*> finalize() {
+        auto Z_indptr = std::unique_ptr<ptrT[]>(new ptrT[nrows + 1]);
+        Z_indptr[0] = 0;
+        for (idxT i = 0; i < nrows; ++i) {
+            Z_indptr[i + 1] = Z_indptr[i] + static_cast<ptrT>(row_nset[i]);
+        }
+        const size_t nnz = static_cast<size_t>(Z_indptr[nrows]);
+        auto Z_data = std::unique_ptr<eT[]>(new eT[nnz]);
+        auto Z_indices = std::unique_ptr<idxT[]>(new idxT[nnz]);
+        for (idxT i = 0; i < nrows; ++i) {
+            const size_t slot = static_cast<size_t>(i) * top_n;
+            std::copy_n(
+                values.begin() + slot, row_nset[i], Z_data.get() + Z_indptr[i]
+            );
+            std::copy_n(
+                indices.begin() + slot,
+                row_nset[i],
+                Z_indices.get() + Z_indptr[i]
+            );
+        }
+        std::vector<eT>().swap(values);
+        std::vector<idxT>().swap(indices);
+        std::vector<idxT>().swap(row_nset);
+        return {
+            nnz, Z_data.release(), Z_indices.release(), Z_indptr.release()
+        };
+    }
+};
+
+}  // namespace sdtn::core
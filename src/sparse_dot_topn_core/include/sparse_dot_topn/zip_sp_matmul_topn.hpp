@@ -38,6 +38,8 @@ namespace sdtn::core {
  *
  * \tparam eT   element type of the matrices
  * \tparam idxT integer type of the index arrays, must be at least 32 bit int
+ * \tparam ptrT integer type of the index pointer arrays, must be at least as
+ * wide as `idxT`
  * \param[in] top_n the top n values to store
  * \param[in] nrowsA the number of rows in A
  * \param[in] ncolsB_vec the number of columns in each B_i sub-matrix
@@ -47,26 +49,30 @@ namespace sdtn::core {
  *     `C_data_j` sub-matrices
  * \param[in] C_indices_vec vector of arrays containing the column indices
        for the C_j sub-matrices
- * \param[out] Z_data the nonzero elements of zipped Z matrix
+ * \param[out] Z_data the nonzero elements of zipped Z matrix, appended to
  * \param[out] Z_indptr array containing the row indices for zipped `Z_data`
- * \param[out] Z_indices array containing the zipped column indices
+ * \param[out] Z_indices array containing the zipped column indices, appended
+ *     to
  */
-template <typename eT, typename idxT, iffInt<idxT> = true>
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    iffInt<idxT> = true,
+    iffInt<ptrT> = true>
 inline void zip_sp_matmul_topn(
     const idxT top_n,
     const idxT nrows,
     const idxT* B_ncols,
     const std::vector<const eT*>& C_data,
-    const std::vector<const idxT*>& C_indptrs,
+    const std::vector<const ptrT*>& C_indptrs,
     const std::vector<const idxT*>& C_indices,
-    eT* __restrict Z_data,
-    idxT* __restrict Z_indptr,
-    idxT* __restrict Z_indices
+    std::vector<eT>& Z_data,
+    ptrT* __restrict Z_indptr,
+    std::vector<idxT>& Z_indices
 ) {
-    idxT nnz = 0;
+    ptrT nnz = 0;
     Z_indptr[0] = 0;
-    eT* Z_data_head = Z_data;
-    idxT* Z_indices_head = Z_indices;
     const int n_mat = C_data.size();
 
     // threshold is already consistent between matrices, so accept every line.
@@ -88,9 +94,9 @@ inline void zip_sp_matmul_topn(
         // keep topn of stacked lines for each row insert in reverse order,
         // similar to the reverse linked list in sp_matmul_topn
         for (int j = n_mat - 1; j >= 0; --j) {
-            const idxT* C_indptr_j = C_indptrs[j];
+            const ptrT* C_indptr_j = C_indptrs[j];
             const idxT* C_indices_j = C_indices[j];
-            for (idxT k = C_indptr_j[i]; k < C_indptr_j[i + 1]; ++k) {
+            for (ptrT k = C_indptr_j[i]; k < C_indptr_j[i + 1]; ++k) {
                 eT val = (C_data[j])[k];
                 if (val > min) {
                     min = max_heap.push_pop(offset[j] + C_indices_j[k], val);
@@ -102,12 +108,10 @@ inline void zip_sp_matmul_topn(
         max_heap.value_sort();
 
         // fill the zipped sparse matrix Z
-        int n_set = max_heap.get_n_set();
-        for (int ii = 0; ii < n_set; ++ii) {
-            *Z_indices_head = max_heap.heap[ii].idx;
-            *Z_data_head = max_heap.heap[ii].val;
-            Z_indices_head++;
-            Z_data_head++;
+        idxT n_set = max_heap.get_n_set();
+        for (idxT ii = 0; ii < n_set; ++ii) {
+            Z_indices.push_back(max_heap.heap[ii].idx);
+            Z_data.push_back(max_heap.heap[ii].val);
         }
         nnz += n_set;
         Z_indptr[i + 1] = nnz;
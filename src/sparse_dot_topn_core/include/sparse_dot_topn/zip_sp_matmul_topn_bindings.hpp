@@ -22,10 +22,12 @@
 
 #include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <vector>
 
-#include <sparse_dot_topn/common.hpp>
+#include <sparse_dot_topn/common_bindings.hpp>
 #include <sparse_dot_topn/maxheap.hpp>
+#include <sparse_dot_topn/zip_accumulator.hpp>
 #include <sparse_dot_topn/zip_sp_matmul_topn.hpp>
 
 namespace sdtn {
@@ -33,20 +35,25 @@ namespace nb = nanobind;
 
 namespace api {
 
-template <typename eT, typename idxT, core::iffInt<idxT> = true>
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
 inline nb::tuple zip_sp_matmul_topn(
     const int top_n,
-    const idxT Z_max_nnz,
+    const ptrT Z_max_nnz,
     const idxT nrows,
     const nb_vec<idxT>& B_ncols,
     const std::vector<nb_vec<eT>>& data,
-    const std::vector<nb_vec<idxT>>& indptr,
+    const std::vector<nb_vec<ptrT>>& indptr,
     const std::vector<nb_vec<idxT>>& indices
 ) {
     const int n_mats = B_ncols.size();
     std::vector<const eT*> data_ptrs;
     data_ptrs.reserve(n_mats);
-    std::vector<const idxT*> indptr_ptrs;
+    std::vector<const ptrT*> indptr_ptrs;
     indptr_ptrs.reserve(n_mats);
     std::vector<const idxT*> indices_ptrs;
     indices_ptrs.reserve(n_mats);
@@ -57,32 +64,126 @@ inline nb::tuple zip_sp_matmul_topn(
         indices_ptrs.push_back(indices[i].data());
     }
 
-    auto Z_indptr = std::unique_ptr<idxT[]>(new idxT[nrows + 1]);
-    auto Z_indices = std::unique_ptr<idxT>(new idxT[Z_max_nnz]);
-    auto Z_data = std::unique_ptr<eT>(new eT[Z_max_nnz]);
+    // `Z_max_nnz` is an upper bound on the nnz of Z that is only used as
+    // capacity hint, Z is returned exactly sized
+    auto Z_indptr = std::unique_ptr<ptrT[]>(new ptrT[nrows + 1]);
+    std::vector<eT> Z_data;
+    Z_data.reserve(Z_max_nnz);
+    std::vector<idxT> Z_indices;
+    Z_indices.reserve(Z_max_nnz);
 
-    core::zip_sp_matmul_topn<eT, idxT>(
+    core::zip_sp_matmul_topn<eT, idxT, ptrT>(
         top_n,
         nrows,
         B_ncols.data(),
         data_ptrs,
         indptr_ptrs,
         indices_ptrs,
-        Z_data.get(),
+        Z_data,
         Z_indptr.get(),
-        Z_indices.get()
+        Z_indices
     );
+    Z_data.shrink_to_fit();
+    Z_indices.shrink_to_fit();
 
     return nb::make_tuple(
-        to_nbvec<eT>(Z_data.release(), Z_max_nnz),
-        to_nbvec<idxT>(Z_indices.release(), Z_max_nnz),
-        to_nbvec<idxT>(Z_indptr.release(), nrows + 1)
+        to_nbvec<eT>(std::move(Z_data)),
+        to_nbvec<idxT>(std::move(Z_indices)),
+        to_nbvec<ptrT>(Z_indptr.release(), nrows + 1)
     );
 }
+
+/**
+ * \brief Python facing wrapper around `core::ZipAccumulator`.
+ *
+ * \details Validates the sub-matrices before they are merged and guards
+ * against use after `finalize`.
+ */
+template <
+    typename eT,
+    typename idxT,
+    typename ptrT,
+    core::iffInt<idxT> = true,
+    core::iffInt<ptrT> = true>
+class ZipAccumulator {
+    core::ZipAccumulator<eT, idxT, ptrT> acc;
+    bool finalized = false;
+
+    void check_chunk(
+        const nb_vec<eT>& data,
+        const nb_vec<ptrT>& indptr,
+        const nb_vec<idxT>& indices
+    ) const {
+        if (finalized) {
+            throw std::runtime_error("the accumulator has been finalized");
+        }
+        if (indptr.size() != static_cast<size_t>(acc.get_nrows()) + 1) {
+            throw std::invalid_argument(
+                "`indptr` must have `nrows + 1` elements"
+            );
+        }
+        const auto nnz = static_cast<size_t>(indptr.data()[acc.get_nrows()]);
+        if (data.size() < nnz || indices.size() < nnz) {
+            throw std::invalid_argument(
+                "`data` and `indices` must have at least `indptr[-1]` elements"
+            );
+        }
+    }
+
+ public:
+    ZipAccumulator(const idxT top_n, const idxT nrows) : acc(top_n, nrows) {}
+
+    [[nodiscard]] idxT nrows() const { return acc.get_nrows(); }
+
+    [[nodiscard]] idxT ncols() const { return acc.get_ncols(); }
+
+    [[nodiscard]] size_t nnz() const { return acc.get_nnz(); }
+
+    void add(
+        const idxT ncols,
+        const nb_vec<eT>& data,
+        const nb_vec<ptrT>& indptr,
+        const nb_vec<idxT>& indices
+    ) {
+        check_chunk(data, indptr, indices);
+        acc.add(ncols, data.data(), indptr.data(), indices.data());
+    }
+
+#if defined(SDTN_OMP_ENABLED)
+    void add_mt(
+        const int n_threads,
+        const idxT ncols,
+        const nb_vec<eT>& data,
+        const nb_vec<ptrT>& indptr,
+        const nb_vec<idxT>& indices
+    ) {
+        check_chunk(data, indptr, indices);
+        acc.add_mt(
+            n_threads, ncols, data.data(), indptr.data(), indices.data()
+        );
+    }
+#endif  // SDTN_OMP_ENABLED
+
+    nb::tuple finalize() {
+        if (finalized) {
+            throw std::runtime_error("the accumulator has been finalized");
+        }
+        finalized = true;
+        const idxT nrows = acc.get_nrows();
+        auto [nnz, Z_data, Z_indices, Z_indptr] = acc.finalize();
+        return nb::make_tuple(
+            to_nbvec<eT>(Z_data, nnz),
+            to_nbvec<idxT>(Z_indices, nnz),
+            to_nbvec<ptrT>(Z_indptr, nrows + 1)
+        );
+    }
+};
+
 }  //  namespace api
 
 namespace bindings {
 void bind_zip_sp_matmul_topn(nb::module_& m);
+void bind_zip_accumulator(nb::module_& m);
 }
 
 }  // namespace sdtn
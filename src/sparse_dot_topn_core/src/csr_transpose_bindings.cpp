@@ -0,0 +1,296 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <sparse_dot_topn/csr_transpose.hpp>
+#include <sparse_dot_topn/csr_transpose_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_csr_transpose(nb::module_& m) {
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<double, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Transpose a CSR matrix, equivalent to converting it to CSC.\n"
+            "\n"
+            "Args:\n"
+            "    nrows (int): the number of rows in `M`\n"
+            "    ncols (int): the number of columns in `M`\n"
+            "    M_data (NDArray[int | float]): the non-zero elements of M\n"
+            "    M_indptr (NDArray[int]): the row indices for `M_data`\n"
+            "    M_indices (NDArray[int]): the column indices for `M_data`\n"
+            "\n"
+            "Returns:\n"
+            "    T_data (NDArray[int | float]): the non-zero elements of M.T\n"
+            "    T_indices (NDArray[int]): the column indices for `T_data`\n"
+            "    T_indptr (NDArray[int]): the row indices for `T_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<float, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<double, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<float, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<int, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<int64_t, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<int, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<int64_t, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<double, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<float, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<int, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose",
+        &api::csr_transpose<int64_t, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+}
+
+#if defined(SDTN_OMP_ENABLED)
+void bind_csr_transpose_mt(nb::module_& m) {
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<double, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Transpose a CSR matrix, equivalent to converting it to CSC.\n"
+            "\n"
+            "Args:\n"
+            "    nrows (int): the number of rows in `M`\n"
+            "    ncols (int): the number of columns in `M`\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    M_data (NDArray[int | float]): the non-zero elements of M\n"
+            "    M_indptr (NDArray[int]): the row indices for `M_data`\n"
+            "    M_indices (NDArray[int]): the column indices for `M_data`\n"
+            "\n"
+            "Returns:\n"
+            "    T_data (NDArray[int | float]): the non-zero elements of M.T\n"
+            "    T_indices (NDArray[int]): the column indices for `T_data`\n"
+            "    T_indptr (NDArray[int]): the row indices for `T_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<float, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<double, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<float, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<int, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<int64_t, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<int, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<int64_t, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<double, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<float, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<int, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+    m.def(
+        "csr_transpose_mt",
+        &api::csr_transpose_mt<int64_t, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "M_data"_a.noconvert(),
+        "M_indptr"_a.noconvert(),
+        "M_indices"_a.noconvert()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::bindings
@@ -15,21 +15,98 @@
  * limitations under the License.
  */
 #include <nanobind/nanobind.h>
+#include <sparse_dot_topn/csr_transpose_bindings.hpp>
+#include <sparse_dot_topn/ngram_tfidf_bindings.hpp>
 #include <sparse_dot_topn/sp_matmul_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_masked_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_pairs_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_threshold_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_approx_bindings.hpp>
 #include <sparse_dot_topn/sp_matmul_topn_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_chain_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_components_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_coo_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_dense_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_dtype_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_fields_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_hybrid_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_mutual_bindings.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_semiring_bindings.hpp>
 #include <sparse_dot_topn/zip_sp_matmul_topn_bindings.hpp>
 
 namespace sdtn::bindings {
 
 NB_MODULE(_sparse_dot_topn_core, m) {
+    bind_csr_transpose(m);
     bind_sp_matmul(m);
+    bind_sp_matmul_canonical(m);
     bind_sp_matmul_topn(m);
     bind_sp_matmul_topn_sorted(m);
+    bind_sp_matmul_topn_canonical(m);
+    bind_sp_matmul_topn_coo(m);
+    bind_sp_matmul_topn_sorted_coo(m);
+    bind_sp_matmul_topn_dtype(m);
+    bind_sp_matmul_topn_dtype_sorted(m);
+    bind_sp_matmul_topn_dtype_canonical(m);
+    bind_sp_matmul_topn_approx(m);
+    bind_sp_matmul_topn_approx_sorted(m);
+    bind_sp_matmul_threshold(m);
+    bind_sp_matmul_topn_mutual(m);
+    bind_sp_matmul_topn_mutual_sorted(m);
+    bind_sp_matmul_topn_components(m);
+    bind_sp_matmul_topn_semiring(m);
+    bind_sp_matmul_topn_semiring_sorted(m);
+    bind_sp_matmul_topn_fields(m);
+    bind_sp_matmul_topn_fields_sorted(m);
+    bind_sp_matmul_topn_chain(m);
+    bind_sp_matmul_topn_chain_sorted(m);
+    bind_sp_matmul_masked(m);
+    bind_sp_matmul_topn_masked(m);
+    bind_sp_matmul_topn_masked_sorted(m);
+    bind_sp_matmul_pairs(m);
+    bind_dense_matmul_topn(m);
+    bind_dense_matmul_topn_sorted(m);
+    bind_sparse_dense_matmul_topn(m);
+    bind_sparse_dense_matmul_topn_sorted(m);
+    bind_sp_matmul_topn_hybrid(m);
+    bind_sp_matmul_topn_hybrid_sorted(m);
     bind_zip_sp_matmul_topn(m);
+    bind_zip_accumulator(m);
+    bind_ngram_tfidf(m);
 #ifdef SDTN_OMP_ENABLED
+    bind_csr_transpose_mt(m);
     bind_sp_matmul_mt(m);
+    bind_sp_matmul_canonical_mt(m);
     bind_sp_matmul_topn_mt(m);
     bind_sp_matmul_topn_sorted_mt(m);
+    bind_sp_matmul_topn_canonical_mt(m);
+    bind_sp_matmul_topn_coo_mt(m);
+    bind_sp_matmul_topn_sorted_coo_mt(m);
+    bind_sp_matmul_topn_dtype_mt(m);
+    bind_sp_matmul_topn_dtype_sorted_mt(m);
+    bind_sp_matmul_topn_dtype_canonical_mt(m);
+    bind_sp_matmul_topn_approx_mt(m);
+    bind_sp_matmul_topn_approx_sorted_mt(m);
+    bind_sp_matmul_threshold_mt(m);
+    bind_sp_matmul_topn_mutual_mt(m);
+    bind_sp_matmul_topn_mutual_sorted_mt(m);
+    bind_sp_matmul_topn_components_mt(m);
+    bind_sp_matmul_topn_semiring_mt(m);
+    bind_sp_matmul_topn_semiring_sorted_mt(m);
+    bind_sp_matmul_topn_fields_mt(m);
+    bind_sp_matmul_topn_fields_sorted_mt(m);
+    bind_sp_matmul_topn_chain_mt(m);
+    bind_sp_matmul_topn_chain_sorted_mt(m);
+    bind_sp_matmul_masked_mt(m);
+    bind_sp_matmul_topn_masked_mt(m);
+    bind_sp_matmul_topn_masked_sorted_mt(m);
+    bind_sp_matmul_pairs_mt(m);
+    bind_dense_matmul_topn_mt(m);
+    bind_dense_matmul_topn_sorted_mt(m);
+    bind_sparse_dense_matmul_topn_mt(m);
+    bind_sparse_dense_matmul_topn_sorted_mt(m);
+    bind_sp_matmul_topn_hybrid_mt(m);
+    bind_sp_matmul_topn_hybrid_sorted_mt(m);
     m.attr("_has_openmp_support") = true;
 #else
     m.attr("_has_openmp_support") = false;
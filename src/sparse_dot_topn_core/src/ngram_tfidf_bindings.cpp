@@ -0,0 +1,158 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <sparse_dot_topn/ngram_tfidf.hpp>
+#include <sparse_dot_topn/ngram_tfidf_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_ngram_tfidf(nb::module_& m) {
+    m.def(
+        "ngram_vocabulary",
+        &api::ngram_vocabulary,
+        "n"_a,
+        "n_threads"_a,
+        "docs_data"_a.noconvert(),
+        "docs_offsets"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the sorted unique character n-grams of the documents.\n"
+            "\n"
+            "Args:\n"
+            "    n (int): the number of characters per n-gram\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    docs_data (NDArray[uint8]): the UTF-8 encoded documents\n"
+            "    docs_offsets (NDArray[int64]): the offsets of the documents\n"
+            "\n"
+            "Returns:\n"
+            "    V_data (NDArray[uint8]): the UTF-8 encoded n-grams\n"
+            "    V_offsets (NDArray[int64]): the offsets of the n-grams\n"
+            "\n"
+        )
+    );
+    m.def(
+        "ngram_tfidf_float64_int32_int32",
+        &api::ngram_tfidf<double, int, int>,
+        "n"_a,
+        "n_features"_a,
+        "sublinear_tf"_a,
+        "idf"_a.none(),
+        "normalize"_a,
+        "n_threads"_a,
+        "docs_data"_a.noconvert(),
+        "docs_offsets"_a.noconvert(),
+        "vocab_data"_a.noconvert(),
+        "vocab_offsets"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the TF-IDF weighted character n-grams of the documents.\n"
+            "\n"
+            "Args:\n"
+            "    n (int): the number of characters per n-gram\n"
+            "    n_features (int): the number of hashed columns or 0\n"
+            "    sublinear_tf (bool): use `1 + log(tf)` as term frequency\n"
+            "    idf (NDArray[float] | None): the inverse document frequency\n"
+            "    normalize (bool): scale the rows to unit L2 norm\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    docs_data (NDArray[uint8]): the UTF-8 encoded documents\n"
+            "    docs_offsets (NDArray[int64]): the offsets of the documents\n"
+            "    vocab_data (NDArray[uint8]): the UTF-8 encoded vocabulary\n"
+            "    vocab_offsets (NDArray[int64]): the offsets of the n-grams\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "ngram_tfidf_float32_int32_int32",
+        &api::ngram_tfidf<float, int, int>,
+        "n"_a,
+        "n_features"_a,
+        "sublinear_tf"_a,
+        "idf"_a.none(),
+        "normalize"_a,
+        "n_threads"_a,
+        "docs_data"_a.noconvert(),
+        "docs_offsets"_a.noconvert(),
+        "vocab_data"_a.noconvert(),
+        "vocab_offsets"_a.noconvert()
+    );
+    m.def(
+        "ngram_tfidf_float64_int64_int64",
+        &api::ngram_tfidf<double, int64_t, int64_t>,
+        "n"_a,
+        "n_features"_a,
+        "sublinear_tf"_a,
+        "idf"_a.none(),
+        "normalize"_a,
+        "n_threads"_a,
+        "docs_data"_a.noconvert(),
+        "docs_offsets"_a.noconvert(),
+        "vocab_data"_a.noconvert(),
+        "vocab_offsets"_a.noconvert()
+    );
+    m.def(
+        "ngram_tfidf_float32_int64_int64",
+        &api::ngram_tfidf<float, int64_t, int64_t>,
+        "n"_a,
+        "n_features"_a,
+        "sublinear_tf"_a,
+        "idf"_a.none(),
+        "normalize"_a,
+        "n_threads"_a,
+        "docs_data"_a.noconvert(),
+        "docs_offsets"_a.noconvert(),
+        "vocab_data"_a.noconvert(),
+        "vocab_offsets"_a.noconvert()
+    );
+    m.def(
+        "ngram_tfidf_float64_int32_int64",
+        &api::ngram_tfidf<double, int, int64_t>,
+        "n"_a,
+        "n_features"_a,
+        "sublinear_tf"_a,
+        "idf"_a.none(),
+        "normalize"_a,
+        "n_threads"_a,
+        "docs_data"_a.noconvert(),
+        "docs_offsets"_a.noconvert(),
+        "vocab_data"_a.noconvert(),
+        "vocab_offsets"_a.noconvert()
+    );
+    m.def(
+        "ngram_tfidf_float32_int32_int64",
+        &api::ngram_tfidf<float, int, int64_t>,
+        "n"_a,
+        "n_features"_a,
+        "sublinear_tf"_a,
+        "idf"_a.none(),
+        "normalize"_a,
+        "n_threads"_a,
+        "docs_data"_a.noconvert(),
+        "docs_offsets"_a.noconvert(),
+        "vocab_data"_a.noconvert(),
+        "vocab_offsets"_a.noconvert()
+    );
+}
+
+}  // namespace sdtn::bindings
@@ -27,7 +27,7 @@ using namespace nb::literals;
 void bind_sp_matmul(nb::module_& m) {
     m.def(
         "sp_matmul",
-        &api::sp_matmul<double, int>,
+        &api::sp_matmul<double, int, int>,
         "nrows"_a,
         "ncols"_a,
         "A_data"_a.noconvert(),
@@ -58,7 +58,7 @@ void bind_sp_matmul(nb::module_& m) {
     );
     m.def(
         "sp_matmul",
-        &api::sp_matmul<float, int>,
+        &api::sp_matmul<float, int, int>,
         "nrows"_a,
         "ncols"_a,
         "A_data"_a.noconvert(),
@@ -70,7 +70,7 @@ void bind_sp_matmul(nb::module_& m) {
     );
     m.def(
         "sp_matmul",
-        &api::sp_matmul<double, int64_t>,
+        &api::sp_matmul<double, int64_t, int64_t>,
         "nrows"_a,
         "ncols"_a,
         "A_data"_a.noconvert(),
@@ -82,7 +82,7 @@ void bind_sp_matmul(nb::module_& m) {
     );
     m.def(
         "sp_matmul",
-        &api::sp_matmul<float, int64_t>,
+        &api::sp_matmul<float, int64_t, int64_t>,
         "nrows"_a,
         "ncols"_a,
         "A_data"_a.noconvert(),
@@ -94,7 +94,7 @@ void bind_sp_matmul(nb::module_& m) {
     );
     m.def(
         "sp_matmul",
-        &api::sp_matmul<int, int>,
+        &api::sp_matmul<int, int, int>,
         "nrows"_a,
         "ncols"_a,
         "A_data"_a.noconvert(),
@@ -106,7 +106,7 @@ void bind_sp_matmul(nb::module_& m) {
     );
     m.def(
         "sp_matmul",
-        &api::sp_matmul<int64_t, int>,
+        &api::sp_matmul<int64_t, int, int>,
         "nrows"_a,
         "ncols"_a,
         "A_data"_a.noconvert(),
@@ -118,7 +118,7 @@ void bind_sp_matmul(nb::module_& m) {
     );
     m.def(
         "sp_matmul",
-        &api::sp_matmul<int, int64_t>,
+        &api::sp_matmul<int, int64_t, int64_t>,
         "nrows"_a,
         "ncols"_a,
         "A_data"_a.noconvert(),
@@ -130,7 +130,221 @@ void bind_sp_matmul(nb::module_& m) {
     );
     m.def(
         "sp_matmul",
-        &api::sp_matmul<int64_t, int64_t>,
+        &api::sp_matmul<int64_t, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul",
+        &api::sp_matmul<double, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul",
+        &api::sp_matmul<float, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul",
+        &api::sp_matmul<int, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul",
+        &api::sp_matmul<int64_t, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_canonical(nb::module_& m) {
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<double, int, int, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute sparse dot product, sorted on column.\n"
+            "\n"
+            "Args:\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<float, int, int, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<double, int64_t, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<float, int64_t, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<int, int, int, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<int64_t, int, int, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<int, int64_t, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<int64_t, int64_t, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<double, int, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<float, int, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<int, int, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical",
+        &api::sp_matmul<int64_t, int, int64_t, true>,
         "nrows"_a,
         "ncols"_a,
         "A_data"_a.noconvert(),
@@ -146,7 +360,7 @@ void bind_sp_matmul(nb::module_& m) {
 void bind_sp_matmul_mt(nb::module_& m) {
     m.def(
         "sp_matmul_mt",
-        &api::sp_matmul_mt<double, int>,
+        &api::sp_matmul_mt<double, int, int>,
         "nrows"_a,
         "ncols"_a,
         "n_threads"_a,
@@ -178,7 +392,59 @@ void bind_sp_matmul_mt(nb::module_& m) {
     );
     m.def(
         "sp_matmul_mt",
-        &api::sp_matmul_mt<float, int>,
+        &api::sp_matmul_mt<float, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_mt",
+        &api::sp_matmul_mt<double, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_mt",
+        &api::sp_matmul_mt<float, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_mt",
+        &api::sp_matmul_mt<int, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_mt",
+        &api::sp_matmul_mt<int64_t, int, int>,
         "nrows"_a,
         "ncols"_a,
         "n_threads"_a,
@@ -191,7 +457,7 @@ void bind_sp_matmul_mt(nb::module_& m) {
     );
     m.def(
         "sp_matmul_mt",
-        &api::sp_matmul_mt<double, int64_t>,
+        &api::sp_matmul_mt<int, int64_t, int64_t>,
         "nrows"_a,
         "ncols"_a,
         "n_threads"_a,
@@ -204,7 +470,7 @@ void bind_sp_matmul_mt(nb::module_& m) {
     );
     m.def(
         "sp_matmul_mt",
-        &api::sp_matmul_mt<float, int64_t>,
+        &api::sp_matmul_mt<int64_t, int64_t, int64_t>,
         "nrows"_a,
         "ncols"_a,
         "n_threads"_a,
@@ -217,7 +483,7 @@ void bind_sp_matmul_mt(nb::module_& m) {
     );
     m.def(
         "sp_matmul_mt",
-        &api::sp_matmul_mt<int, int>,
+        &api::sp_matmul_mt<double, int, int64_t>,
         "nrows"_a,
         "ncols"_a,
         "n_threads"_a,
@@ -230,7 +496,7 @@ void bind_sp_matmul_mt(nb::module_& m) {
     );
     m.def(
         "sp_matmul_mt",
-        &api::sp_matmul_mt<int64_t, int>,
+        &api::sp_matmul_mt<float, int, int64_t>,
         "nrows"_a,
         "ncols"_a,
         "n_threads"_a,
@@ -243,7 +509,7 @@ void bind_sp_matmul_mt(nb::module_& m) {
     );
     m.def(
         "sp_matmul_mt",
-        &api::sp_matmul_mt<int, int64_t>,
+        &api::sp_matmul_mt<int, int, int64_t>,
         "nrows"_a,
         "ncols"_a,
         "n_threads"_a,
@@ -256,7 +522,185 @@ void bind_sp_matmul_mt(nb::module_& m) {
     );
     m.def(
         "sp_matmul_mt",
-        &api::sp_matmul_mt<int64_t, int64_t>,
+        &api::sp_matmul_mt<int64_t, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_canonical_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<double, int, int, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute sparse dot product, sorted on column.\n"
+            "\n"
+            "Args:\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<float, int, int, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<double, int64_t, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<float, int64_t, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<int, int, int, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<int64_t, int, int, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<int, int64_t, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<int64_t, int64_t, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<double, int, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<float, int, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<int, int, int64_t, true>,
+        "nrows"_a,
+        "ncols"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_canonical_mt",
+        &api::sp_matmul_mt<int64_t, int, int64_t, true>,
         "nrows"_a,
         "ncols"_a,
         "n_threads"_a,
@@ -0,0 +1,373 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <sparse_dot_topn/sp_matmul_pairs_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_sp_matmul_pairs(nb::module_& m) {
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<double, int, int>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the dot products of the rows of A and B for the given\n"
+            "pairs, i.e. the elements (rows[k], cols[k]) of A.dot(B.T).\n"
+            "The column indices of each row must be sorted and unique.\n"
+            "\n"
+            "Args:\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    rows (NDArray[int]): the rows of A of the pairs\n"
+            "    cols (NDArray[int]): the rows of B of the pairs\n"
+            "\n"
+            "Returns:\n"
+            "    values (NDArray[int | float]): the dot product of each pair\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<float, int, int>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<double, int64_t, int64_t>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<float, int64_t, int64_t>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<int, int, int>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<int64_t, int, int>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<int, int64_t, int64_t>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<int64_t, int64_t, int64_t>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<double, int, int64_t>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<float, int, int64_t>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<int, int, int64_t>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs",
+        &api::sp_matmul_pairs<int64_t, int, int64_t>,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_pairs_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<double, int, int>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the dot products of the rows of A and B for the given\n"
+            "pairs, i.e. the elements (rows[k], cols[k]) of A.dot(B.T).\n"
+            "The column indices of each row must be sorted and unique.\n"
+            "\n"
+            "Args:\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    rows (NDArray[int]): the rows of A of the pairs\n"
+            "    cols (NDArray[int]): the rows of B of the pairs\n"
+            "\n"
+            "Returns:\n"
+            "    values (NDArray[int | float]): the dot product of each pair\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<float, int, int>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<double, int64_t, int64_t>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<float, int64_t, int64_t>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<int, int, int>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<int64_t, int, int>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<int, int64_t, int64_t>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<int64_t, int64_t, int64_t>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<double, int, int64_t>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<float, int, int64_t>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<int, int, int64_t>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_pairs_mt",
+        &api::sp_matmul_pairs_mt<int64_t, int, int64_t>,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "rows"_a.noconvert(),
+        "cols"_a.noconvert()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::bindings
@@ -0,0 +1,429 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <sparse_dot_topn/sp_matmul_threshold.hpp>
+#include <sparse_dot_topn/sp_matmul_threshold_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_sp_matmul_threshold(nb::module_& m) {
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<double, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute all elements of the sparse dot product greater than the"
+            " threshold.\n"
+            "\n"
+            "Args:\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    A_ncols (int): the number of columns in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    Bt_data (NDArray[int | float]): the non-zero elements of B.T\n"
+            "    Bt_indptr (NDArray[int]): the row indices for `Bt_data`\n"
+            "    Bt_indices (NDArray[int]): the column indices for `Bt_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<float, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<double, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<float, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<int, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<int64_t, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<int, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<int64_t, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<double, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<float, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<int, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold",
+        &api::sp_matmul_threshold<int64_t, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_threshold_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<double, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute all elements of the sparse dot product greater than the"
+            " threshold.\n"
+            "\n"
+            "Args:\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    A_ncols (int): the number of columns in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    Bt_data (NDArray[int | float]): the non-zero elements of B.T\n"
+            "    Bt_indptr (NDArray[int]): the row indices for `Bt_data`\n"
+            "    Bt_indices (NDArray[int]): the column indices for `Bt_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<float, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<double, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<float, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<int, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<int64_t, int, int>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<int, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<int64_t, int64_t, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<double, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<float, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<int, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_threshold_mt",
+        &api::sp_matmul_threshold_mt<int64_t, int, int64_t>,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::bindings
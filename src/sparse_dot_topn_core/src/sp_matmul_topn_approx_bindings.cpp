@@ -0,0 +1,1194 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <sparse_dot_topn/sp_matmul_topn_approx.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_approx_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_sp_matmul_topn_approx(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of the sparse dot product approximately.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    A_ncols (int): the number of columns in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_bands (int): the number of LSH bands\n"
+            "    band_size (int): the number of MinHash values per band\n"
+            "    seed (int): the seed of the hash functions\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    Bt_data (NDArray[int | float]): the non-zero elements of B.T\n"
+            "    Bt_indptr (NDArray[int]): the row indices for `Bt_data`\n"
+            "    Bt_indices (NDArray[int]): the column indices for `Bt_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            float,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<int, int, int, core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            int64_t,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            int,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx",
+        &api::sp_matmul_topn_approx<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_topn_approx_sorted(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<double, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of the sparse dot product approximately,"
+            " sorted on value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    A_ncols (int): the number of columns in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_bands (int): the number of LSH bands\n"
+            "    band_size (int): the number of MinHash values per band\n"
+            "    seed (int): the seed of the hash functions\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    Bt_data (NDArray[int | float]): the non-zero elements of B.T\n"
+            "    Bt_indptr (NDArray[int]): the row indices for `Bt_data`\n"
+            "    Bt_indices (NDArray[int]): the column indices for `Bt_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<int, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<int64_t, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<int, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted",
+        &api::sp_matmul_topn_approx<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_approx_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of the sparse dot product approximately.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    A_ncols (int): the number of columns in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_bands (int): the number of LSH bands\n"
+            "    band_size (int): the number of MinHash values per band\n"
+            "    seed (int): the seed of the hash functions\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    Bt_data (NDArray[int | float]): the non-zero elements of B.T\n"
+            "    Bt_indptr (NDArray[int]): the row indices for `Bt_data`\n"
+            "    Bt_indices (NDArray[int]): the column indices for `Bt_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            float,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int64_t,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_topn_approx_sorted_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            double,
+            int,
+            int,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of the sparse dot product approximately,"
+            " sorted on value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    A_ncols (int): the number of columns in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_bands (int): the number of LSH bands\n"
+            "    band_size (int): the number of MinHash values per band\n"
+            "    seed (int): the seed of the hash functions\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    Bt_data (NDArray[int | float]): the non-zero elements of B.T\n"
+            "    Bt_indptr (NDArray[int]): the row indices for `Bt_data`\n"
+            "    Bt_indices (NDArray[int]): the column indices for `Bt_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<int, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int64_t,
+            int,
+            int,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_approx_sorted_mt",
+        &api::sp_matmul_topn_approx_mt<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "A_ncols"_a,
+        "threshold"_a.none(),
+        "n_bands"_a,
+        "band_size"_a,
+        "seed"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "Bt_data"_a.noconvert(),
+        "Bt_indptr"_a.noconvert(),
+        "Bt_indices"_a.noconvert()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::bindings
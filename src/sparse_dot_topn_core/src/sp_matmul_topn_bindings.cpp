@@ -27,12 +27,12 @@ using namespace nb::literals;
 void bind_sp_matmul_topn(nb::module_& m) {
     m.def(
         "sp_matmul_topn",
-        &api::sp_matmul_topn<double, int, true>,
+        &api::sp_matmul_topn<double, int, int, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -46,8 +46,8 @@ void bind_sp_matmul_topn(nb::module_& m) {
             "    top_n (int): the number of results to retain\n"
             "    nrows (int): the number of rows in `A`\n"
             "    ncols (int): the number of columns in `B`\n"
-            "    density (float): the expected density of the result"
-            " considering `top_n`\n"
+            "    density (float | None): the expected density of the result"
+            " considering `top_n`, when None C is sized with an upper bound\n"
             "    threshold (float): only store values greater than\n"
             "    A_data (NDArray[int | float]): the non-zero elements of A\n"
             "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
@@ -65,12 +65,12 @@ void bind_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn",
-        &api::sp_matmul_topn<float, int, true>,
+        &api::sp_matmul_topn<float, int, int, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -80,12 +80,16 @@ void bind_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn",
-        &api::sp_matmul_topn<double, int64_t, true>,
+        &api::sp_matmul_topn<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -95,12 +99,16 @@ void bind_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn",
-        &api::sp_matmul_topn<float, int64_t, true>,
+        &api::sp_matmul_topn<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -110,12 +118,12 @@ void bind_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn",
-        &api::sp_matmul_topn<int, int, true>,
+        &api::sp_matmul_topn<int, int, int, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -125,12 +133,12 @@ void bind_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn",
-        &api::sp_matmul_topn<int64_t, int, true>,
+        &api::sp_matmul_topn<int64_t, int, int, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -140,12 +148,12 @@ void bind_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn",
-        &api::sp_matmul_topn<int, int64_t, true>,
+        &api::sp_matmul_topn<int, int64_t, int64_t, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -155,12 +163,76 @@ void bind_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn",
-        &api::sp_matmul_topn<int64_t, int64_t, true>,
+        &api::sp_matmul_topn<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn",
+        &api::sp_matmul_topn<double, int, int64_t, core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn",
+        &api::sp_matmul_topn<float, int, int64_t, core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn",
+        &api::sp_matmul_topn<int, int, int64_t, core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn",
+        &api::sp_matmul_topn<int64_t, int, int64_t, core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -173,12 +245,12 @@ void bind_sp_matmul_topn(nb::module_& m) {
 void bind_sp_matmul_topn_sorted(nb::module_& m) {
     m.def(
         "sp_matmul_topn_sorted",
-        &api::sp_matmul_topn<double, int, false>,
+        &api::sp_matmul_topn<double, int, int, core::SortOrder::value>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -193,8 +265,8 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
             "    nrows (int): the number of rows in `A`\n"
             "    ncols (int): the number of columns in `B`\n"
             "    threshold (float): only store values greater than\n"
-            "    density (float): the expected density of the result"
-            " considering `top_n`\n"
+            "    density (float | None): the expected density of the result"
+            " considering `top_n`, when None C is sized with an upper bound\n"
             "    A_data (NDArray[int | float]): the non-zero elements of A\n"
             "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
             "    A_indices (NDArray[int]): the column indices for `A_data`\n"
@@ -211,12 +283,72 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn_sorted",
-        &api::sp_matmul_topn<float, int, false>,
+        &api::sp_matmul_topn<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted",
+        &api::sp_matmul_topn<double, int64_t, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted",
+        &api::sp_matmul_topn<float, int64_t, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted",
+        &api::sp_matmul_topn<int, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted",
+        &api::sp_matmul_topn<int64_t, int, int, core::SortOrder::value>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -226,12 +358,12 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn_sorted",
-        &api::sp_matmul_topn<double, int64_t, false>,
+        &api::sp_matmul_topn<int, int64_t, int64_t, core::SortOrder::value>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -241,12 +373,12 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn_sorted",
-        &api::sp_matmul_topn<float, int64_t, false>,
+        &api::sp_matmul_topn<int64_t, int64_t, int64_t, core::SortOrder::value>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -256,12 +388,12 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn_sorted",
-        &api::sp_matmul_topn<int, int, false>,
+        &api::sp_matmul_topn<double, int, int64_t, core::SortOrder::value>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -271,12 +403,12 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn_sorted",
-        &api::sp_matmul_topn<int64_t, int, false>,
+        &api::sp_matmul_topn<float, int, int64_t, core::SortOrder::value>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -286,12 +418,12 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn_sorted",
-        &api::sp_matmul_topn<int, int64_t, false>,
+        &api::sp_matmul_topn<int, int, int64_t, core::SortOrder::value>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -301,12 +433,12 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
     );
     m.def(
         "sp_matmul_topn_sorted",
-        &api::sp_matmul_topn<int64_t, int64_t, false>,
+        &api::sp_matmul_topn<int64_t, int, int64_t, core::SortOrder::value>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "density"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -316,16 +448,15 @@ void bind_sp_matmul_topn_sorted(nb::module_& m) {
     );
 }
 
-#ifdef SDTN_OMP_ENABLED
-void bind_sp_matmul_topn_mt(nb::module_& m) {
+void bind_sp_matmul_topn_canonical(nb::module_& m) {
     m.def(
-        "sp_matmul_topn_mt",
-        &api::sp_matmul_topn_mt<double, int, true>,
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<double, int, int, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "n_threads"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -333,13 +464,15 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
         "B_indptr"_a.noconvert(),
         "B_indices"_a.noconvert(),
         nb::raw_doc(
-            "Compute sparse dot product and keep top n.\n"
+            "Compute sparse dot product and keep top n, sorted on column.\n"
             "\n"
             "Args:\n"
             "    top_n (int): the number of results to retain\n"
             "    nrows (int): the number of rows in `A`\n"
             "    ncols (int): the number of columns in `B`\n"
             "    threshold (float): only store values greater than\n"
+            "    density (float | None): the expected density of the result"
+            " considering `top_n`, when None C is sized with an upper bound\n"
             "    A_data (NDArray[int | float]): the non-zero elements of A\n"
             "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
             "    A_indices (NDArray[int]): the column indices for `A_data`\n"
@@ -355,13 +488,13 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
         )
     );
     m.def(
-        "sp_matmul_topn_mt",
-        &api::sp_matmul_topn_mt<float, int, true>,
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<float, int, int, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "n_threads"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -370,13 +503,13 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_mt",
-        &api::sp_matmul_topn_mt<double, int64_t, true>,
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<double, int64_t, int64_t, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "n_threads"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -385,13 +518,13 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_mt",
-        &api::sp_matmul_topn_mt<float, int64_t, true>,
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<float, int64_t, int64_t, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "n_threads"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -400,13 +533,13 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_mt",
-        &api::sp_matmul_topn_mt<int, int, true>,
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<int, int, int, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "n_threads"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -415,13 +548,13 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_mt",
-        &api::sp_matmul_topn_mt<int64_t, int, true>,
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<int64_t, int, int, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "n_threads"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -430,13 +563,13 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_mt",
-        &api::sp_matmul_topn_mt<int, int64_t, true>,
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<int, int64_t, int64_t, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "n_threads"_a,
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -445,13 +578,73 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_mt",
-        &api::sp_matmul_topn_mt<int64_t, int64_t, true>,
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<int64_t, int64_t, int64_t, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
         "threshold"_a.none(),
-        "n_threads"_a,
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<double, int, int64_t, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<float, int, int64_t, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<int, int, int64_t, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical",
+        &api::sp_matmul_topn<int64_t, int, int64_t, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "density"_a.none(),
         "A_data"_a.noconvert(),
         "A_indptr"_a.noconvert(),
         "A_indices"_a.noconvert(),
@@ -461,10 +654,11 @@ void bind_sp_matmul_topn_mt(nb::module_& m) {
     );
 }
 
-void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_mt(nb::module_& m) {
     m.def(
-        "sp_matmul_topn_sorted_mt",
-        &api::sp_matmul_topn_mt<double, int, false>,
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<double, int, int, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
@@ -499,8 +693,8 @@ void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
         )
     );
     m.def(
-        "sp_matmul_topn_sorted_mt",
-        &api::sp_matmul_topn_mt<float, int, false>,
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<float, int, int, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
@@ -514,8 +708,12 @@ void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_sorted_mt",
-        &api::sp_matmul_topn_mt<double, int64_t, false>,
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
@@ -529,8 +727,12 @@ void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_sorted_mt",
-        &api::sp_matmul_topn_mt<float, int64_t, false>,
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
@@ -544,8 +746,8 @@ void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_sorted_mt",
-        &api::sp_matmul_topn_mt<int, int, false>,
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<int, int, int, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
@@ -559,8 +761,8 @@ void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_sorted_mt",
-        &api::sp_matmul_topn_mt<int64_t, int, false>,
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<int64_t, int, int, core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
@@ -574,8 +776,12 @@ void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_sorted_mt",
-        &api::sp_matmul_topn_mt<int, int64_t, false>,
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
@@ -589,8 +795,516 @@ void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
         "B_indices"_a.noconvert()
     );
     m.def(
-        "sp_matmul_topn_sorted_mt",
-        &api::sp_matmul_topn_mt<int64_t, int64_t, false>,
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<int, int, int64_t, core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_mt",
+        &api::sp_matmul_topn_mt<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_topn_sorted_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<double, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute sparse dot product and keep top n.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    threshold (float): only store values greater than\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<int, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<int64_t, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<int, int64_t, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<double, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<float, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<int, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_sorted_mt",
+        &api::sp_matmul_topn_mt<int64_t, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_topn_canonical_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<double, int, int, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute sparse dot product and keep top n, sorted on column.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    threshold (float): only store values greater than\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<float, int, int, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<int, int, int, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<int64_t, int, int, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<int, int64_t, int64_t, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<double, int, int64_t, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<float, int, int64_t, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<int, int, int64_t, core::SortOrder::index>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_canonical_mt",
+        &api::sp_matmul_topn_mt<int64_t, int, int64_t, core::SortOrder::index>,
         "top_n"_a,
         "nrows"_a,
         "ncols"_a,
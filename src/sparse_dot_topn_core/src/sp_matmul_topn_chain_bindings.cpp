@@ -0,0 +1,1297 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <sparse_dot_topn/sp_matmul_topn_chain_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_sp_matmul_topn_chain(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of the sparse dot product A.dot(B).dot(C)\n"
+            "where the rows of A.dot(B) are pruned to their top n.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `C`\n"
+            "    threshold (float): only store values greater than\n"
+            "    intermediate_top_n (int): the number of values to retain of\n"
+            "        the rows of A.dot(B)\n"
+            "    intermediate_ncols (int): the number of columns in `B`\n"
+            "    intermediate_threshold (float): only retain values of\n"
+            "        A.dot(B) greater than\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "\n"
+            "Returns:\n"
+            "    Z_data (NDArray[int | float]): the non-zero elements of Z\n"
+            "    Z_indices (NDArray[int]): the column indices for `Z_data`\n"
+            "    Z_indptr (NDArray[int]): the row indices for `Z_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<float, int, int, core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<int, int, int, core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            int64_t,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            int,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain",
+        &api::sp_matmul_topn_chain<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_topn_chain_sorted(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<double, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of the sparse dot product A.dot(B).dot(C)\n"
+            "where the rows of A.dot(B) are pruned to their top n, sorted on\n"
+            "value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `C`\n"
+            "    threshold (float): only store values greater than\n"
+            "    intermediate_top_n (int): the number of values to retain of\n"
+            "        the rows of A.dot(B)\n"
+            "    intermediate_ncols (int): the number of columns in `B`\n"
+            "    intermediate_threshold (float): only retain values of\n"
+            "        A.dot(B) greater than\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "\n"
+            "Returns:\n"
+            "    Z_data (NDArray[int | float]): the non-zero elements of Z\n"
+            "    Z_indices (NDArray[int]): the column indices for `Z_data`\n"
+            "    Z_indptr (NDArray[int]): the row indices for `Z_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<int, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<int64_t, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<float, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<int, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted",
+        &api::sp_matmul_topn_chain<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_chain_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of the sparse dot product A.dot(B).dot(C)\n"
+            "where the rows of A.dot(B) are pruned to their top n.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `C`\n"
+            "    threshold (float): only store values greater than\n"
+            "    intermediate_top_n (int): the number of values to retain of\n"
+            "        the rows of A.dot(B)\n"
+            "    intermediate_ncols (int): the number of columns in `B`\n"
+            "    intermediate_threshold (float): only retain values of\n"
+            "        A.dot(B) greater than\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "\n"
+            "Returns:\n"
+            "    Z_data (NDArray[int | float]): the non-zero elements of Z\n"
+            "    Z_indices (NDArray[int]): the column indices for `Z_data`\n"
+            "    Z_indptr (NDArray[int]): the row indices for `Z_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            float,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int64_t,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_topn_chain_sorted_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<double, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of the sparse dot product A.dot(B).dot(C)\n"
+            "where the rows of A.dot(B) are pruned to their top n, sorted on\n"
+            "value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `C`\n"
+            "    threshold (float): only store values greater than\n"
+            "    intermediate_top_n (int): the number of values to retain of\n"
+            "        the rows of A.dot(B)\n"
+            "    intermediate_ncols (int): the number of columns in `B`\n"
+            "    intermediate_threshold (float): only retain values of\n"
+            "        A.dot(B) greater than\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    C_data (NDArray[int | float]): the non-zero elements of C\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "\n"
+            "Returns:\n"
+            "    Z_data (NDArray[int | float]): the non-zero elements of Z\n"
+            "    Z_indices (NDArray[int]): the column indices for `Z_data`\n"
+            "    Z_indptr (NDArray[int]): the row indices for `Z_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<int, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int64_t,
+            int,
+            int,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int64_t,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_chain_sorted_mt",
+        &api::sp_matmul_topn_chain_mt<
+            int64_t,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "intermediate_top_n"_a,
+        "intermediate_ncols"_a,
+        "intermediate_threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "C_data"_a.noconvert(),
+        "C_indptr"_a.noconvert(),
+        "C_indices"_a.noconvert()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::bindings
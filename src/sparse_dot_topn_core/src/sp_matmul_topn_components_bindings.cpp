@@ -0,0 +1,433 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <sparse_dot_topn/sp_matmul_topn_components.hpp>
+#include <sparse_dot_topn/sp_matmul_topn_components_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_sp_matmul_topn_components(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<double, int, int>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the connected components of the top n of the sparse dot"
+            " product.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A` and columns in `B`\n"
+            "    threshold (float): only connect values greater than\n"
+            "    with_edges (bool): return the retained elements\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "\n"
+            "Returns:\n"
+            "    n_components (int): the number of connected components\n"
+            "    labels (NDArray[int]): the component of each row of `A`\n"
+            "    E_data (NDArray[int | float]): the retained elements\n"
+            "    E_rows (NDArray[int]): the row indices for `E_data`\n"
+            "    E_cols (NDArray[int]): the column indices for `E_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<float, int, int>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<double, int64_t, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<float, int64_t, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<int, int, int>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<int64_t, int, int>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<int, int64_t, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<int64_t, int64_t, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<double, int, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<float, int, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<int, int, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components",
+        &api::sp_matmul_topn_components<int64_t, int, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_components_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<double, int, int>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the connected components of the top n of the sparse dot"
+            " product.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A` and columns in `B`\n"
+            "    threshold (float): only connect values greater than\n"
+            "    with_edges (bool): return the retained elements\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[int | float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[int | float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "\n"
+            "Returns:\n"
+            "    n_components (int): the number of connected components\n"
+            "    labels (NDArray[int]): the component of each row of `A`\n"
+            "    E_data (NDArray[int | float]): the retained elements\n"
+            "    E_rows (NDArray[int]): the row indices for `E_data`\n"
+            "    E_cols (NDArray[int]): the column indices for `E_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<float, int, int>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<double, int64_t, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<float, int64_t, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<int, int, int>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<int64_t, int, int>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<int, int64_t, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<int64_t, int64_t, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<double, int, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<float, int, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<int, int, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_components_mt",
+        &api::sp_matmul_topn_components_mt<int64_t, int, int64_t>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "with_edges"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::bindings
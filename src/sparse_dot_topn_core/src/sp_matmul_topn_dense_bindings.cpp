@@ -0,0 +1,823 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <sparse_dot_topn/sp_matmul_topn_dense_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_dense_matmul_topn(nb::module_& m) {
+    m.def(
+        "dense_matmul_topn_float64_int32_int32",
+        &api::dense_matmul_topn<double, int, int, core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of Q.dot(E.T) for the dense matrices Q and E.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    threshold (float): only store values greater than\n"
+            "    Q (NDArray[float]): the dense LHS in row-major order\n"
+            "    E (NDArray[float]): the dense RHS.T in row-major order\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "dense_matmul_topn_float32_int32_int32",
+        &api::dense_matmul_topn<float, int, int, core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_float64_int64_int64",
+        &api::dense_matmul_topn<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_float32_int64_int64",
+        &api::dense_matmul_topn<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_float64_int32_int64",
+        &api::dense_matmul_topn<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_float32_int32_int64",
+        &api::dense_matmul_topn<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+}
+
+void bind_dense_matmul_topn_sorted(nb::module_& m) {
+    m.def(
+        "dense_matmul_topn_sorted_float64_int32_int32",
+        &api::dense_matmul_topn<double, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of Q.dot(E.T) for the dense matrices Q and E,\n"
+            "sorted on value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    threshold (float): only store values greater than\n"
+            "    Q (NDArray[float]): the dense LHS in row-major order\n"
+            "    E (NDArray[float]): the dense RHS.T in row-major order\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "dense_matmul_topn_sorted_float32_int32_int32",
+        &api::dense_matmul_topn<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_sorted_float64_int64_int64",
+        &api::dense_matmul_topn<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_sorted_float32_int64_int64",
+        &api::dense_matmul_topn<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_sorted_float64_int32_int64",
+        &api::dense_matmul_topn<double, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_sorted_float32_int32_int64",
+        &api::dense_matmul_topn<float, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+}
+
+void bind_sparse_dense_matmul_topn(nb::module_& m) {
+    m.def(
+        "sparse_dense_matmul_topn",
+        &api::sparse_dense_matmul_topn<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of A.dot(D) for the sparse matrix A and the\n"
+            "dense matrix D.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    A_data (NDArray[float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    D (NDArray[float]): the dense RHS in row-major order\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sparse_dense_matmul_topn",
+        &api::sparse_dense_matmul_topn<
+            float,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn",
+        &api::sparse_dense_matmul_topn<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn",
+        &api::sparse_dense_matmul_topn<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn",
+        &api::sparse_dense_matmul_topn<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn",
+        &api::sparse_dense_matmul_topn<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+}
+
+void bind_sparse_dense_matmul_topn_sorted(nb::module_& m) {
+    m.def(
+        "sparse_dense_matmul_topn_sorted",
+        &api::sparse_dense_matmul_topn<
+            double,
+            int,
+            int,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of A.dot(D) for the sparse matrix A and the\n"
+            "dense matrix D, sorted on value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    A_data (NDArray[float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    D (NDArray[float]): the dense RHS in row-major order\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted",
+        &api::sparse_dense_matmul_topn<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted",
+        &api::sparse_dense_matmul_topn<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted",
+        &api::sparse_dense_matmul_topn<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted",
+        &api::sparse_dense_matmul_topn<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted",
+        &api::sparse_dense_matmul_topn<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+void bind_dense_matmul_topn_mt(nb::module_& m) {
+    m.def(
+        "dense_matmul_topn_mt_float64_int32_int32",
+        &api::dense_matmul_topn_mt<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of Q.dot(E.T) for the dense matrices Q and E.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    Q (NDArray[float]): the dense LHS in row-major order\n"
+            "    E (NDArray[float]): the dense RHS.T in row-major order\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "dense_matmul_topn_mt_float32_int32_int32",
+        &api::dense_matmul_topn_mt<float, int, int, core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_mt_float64_int64_int64",
+        &api::dense_matmul_topn_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_mt_float32_int64_int64",
+        &api::dense_matmul_topn_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_mt_float64_int32_int64",
+        &api::dense_matmul_topn_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_mt_float32_int32_int64",
+        &api::dense_matmul_topn_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+}
+
+void bind_dense_matmul_topn_sorted_mt(nb::module_& m) {
+    m.def(
+        "dense_matmul_topn_sorted_mt_float64_int32_int32",
+        &api::dense_matmul_topn_mt<double, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of Q.dot(E.T) for the dense matrices Q and E,\n"
+            "sorted on value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    Q (NDArray[float]): the dense LHS in row-major order\n"
+            "    E (NDArray[float]): the dense RHS.T in row-major order\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "dense_matmul_topn_sorted_mt_float32_int32_int32",
+        &api::dense_matmul_topn_mt<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_sorted_mt_float64_int64_int64",
+        &api::dense_matmul_topn_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_sorted_mt_float32_int64_int64",
+        &api::dense_matmul_topn_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_sorted_mt_float64_int32_int64",
+        &api::dense_matmul_topn_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "dense_matmul_topn_sorted_mt_float32_int32_int64",
+        &api::dense_matmul_topn_mt<float, int, int64_t, core::SortOrder::value>,
+        "top_n"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+}
+
+void bind_sparse_dense_matmul_topn_mt(nb::module_& m) {
+    m.def(
+        "sparse_dense_matmul_topn_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of A.dot(D) for the sparse matrix A and the\n"
+            "dense matrix D.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    D (NDArray[float]): the dense RHS in row-major order\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sparse_dense_matmul_topn_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            float,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+}
+
+void bind_sparse_dense_matmul_topn_sorted_mt(nb::module_& m) {
+    m.def(
+        "sparse_dense_matmul_topn_sorted_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            double,
+            int,
+            int,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of A.dot(D) for the sparse matrix A and the\n"
+            "dense matrix D, sorted on value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    threshold (float): only store values greater than\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    D (NDArray[float]): the dense RHS in row-major order\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            float,
+            int,
+            int,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+    m.def(
+        "sparse_dense_matmul_topn_sorted_mt",
+        &api::sparse_dense_matmul_topn_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "threshold"_a.none(),
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "D"_a.noconvert()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::bindings
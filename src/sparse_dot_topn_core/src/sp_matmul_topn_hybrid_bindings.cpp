@@ -0,0 +1,675 @@
+/* Copyright (c) 2023 ING Analytics Wholesale Banking
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *	http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <sparse_dot_topn/sp_matmul_topn_hybrid_bindings.hpp>
+
+namespace sdtn::bindings {
+namespace nb = nanobind;
+
+using namespace nb::literals;
+
+void bind_sp_matmul_topn_hybrid(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_hybrid",
+        &api::sp_matmul_topn_hybrid<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of alpha * A.dot(B) + beta * Q.dot(E.T) over\n"
+            "the columns set in A.dot(B).\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    threshold (float): only store values greater than\n"
+            "    alpha (float): the weight of the sparse product\n"
+            "    beta (float): the weight of the product of the embeddings\n"
+            "    A_data (NDArray[float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    Q (NDArray[float]): the embeddings of the rows of C\n"
+            "    E (NDArray[float]): the embeddings of the columns of C\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_hybrid",
+        &api::sp_matmul_topn_hybrid<
+            float,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid",
+        &api::sp_matmul_topn_hybrid<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid",
+        &api::sp_matmul_topn_hybrid<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid",
+        &api::sp_matmul_topn_hybrid<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid",
+        &api::sp_matmul_topn_hybrid<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_topn_hybrid_sorted(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_hybrid_sorted",
+        &api::sp_matmul_topn_hybrid<double, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of alpha * A.dot(B) + beta * Q.dot(E.T) over\n"
+            "the columns set in A.dot(B), sorted on value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    threshold (float): only store values greater than\n"
+            "    alpha (float): the weight of the sparse product\n"
+            "    beta (float): the weight of the product of the embeddings\n"
+            "    A_data (NDArray[float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    Q (NDArray[float]): the embeddings of the rows of C\n"
+            "    E (NDArray[float]): the embeddings of the columns of C\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted",
+        &api::sp_matmul_topn_hybrid<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted",
+        &api::sp_matmul_topn_hybrid<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted",
+        &api::sp_matmul_topn_hybrid<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted",
+        &api::sp_matmul_topn_hybrid<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted",
+        &api::sp_matmul_topn_hybrid<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+}
+
+#ifdef SDTN_OMP_ENABLED
+void bind_sp_matmul_topn_hybrid_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_hybrid_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            double,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of alpha * A.dot(B) + beta * Q.dot(E.T) over\n"
+            "the columns set in A.dot(B).\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    threshold (float): only store values greater than\n"
+            "    alpha (float): the weight of the sparse product\n"
+            "    beta (float): the weight of the product of the embeddings\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    Q (NDArray[float]): the embeddings of the rows of C\n"
+            "    E (NDArray[float]): the embeddings of the columns of C\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            float,
+            int,
+            int,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::insertion>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+}
+
+void bind_sp_matmul_topn_hybrid_sorted_mt(nb::module_& m) {
+    m.def(
+        "sp_matmul_topn_hybrid_sorted_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            double,
+            int,
+            int,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert(),
+        nb::raw_doc(
+            "Compute the top n of alpha * A.dot(B) + beta * Q.dot(E.T) over\n"
+            "the columns set in A.dot(B), sorted on value.\n"
+            "\n"
+            "Args:\n"
+            "    top_n (int): the number of results to retain\n"
+            "    nrows (int): the number of rows in `A`\n"
+            "    ncols (int): the number of columns in `B`\n"
+            "    threshold (float): only store values greater than\n"
+            "    alpha (float): the weight of the sparse product\n"
+            "    beta (float): the weight of the product of the embeddings\n"
+            "    n_threads (int): the number of threads to use\n"
+            "    A_data (NDArray[float]): the non-zero elements of A\n"
+            "    A_indptr (NDArray[int]): the row indices for `A_data`\n"
+            "    A_indices (NDArray[int]): the column indices for `A_data`\n"
+            "    B_data (NDArray[float]): the non-zero elements of B\n"
+            "    B_indptr (NDArray[int]): the row indices for `B_data`\n"
+            "    B_indices (NDArray[int]): the column indices for `B_data`\n"
+            "    Q (NDArray[float]): the embeddings of the rows of C\n"
+            "    E (NDArray[float]): the embeddings of the columns of C\n"
+            "\n"
+            "Returns:\n"
+            "    C_data (NDArray[float]): the non-zero elements of C\n"
+            "    C_indices (NDArray[int]): the column indices for `C_data`\n"
+            "    C_indptr (NDArray[int]): the row indices for `C_data`\n"
+            "\n"
+        )
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted_mt",
+        &api::sp_matmul_topn_hybrid_mt<float, int, int, core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            double,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            float,
+            int64_t,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            double,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+    m.def(
+        "sp_matmul_topn_hybrid_sorted_mt",
+        &api::sp_matmul_topn_hybrid_mt<
+            float,
+            int,
+            int64_t,
+            core::SortOrder::value>,
+        "top_n"_a,
+        "nrows"_a,
+        "ncols"_a,
+        "threshold"_a.none(),
+        "alpha"_a,
+        "beta"_a,
+        "n_threads"_a,
+        "A_data"_a.noconvert(),
+        "A_indptr"_a.noconvert(),
+        "A_indices"_a.noconvert(),
+        "B_data"_a.noconvert(),
+        "B_indptr"_a.noconvert(),
+        "B_indices"_a.noconvert(),
+        "Q"_a.noconvert(),
+        "E"_a.noconvert()
+    );
+}
+#endif  // SDTN_OMP_ENABLED
+
+}  // namespace sdtn::bindings
@@ -24,10 +24,76 @@ namespace nb = nanobind;
 
 using namespace nb::literals;
 
+namespace {
+
+template <typename eT, typename idxT, typename ptrT>
+void bind_zip_accumulator_class(nb::module_& m, const char* name) {
+    using Acc = api::ZipAccumulator<eT, idxT, ptrT>;
+    nb::class_<Acc>(
+        m,
+        name,
+        "Incrementally zip C = zip_j C_j keeping only the top n values.\n"
+        "\n"
+        "The sub-matrices are merged into a per-row top n state when added\n"
+        "and are not retained. `finalize` returns the exactly sized result.\n"
+    )
+        .def(nb::init<idxT, idxT>(), "top_n"_a, "nrows"_a)
+        .def_prop_ro("nrows", &Acc::nrows)
+        .def_prop_ro("ncols", &Acc::ncols)
+        .def_prop_ro("nnz", &Acc::nnz)
+        .def(
+            "add",
+            &Acc::add,
+            "ncols"_a,
+            "data"_a.noconvert(),
+            "indptr"_a.noconvert(),
+            "indices"_a.noconvert(),
+            nb::raw_doc(
+                "Merge the sub-matrix C_j = A.dot(B_j).\n"
+                "\n"
+                "Args:\n"
+                "    ncols (int): the number of columns of C_j\n"
+                "    data (NDArray[int | float]): the non-zero elements of "
+                "C_j\n"
+                "    indptr (NDArray[int]): the row indices for `data`\n"
+                "    indices (NDArray[int]): the column indices for `data`\n"
+                "\n"
+            )
+        )
+#if defined(SDTN_OMP_ENABLED)
+        .def(
+            "add_mt",
+            &Acc::add_mt,
+            "n_threads"_a,
+            "ncols"_a,
+            "data"_a.noconvert(),
+            "indptr"_a.noconvert(),
+            "indices"_a.noconvert()
+        )
+#endif  // SDTN_OMP_ENABLED
+        .def(
+            "finalize",
+            &Acc::finalize,
+            nb::raw_doc(
+                "Return the zipped matrix, the accumulator is released.\n"
+                "\n"
+                "Returns:\n"
+                "    Z_data (NDArray[int | float]): the non-zero elements of "
+                "Z\n"
+                "    Z_indices (NDArray[int]): the column indices for "
+                "`Z_data`\n"
+                "    Z_indptr (NDArray[int]): the row indices for `Z_data`\n"
+                "\n"
+            )
+        );
+}
+
+}  // namespace
+
 void bind_zip_sp_matmul_topn(nb::module_& m) {
     m.def(
         "zip_sp_matmul_topn",
-        &api::zip_sp_matmul_topn<double, int>,
+        &api::zip_sp_matmul_topn<double, int, int>,
         "top_n"_a,
         "Z_max_nnz"_a,
         "nrows"_a,
@@ -60,7 +126,51 @@ void bind_zip_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "zip_sp_matmul_topn",
-        &api::zip_sp_matmul_topn<float, int>,
+        &api::zip_sp_matmul_topn<float, int, int>,
+        "top_n"_a,
+        "Z_max_nnz"_a,
+        "nrows"_a,
+        "B_ncols"_a,
+        "data"_a.noconvert(),
+        "indptr"_a.noconvert(),
+        "indices"_a.noconvert()
+    );
+    m.def(
+        "zip_sp_matmul_topn",
+        &api::zip_sp_matmul_topn<double, int64_t, int64_t>,
+        "top_n"_a,
+        "Z_max_nnz"_a,
+        "nrows"_a,
+        "B_ncols"_a,
+        "data"_a.noconvert(),
+        "indptr"_a.noconvert(),
+        "indices"_a.noconvert()
+    );
+    m.def(
+        "zip_sp_matmul_topn",
+        &api::zip_sp_matmul_topn<float, int64_t, int64_t>,
+        "top_n"_a,
+        "Z_max_nnz"_a,
+        "nrows"_a,
+        "B_ncols"_a,
+        "data"_a.noconvert(),
+        "indptr"_a.noconvert(),
+        "indices"_a.noconvert()
+    );
+    m.def(
+        "zip_sp_matmul_topn",
+        &api::zip_sp_matmul_topn<int, int, int>,
+        "top_n"_a,
+        "Z_max_nnz"_a,
+        "nrows"_a,
+        "B_ncols"_a,
+        "data"_a.noconvert(),
+        "indptr"_a.noconvert(),
+        "indices"_a.noconvert()
+    );
+    m.def(
+        "zip_sp_matmul_topn",
+        &api::zip_sp_matmul_topn<int64_t, int, int>,
         "top_n"_a,
         "Z_max_nnz"_a,
         "nrows"_a,
@@ -71,7 +181,7 @@ void bind_zip_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "zip_sp_matmul_topn",
-        &api::zip_sp_matmul_topn<double, int64_t>,
+        &api::zip_sp_matmul_topn<int, int64_t, int64_t>,
         "top_n"_a,
         "Z_max_nnz"_a,
         "nrows"_a,
@@ -82,7 +192,7 @@ void bind_zip_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "zip_sp_matmul_topn",
-        &api::zip_sp_matmul_topn<float, int64_t>,
+        &api::zip_sp_matmul_topn<int64_t, int64_t, int64_t>,
         "top_n"_a,
         "Z_max_nnz"_a,
         "nrows"_a,
@@ -93,7 +203,7 @@ void bind_zip_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "zip_sp_matmul_topn",
-        &api::zip_sp_matmul_topn<int, int>,
+        &api::zip_sp_matmul_topn<double, int, int64_t>,
         "top_n"_a,
         "Z_max_nnz"_a,
         "nrows"_a,
@@ -104,7 +214,7 @@ void bind_zip_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "zip_sp_matmul_topn",
-        &api::zip_sp_matmul_topn<int64_t, int>,
+        &api::zip_sp_matmul_topn<float, int, int64_t>,
         "top_n"_a,
         "Z_max_nnz"_a,
         "nrows"_a,
@@ -115,7 +225,7 @@ void bind_zip_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "zip_sp_matmul_topn",
-        &api::zip_sp_matmul_topn<int, int64_t>,
+        &api::zip_sp_matmul_topn<int, int, int64_t>,
         "top_n"_a,
         "Z_max_nnz"_a,
         "nrows"_a,
@@ -126,7 +236,7 @@ void bind_zip_sp_matmul_topn(nb::module_& m) {
     );
     m.def(
         "zip_sp_matmul_topn",
-        &api::zip_sp_matmul_topn<int64_t, int64_t>,
+        &api::zip_sp_matmul_topn<int64_t, int, int64_t>,
         "top_n"_a,
         "Z_max_nnz"_a,
         "nrows"_a,
@@ -137,4 +247,43 @@ void bind_zip_sp_matmul_topn(nb::module_& m) {
     );
 }
 
+void bind_zip_accumulator(nb::module_& m) {
+    bind_zip_accumulator_class<double, int, int>(
+        m, "ZipAccumulator_float64_int32_int32"
+    );
+    bind_zip_accumulator_class<float, int, int>(
+        m, "ZipAccumulator_float32_int32_int32"
+    );
+    bind_zip_accumulator_class<double, int64_t, int64_t>(
+        m, "ZipAccumulator_float64_int64_int64"
+    );
+    bind_zip_accumulator_class<float, int64_t, int64_t>(
+        m, "ZipAccumulator_float32_int64_int64"
+    );
+    bind_zip_accumulator_class<int, int, int>(
+        m, "ZipAccumulator_int32_int32_int32"
+    );
+    bind_zip_accumulator_class<int64_t, int, int>(
+        m, "ZipAccumulator_int64_int32_int32"
+    );
+    bind_zip_accumulator_class<int, int64_t, int64_t>(
+        m, "ZipAccumulator_int32_int64_int64"
+    );
+    bind_zip_accumulator_class<int64_t, int64_t, int64_t>(
+        m, "ZipAccumulator_int64_int64_int64"
+    );
+    bind_zip_accumulator_class<double, int, int64_t>(
+        m, "ZipAccumulator_float64_int32_int64"
+    );
+    bind_zip_accumulator_class<float, int, int64_t>(
+        m, "ZipAccumulator_float32_int32_int64"
+    );
+    bind_zip_accumulator_class<int, int, int64_t>(
+        m, "ZipAccumulator_int32_int32_int64"
+    );
+    bind_zip_accumulator_class<int64_t, int, int64_t>(
+        m, "ZipAccumulator_int64_int32_int64"
+    );
+}
+
 }  // namespace sdtn::bindings
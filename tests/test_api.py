@@ -1,10 +1,32 @@
 import sys
+from concurrent.futures import ThreadPoolExecutor
 from itertools import product
 
 import numpy as np
 import pytest
 from scipy import sparse
-from sparse_dot_topn import _has_openmp_support, sp_matmul, sp_matmul_topn, zip_sp_matmul_topn
+from sparse_dot_topn import (
+    ZipAccumulator,
+    _has_openmp_support,
+    api,
+    sp_matmul,
+    sp_matmul_masked,
+    sp_matmul_pairs,
+    sp_matmul_threshold,
+    sp_matmul_topn,
+    sp_matmul_topn_approx,
+    sp_matmul_topn_chain,
+    sp_matmul_topn_components,
+    sp_matmul_topn_coo,
+    sp_matmul_topn_dense,
+    sp_matmul_topn_fields,
+    sp_matmul_topn_hybrid,
+    sp_matmul_topn_mutual,
+    sp_matmul_topn_semiring,
+    sp_matmul_topn_update,
+    zip_sp_matmul_topn,
+)
+from sparse_dot_topn.api import _widen_indptr
 
 from ._resources import _assert_array_equal, _assert_smat_equal, _get_topn_elements
 
@@ -85,6 +107,394 @@ def test_sp_matmul_topn_sorted(rng, dtype):
         _assert_array_equal(C_30[i, :].data, sorted_row[:30])
 
 
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_topn_sort_indices(rng, dtype, n_threads):
+    A = sparse.random(100, 10, density=0.5, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(10, 100, density=0.5, format="csr", dtype=dtype, random_state=rng)
+
+    C = sp_matmul_topn(A, B, top_n=10, sort_indices=True, n_threads=n_threads)
+    assert C.has_canonical_format
+    C_ref = sp_matmul_topn(A, B, top_n=10, n_threads=n_threads)
+    C_ref.sort_indices()
+    _assert_smat_equal(C, C_ref)
+    for i in range(C.shape[0]):
+        assert np.all(np.diff(C.indices[C.indptr[i] : C.indptr[i + 1]]) > 0)
+
+    C = sp_matmul(A, B, sort_indices=True, n_threads=n_threads)
+    assert C.has_canonical_format
+    C_ref = A.dot(B)
+    C_ref.sort_indices()
+    _assert_array_equal(C.indptr, C_ref.indptr)
+    _assert_array_equal(C.indices, C_ref.indices)
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn(A, B, top_n=10, sort=True, sort_indices=True)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_topn_approx(rng, dtype, n_threads):
+    # B contains a near duplicate of every row of A
+    A = sparse.random(200, 1000, density=0.03, format="csr", dtype=dtype, random_state=rng)
+    A.data[:] = 1
+    B = A.copy()
+    B.data[:: A.indices.size // 50] = 0
+    B.eliminate_zeros()
+
+    C = sp_matmul_topn_approx(A, B, top_n=5, sort=True, n_threads=n_threads)
+    assert C.shape == (A.shape[0], B.shape[0])
+    # the candidates are scored exactly
+    C_ref = A.dot(B.T).toarray()
+    rows = np.repeat(np.arange(C.shape[0]), np.diff(C.indptr))
+    _assert_array_equal(C.data, C_ref[rows, C.indices])
+    assert np.all(np.diff(C.data)[np.diff(rows) == 0] <= 0)
+    recall = np.mean(C.indices[C.indptr[:-1]] == np.arange(C.shape[0]))
+    assert recall > 0.95
+
+    # the orientation of `B` does not change the result
+    C_t = sp_matmul_topn_approx(A, B.T.tocsr(), top_n=5, sort=True, n_threads=n_threads)
+    _assert_smat_equal(C, C_t)
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_approx(A, B, top_n=5, n_bands=0)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+@pytest.mark.parametrize("negative", [False, True])
+def test_sp_matmul_threshold(rng, dtype, n_threads, negative):
+    A = sparse.random(100, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(200, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    if negative:
+        A.data[::3] *= -1
+    threshold = 0 if np.issubdtype(A.data.dtype, np.integer) else 0.3
+
+    C = sp_matmul_threshold(A, B, threshold=threshold, n_threads=n_threads)
+    C.sort_indices()
+    C_ref = A.dot(B.T).tocsr()
+    C_ref.data[C_ref.data <= threshold] = 0
+    C_ref.eliminate_zeros()
+    C_ref.sort_indices()
+    assert C.shape == C_ref.shape
+    _assert_smat_equal(C, C_ref)
+
+
+def test_sp_matmul_threshold_duplicates(rng):
+    A = sparse.random(100, 50, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(200, 50, density=0.1, format="csr", random_state=rng)
+    # split every element of A over two duplicate entries
+    A = sparse.csr_matrix((np.repeat(A.data / 2, 2), np.repeat(A.indices, 2), A.indptr * 2), shape=A.shape)
+    assert not A.has_canonical_format
+
+    C = sp_matmul_threshold(A, B, threshold=0.3)
+    C.sort_indices()
+    C_ref = A.dot(B.T).tocsr()
+    C_ref.data[C_ref.data <= 0.3] = 0
+    C_ref.eliminate_zeros()
+    C_ref.sort_indices()
+    _assert_smat_equal(C, C_ref)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+@pytest.mark.parametrize("ncols", [80, 2])
+def test_sp_matmul_topn_mutual(rng, dtype, n_threads, ncols):
+    A = sparse.random(100, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    # with fewer columns than `top_n` the column top n is still bounded by `top_n`
+    B = sparse.random(50, ncols, density=0.5, format="csr", dtype=dtype, random_state=rng)
+    top_n = 3
+
+    C_row = sp_matmul_topn(A, B, top_n=top_n)
+    C_col = sp_matmul_topn(B.T.tocsr(), A.T.tocsr(), top_n=top_n).T.tocsr()
+    C_mutual = C_row.multiply(C_col.astype(bool)).tocsr()
+    for mode, C_ref in (("row", C_row), ("column", C_col), ("mutual", C_mutual)):
+        C = sp_matmul_topn_mutual(A, B, top_n=top_n, mode=mode, n_threads=n_threads)
+        C.sort_indices()
+        C_ref.sort_indices()
+        assert C.shape == C_ref.shape
+        _assert_smat_equal(C, C_ref)
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_mutual(A, B, top_n=top_n, mode="both")
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_masked(rng, dtype, n_threads):
+    A = sparse.random(100, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(50, 80, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    M = sparse.random(100, 80, density=0.2, format="csr", random_state=rng)
+
+    C_ref = A.dot(B).tocsr()
+    C_ref = C_ref.multiply(M.astype(bool)).tocsr()
+    C = sp_matmul_masked(A, B, M, n_threads=n_threads)
+    assert C.shape == C_ref.shape
+    assert C.has_canonical_format
+    _assert_array_equal(C.toarray(), C_ref.toarray())
+    # only positions inside the mask are stored
+    assert not (C.astype(bool) > M.astype(bool)).nnz
+
+    # the mask can be passed in any format
+    C_csc = sp_matmul_masked(A, B, M.tocsc(), n_threads=n_threads)
+    _assert_array_equal(C_csc.toarray(), C_ref.toarray())
+
+    top_n = 3
+    C_topn = sp_matmul_masked(A, B, M, top_n=top_n, sort=True, n_threads=n_threads)
+    assert np.diff(C_topn.indptr).max() <= top_n
+    for i in range(C_topn.shape[0]):
+        row = np.sort(C_ref.data[C_ref.indptr[i] : C_ref.indptr[i + 1]])[::-1]
+        _assert_array_equal(C_topn.data[C_topn.indptr[i] : C_topn.indptr[i + 1]], row[row > 0][:top_n])
+
+    with pytest.raises(ValueError):
+        sp_matmul_masked(A, B, M[:10])
+    with pytest.raises(ValueError):
+        sp_matmul_masked(A, B, M, threshold=0.5)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_pairs(rng, dtype, n_threads):
+    A = sparse.random(100, 500, density=0.05, format="csr", dtype=dtype, random_state=rng)
+    # rows of very different lengths take the exponential search
+    A = sparse.vstack([np.ones((1, A.shape[1]), dtype=dtype), A], format="csr")
+    B = sparse.random(500, 80, density=0.05, format="csr", dtype=dtype, random_state=rng)
+    rows = rng.integers(0, A.shape[0], size=300)
+    cols = rng.integers(0, B.shape[1], size=300)
+
+    C_ref = A.dot(B).toarray()
+    values = sp_matmul_pairs(A, B, rows, cols, n_threads=n_threads)
+    assert values.dtype == dtype
+    _assert_array_equal(values, C_ref[rows, cols])
+
+    # B in the A * B.T orientation, CSC and unsorted operands
+    values = sp_matmul_pairs(A.tocsc(), B.T.tocsr(), rows, cols, n_threads=n_threads, idx_dtype=np.int64)
+    _assert_array_equal(values, C_ref[rows, cols])
+    # reverse the column indices of each row
+    order = np.concatenate([np.arange(A.indptr[i + 1] - 1, A.indptr[i] - 1, -1) for i in range(A.shape[0])])
+    A_unsorted = sparse.csr_matrix((A.data[order], A.indices[order], A.indptr), shape=A.shape)
+    assert not A_unsorted.has_sorted_indices
+    values = sp_matmul_pairs(A_unsorted, B.tocsc(), rows, cols)
+    _assert_array_equal(values, C_ref[rows, cols])
+
+    assert sp_matmul_pairs(A, B, [], []).size == 0
+    with pytest.raises(ValueError):
+        sp_matmul_pairs(A, B, rows, cols[:-1])
+    with pytest.raises(ValueError):
+        sp_matmul_pairs(A, B, [A.shape[0]], [0])
+    # the indices are validated when the product is all zeros
+    with pytest.raises(ValueError):
+        sp_matmul_pairs(sparse.csr_matrix(A.shape, dtype=A.dtype), B, [A.shape[0]], [0])
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+@pytest.mark.parametrize(("intermediate_top_n", "intermediate_threshold"), [(None, None), (5, None), (10, 0.2)])
+def test_sp_matmul_topn_chain(rng, dtype, n_threads, intermediate_top_n, intermediate_threshold):
+    A = sparse.random(100, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(50, 80, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    C = sparse.random(80, 60, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    top_n = 5
+
+    AB = sp_matmul_topn(A, B, top_n=intermediate_top_n or B.shape[1], threshold=intermediate_threshold)
+    Z_ref = sp_matmul_topn(AB, C, top_n=top_n, sort=True)
+    Z = sp_matmul_topn_chain(
+        A,
+        B,
+        C,
+        top_n=top_n,
+        intermediate_top_n=intermediate_top_n,
+        intermediate_threshold=intermediate_threshold,
+        sort=True,
+        n_threads=n_threads,
+    )
+    assert Z.shape == Z_ref.shape
+    _assert_smat_equal(Z, Z_ref)
+
+    # the operands can be passed in the transposed orientation
+    Z = sp_matmul_topn_chain(
+        A,
+        B,
+        C.T.tocsr(),
+        top_n=top_n,
+        intermediate_top_n=intermediate_top_n,
+        intermediate_threshold=intermediate_threshold,
+        sort=True,
+    )
+    assert Z.shape == Z_ref.shape
+    _assert_smat_equal(Z, Z_ref)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_topn_fields(rng, dtype, n_threads):
+    fields = [
+        (
+            sparse.random(100, n_inner, density=0.1, format="csr", dtype=dtype, random_state=rng),
+            sparse.random(n_inner, 80, density=0.1, format="csr", dtype=dtype, random_state=rng),
+            weight,
+        )
+        for n_inner, weight in ((50, 3), (20, 1), (70, 2))
+    ]
+    top_n = 5
+
+    C_ref = sum(weight * A.dot(B) for A, B, weight in fields)
+    C_ref = sp_matmul_topn(C_ref.tocsr(), sparse.identity(80, dtype=dtype, format="csr"), top_n=top_n, sort=True)
+    C = sp_matmul_topn_fields(fields, top_n=top_n, sort=True, n_threads=n_threads)
+    assert C.shape == C_ref.shape
+    _assert_smat_equal(C, C_ref)
+
+    # the B of a field can be passed in the A * B.T orientation
+    fields[0] = (fields[0][0], fields[0][1].T.tocsr(), fields[0][2])
+    C_transposed = sp_matmul_topn_fields(fields, top_n=top_n, sort=True, n_threads=n_threads)
+    _assert_array_equal(C_transposed.toarray(), C.toarray())
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_fields([], top_n=top_n)
+    with pytest.raises(ValueError):
+        sp_matmul_topn_fields([*fields, (fields[0][0][:10], fields[0][1], 1)], top_n=top_n)
+
+
+def _semiring_reference(A, B, semiring):
+    """Dense product over a semiring where only the stored elements contribute."""
+    A_mask = A.toarray() != 0
+    B_mask = B.toarray() != 0
+    A_dense = A.toarray()
+    B_dense = B.toarray()
+    C = np.full((A.shape[0], B.shape[1]), np.nan)
+    for i, k in product(range(A.shape[0]), range(B.shape[1])):
+        shared = A_mask[i] & B_mask[:, k]
+        if not shared.any():
+            continue
+        a, b = A_dense[i, shared], B_dense[shared, k]
+        if semiring == "max_times":
+            C[i, k] = (a * b).max()
+        elif semiring == "min_plus":
+            C[i, k] = (a + b).min()
+        else:
+            C[i, k] = np.minimum(a, b).sum()
+    return C
+
+
+@pytest.mark.parametrize("semiring", ["max_times", "min_plus", "plus_min"])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_topn_semiring(rng, semiring, n_threads):
+    A = sparse.random(40, 30, density=0.1, format="csr", dtype=np.float64, random_state=rng)
+    B = sparse.random(30, 50, density=0.1, format="csr", dtype=np.float64, random_state=rng)
+    top_n = 3
+    threshold = 1.0 if semiring == "min_plus" else 0.1
+
+    C = sp_matmul_topn_semiring(A, B, top_n=top_n, semiring=semiring, threshold=threshold, n_threads=n_threads)
+    C_ref = _semiring_reference(A, B, semiring)
+    assert C.shape == C_ref.shape
+    for i in range(C.shape[0]):
+        row = C_ref[i][~np.isnan(C_ref[i])]
+        if semiring == "min_plus":
+            row = np.sort(row[row < threshold])[:top_n]
+        else:
+            row = np.sort(row[row > threshold])[::-1][:top_n]
+        values = C.data[C.indptr[i] : C.indptr[i + 1]]
+        columns = C.indices[C.indptr[i] : C.indptr[i + 1]]
+        _assert_array_equal(np.sort(values), np.sort(row))
+        _assert_array_equal(values, C_ref[i, columns])
+
+    # the default semiring is the ordinary product
+    C = sp_matmul_topn_semiring(A, B, top_n=top_n, sort=True, n_threads=n_threads)
+    _assert_smat_equal(C, sp_matmul_topn(A, B, top_n=top_n, sort=True))
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_semiring(A, B, top_n=top_n, semiring="max_plus")
+
+
+@pytest.mark.parametrize("threshold", [None, np.iinfo(np.int32).min, np.iinfo(np.int32).max, 2**40])
+def test_sp_matmul_topn_semiring_min_plus_int(rng, threshold):
+    A = sparse.random(40, 30, density=0.1, format="csr", dtype=np.int32, random_state=rng)
+    B = sparse.random(30, 50, density=0.1, format="csr", dtype=np.int32, random_state=rng)
+    # small odd values, such that the sums do not overflow and no zeros are stored
+    A.data = rng.integers(-50, 50, size=A.data.size, dtype=np.int32) | 1
+    B.data = rng.integers(-50, 50, size=B.data.size, dtype=np.int32) | 1
+    top_n = 3
+
+    C = sp_matmul_topn_semiring(A, B, top_n=top_n, semiring="min_plus", threshold=threshold)
+    C_ref = _semiring_reference(A, B, "min_plus")
+    for i in range(C.shape[0]):
+        row = C_ref[i][~np.isnan(C_ref[i])]
+        if threshold is not None:
+            row = row[row < threshold]
+        row = np.sort(row)[:top_n]
+        values = C.data[C.indptr[i] : C.indptr[i + 1]]
+        _assert_array_equal(np.sort(values), row)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_topn_update(rng, dtype, n_threads):
+    A = sparse.random(100, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(200, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B_delta = sparse.random(20, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    tombstones = rng.choice(B.shape[0], size=30, replace=False)
+    top_n = 5
+
+    C = sp_matmul_topn(A, B, top_n=top_n)
+    C = sp_matmul_topn_update(C, A, B, top_n=top_n, B_delta=B_delta, tombstones=tombstones, n_threads=n_threads)
+
+    B_ref = B.tolil()
+    B_ref[tombstones] = 0
+    B_ref = sparse.vstack([B_ref.tocsr(), B_delta], format="csr")
+    C_ref = sp_matmul_topn(A, B_ref, top_n=top_n)
+    C.sort_indices()
+    C_ref.sort_indices()
+    assert C.shape == C_ref.shape
+    _assert_smat_equal(C, C_ref)
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_update(C, A, B, top_n=top_n, tombstones=[B.shape[0]])
+
+
+def test_sp_matmul_topn_update_no_refill(rng, monkeypatch):
+    A = sparse.random(100, 50, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(50, 200, density=0.1, format="csc", random_state=rng)
+    B_delta = sparse.random(50, 20, density=0.1, format="csr", random_state=rng)
+    C = sp_matmul_topn(A, B, top_n=5)
+    C_ref = sp_matmul_topn(A, sparse.hstack([B, B_delta], format="csr"), top_n=5)
+
+    # without refills `B` is not converted, so it is never transposed
+    def fail(*args, **kwargs):
+        raise AssertionError
+
+    monkeypatch.setattr(api, "_csr_transpose", fail)
+    C = sp_matmul_topn_update(C, A, B, top_n=5, B_delta=B_delta)
+    C.sort_indices()
+    C_ref.sort_indices()
+    _assert_smat_equal(C, C_ref)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_topn_components(rng, dtype, n_threads):
+    from scipy.sparse.csgraph import connected_components
+
+    A = sparse.random(200, 50, density=0.02, format="csr", dtype=dtype, random_state=rng)
+    top_n = 2
+    threshold = 0 if np.issubdtype(A.data.dtype, np.integer) else 0.1
+
+    C_ref = sp_matmul_topn(A, A, top_n=top_n, threshold=threshold, sort=True)
+    n_ref, labels_ref = connected_components(C_ref)
+    n, labels = sp_matmul_topn_components(A, A, top_n=top_n, threshold=threshold, n_threads=n_threads)
+    assert n == n_ref
+    _assert_array_equal(labels, labels_ref)
+
+    n, labels, C = sp_matmul_topn_components(
+        A, A, top_n=top_n, threshold=threshold, return_edges=True, n_threads=n_threads
+    )
+    assert n == n_ref
+    C_ref.sort_indices()
+    _assert_smat_equal(C, C_ref)
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_components(A, A[:100], top_n=top_n)
+
+
 @pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
 def test_sp_matmul_topn_density(rng, dtype):
     A = sparse.random(200, 200, density=0.9, format="csr", dtype=dtype, random_state=rng)
@@ -94,6 +504,35 @@ def test_sp_matmul_topn_density(rng, dtype):
     _assert_smat_equal(C, C_ref)
 
 
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+def test_sp_matmul_topn_density_bound(rng, dtype):
+    # mostly empty rows such that the upper bound is well below `top_n * nrows`
+    A = sparse.random(200, 100, density=0.01, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(100, 200, density=0.05, format="csr", dtype=dtype, random_state=rng)
+    C = sp_matmul_topn(A, B, top_n=10, sort=True)
+    C_ref = sp_matmul_topn(A, B, top_n=10, sort=True, density=1.0)
+    _assert_smat_equal(C, C_ref)
+
+
+def test_widen_indptr():
+    # only the index pointers are inspected, the rows of B are 2^30 long
+    row_len = 2**30
+    B_indptr = np.array([0, row_len, 2 * row_len - 1], dtype=np.int32)
+    A_indices = np.array([0, 1], dtype=np.int32)
+    A_indptr = np.array([0, 1, 2], dtype=np.int32)
+    A_ptr, B_ptr = _widen_indptr(A_indptr, A_indices, B_indptr, nrows=2, ncols=row_len)
+    assert A_ptr is A_indptr and B_ptr is B_indptr
+
+    A_indptr = np.array([0, 2, 4], dtype=np.int32)
+    A_indices = np.array([0, 1, 0, 1], dtype=np.int32)
+    A_ptr, B_ptr = _widen_indptr(A_indptr, A_indices, B_indptr, nrows=2, ncols=row_len)
+    assert A_ptr.dtype == np.int64 and B_ptr.dtype == np.int64
+    _assert_array_equal(B_ptr, B_indptr)
+    # the top-n product is bounded by `nrows * top_n`
+    A_ptr, B_ptr = _widen_indptr(A_indptr, A_indices, B_indptr, nrows=2, ncols=row_len, top_n=10)
+    assert A_ptr.dtype == np.int32 and B_ptr.dtype == np.int32
+
+
 @pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
 def test_sp_matmul_topn_threshold(rng, dtype):
     A = sparse.random(100, 100, density=0.1, format="csr", dtype=dtype, random_state=rng)
@@ -114,6 +553,22 @@ def test_sp_matmul_topn_idx_dtype(rng, dtype):
     _assert_smat_equal(C, C_ref)
 
 
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("n_threads", [None, 2])
+def test_sp_matmul_topn_mixed_idx_dtype(rng, dtype, n_threads):
+    A = sparse.random(100, 100, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(100, 100, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    C_ref = sp_matmul_topn(A, B, top_n=10, sort=True)
+
+    # the layout scipy uses for matrices with more than 2^31 non-zero elements
+    A.indptr = A.indptr.astype(np.int64)
+    B.indptr = B.indptr.astype(np.int64)
+    C = sp_matmul_topn(A, B, top_n=10, sort=True, n_threads=n_threads)
+    assert C.indptr.dtype == np.int64
+    assert C.indices.dtype == np.int32
+    _assert_smat_equal(C, C_ref)
+
+
 _FORMATS = ["coo", "csr", "csc"]
 
 
@@ -136,6 +591,17 @@ def test_sp_matmul_topn_transpose(rng):
     _assert_smat_equal(C, C_ref)
 
 
+@pytest.mark.parametrize("fmt", _FORMATS)
+@pytest.mark.parametrize("n_threads", [None, 2])
+def test_sp_matmul_topn_transposed_rhs(rng, fmt, n_threads):
+    A = sparse.random(200, 100, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(300, 100, density=0.1, format=fmt, random_state=rng)
+
+    C = sp_matmul_topn(A, B, top_n=10, sort=True, n_threads=n_threads)
+    C_ref = sp_matmul_topn(A, B.transpose().tocsr(), top_n=10, sort=True)
+    _assert_smat_equal(C, C_ref)
+
+
 _KWARGS = [
     {
         "A": {"m": 10, "n": 10, "density": 0.1, "format": "csr"},
@@ -188,6 +654,141 @@ def test_sp_matmul_topn_broadcasting(rng, kwargs):
     _assert_smat_equal(C, C_ref)
 
 
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+@pytest.mark.parametrize("sort", [False, True])
+def test_sp_matmul_topn_dense(rng, dtype, n_threads, sort):
+    # more rows and columns than a tile
+    Q = rng.standard_normal((150, 16)).astype(dtype)
+    E = rng.standard_normal((700, 16)).astype(dtype)
+    top_n = 5
+
+    C_ref = sp_matmul_topn(sparse.csr_matrix(Q), sparse.csr_matrix(E.T), top_n=top_n, threshold=0.5, sort=sort)
+    C = sp_matmul_topn_dense(Q, E, top_n=top_n, threshold=0.5, sort=sort, n_threads=n_threads)
+    assert C.shape == (Q.shape[0], E.shape[0])
+    assert C.dtype == dtype
+    if not sort:
+        assert C.has_canonical_format
+        C_ref.sort_indices()
+    _assert_smat_equal(C, C_ref, rtol=1e-4)
+
+    # E in the `A * B` orientation
+    C_t = sp_matmul_topn_dense(Q, E.T, top_n=top_n, threshold=0.5, sort=sort, n_threads=n_threads)
+    _assert_smat_equal(C_t, C)
+
+    # sparse A
+    A = sparse.random(150, 16, density=0.3, format="csr", dtype=dtype, random_state=rng)
+    C_ref = sp_matmul_topn(A, sparse.csr_matrix(E.T), top_n=top_n, sort=sort)
+    C = sp_matmul_topn_dense(A.tocsc(), E, top_n=top_n, sort=sort, n_threads=n_threads, idx_dtype=np.int64)
+    if not sort:
+        C_ref.sort_indices()
+    _assert_smat_equal(C, C_ref, rtol=1e-4)
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_dense(Q, E[:, :5], top_n=top_n)
+    with pytest.raises(TypeError):
+        sp_matmul_topn_dense(Q.astype(np.int32), E.astype(np.int32), top_n=top_n)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_topn_hybrid(rng, dtype, n_threads):
+    A = sparse.random(100, 50, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(50, 80, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    A_emb = rng.standard_normal((100, 8)).astype(dtype)
+    B_emb = rng.standard_normal((80, 8)).astype(dtype)
+    top_n = 4
+    alpha, beta = 0.7, 0.3
+
+    # the fused score over the columns set in A * B
+    pattern = (A.dot(B) != 0).toarray()
+    fused = alpha * A.dot(B).toarray() + beta * A_emb.dot(B_emb.T)
+    C = sp_matmul_topn_hybrid(A, B, A_emb, B_emb, top_n=top_n, alpha=alpha, beta=beta, sort=True, n_threads=n_threads)
+    assert C.shape == (100, 80)
+    assert C.dtype == dtype
+    for i in range(C.shape[0]):
+        row = np.sort(fused[i, pattern[i]])[::-1]
+        row = row[row > 0][:top_n]
+        cols = C.indices[C.indptr[i] : C.indptr[i + 1]]
+        _assert_array_equal(C.data[C.indptr[i] : C.indptr[i + 1]], row, rtol=1e-4)
+        _assert_array_equal(fused[i, cols], row, rtol=1e-4)
+
+    # B in the `A * B.T` orientation
+    C_t = sp_matmul_topn_hybrid(A, B.T.tocsr(), A_emb, B_emb, top_n=top_n, alpha=alpha, beta=beta, sort=True)
+    _assert_smat_equal(C_t, C, rtol=1e-4)
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_hybrid(A, B, A_emb, B_emb[:10], top_n=top_n)
+    with pytest.raises(ValueError):
+        sp_matmul_topn_hybrid(A, B, A_emb, B_emb[:, :4], top_n=top_n)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("n_threads", [None, 2])
+def test_sp_matmul_topn_coo(rng, dtype, n_threads):
+    A = sparse.random(100, 50, density=0.2, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(50, 100, density=0.2, format="csr", dtype=dtype, random_state=rng)
+    C_ref = sp_matmul_topn(A, B, top_n=10, sort=True)
+    C = sp_matmul_topn_coo(A, B, top_n=10, sort=True, n_threads=n_threads)
+    assert isinstance(C, sparse.coo_matrix)
+    assert C.dtype == dtype
+    _assert_array_equal(C.row, np.repeat(np.arange(A.shape[0]), np.diff(C_ref.indptr)))
+    _assert_array_equal(C.col, C_ref.indices)
+    _assert_array_equal(C.data, C_ref.data)
+
+
+@pytest.mark.parametrize("value_dtype", [np.float32, np.float64])
+def test_sp_matmul_topn_coo_value_dtype(rng, value_dtype):
+    A = sparse.random(100, 50, density=0.2, format="csr", dtype=np.float64, random_state=rng)
+    B = sparse.random(50, 100, density=0.2, format="csr", dtype=np.float64, random_state=rng)
+    C_ref = sp_matmul_topn(A, B, top_n=10, threshold=0.1)
+    C = sp_matmul_topn_coo(A, B, top_n=10, threshold=0.1, value_dtype=value_dtype)
+    assert C.data.dtype == value_dtype
+    _assert_array_equal(C.col, C_ref.indices)
+    _assert_array_equal(C.data, C_ref.data.astype(value_dtype))
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn_coo(A, B, top_n=10, value_dtype=np.int32)
+
+
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_sp_matmul_topn_acc_dtype(rng, n_threads):
+    # int32 counts in, float32 scores out
+    A = sparse.random(
+        100, 50, density=0.2, format="csr", dtype=np.int32, random_state=rng, data_rvs=lambda n: rng.integers(1, 5, n)
+    )
+    B = sparse.random(
+        50, 100, density=0.2, format="csr", dtype=np.int32, random_state=rng, data_rvs=lambda n: rng.integers(1, 5, n)
+    )
+    C_ref = sp_matmul_topn(A, B, top_n=10)
+    C = sp_matmul_topn(A, B, top_n=10, value_dtype=np.float32, n_threads=n_threads)
+    assert C.dtype == np.float32
+    _assert_array_equal(C.indptr, C_ref.indptr)
+    _assert_array_equal(C.indices, C_ref.indices)
+    _assert_array_equal(C.data, C_ref.data.astype(np.float32))
+
+    # float32 in, accumulated in float64 and returned as float64 or float32
+    A = sparse.random(100, 50, density=0.2, format="csr", dtype=np.float32, random_state=rng)
+    B = sparse.random(50, 100, density=0.2, format="csr", dtype=np.float32, random_state=rng)
+    C_ref = sp_matmul_topn(A.astype(np.float64), B.astype(np.float64), top_n=10, threshold=0.1, sort=True)
+    C = sp_matmul_topn(A, B, top_n=10, threshold=0.1, sort=True, acc_dtype=np.float64, n_threads=n_threads)
+    assert C.dtype == np.float64
+    _assert_array_equal(C.indptr, C_ref.indptr)
+    _assert_array_equal(C.indices, C_ref.indices)
+    _assert_array_equal(C.data, C_ref.data)
+    C = sp_matmul_topn(
+        A, B, top_n=10, threshold=0.1, sort=True, acc_dtype=np.float64, value_dtype=np.float32, n_threads=n_threads
+    )
+    assert C.dtype == np.float32
+    _assert_array_equal(C.indices, C_ref.indices)
+    _assert_array_equal(C.data, C_ref.data.astype(np.float32))
+
+    with pytest.raises(ValueError):
+        sp_matmul_topn(A.astype(np.float64), B.astype(np.float64), top_n=10, acc_dtype=np.float32)
+    with pytest.raises(ValueError):
+        sp_matmul_topn(A, B, top_n=10, value_dtype=np.int32)
+
+
 @pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
 def test_zip_sp_matmul_topn(rng, dtype):
     # matching 100 names against 600 gt-names, where gt has been split into three parts
@@ -212,6 +813,65 @@ def test_zip_sp_matmul_topn(rng, dtype):
     _assert_array_equal(C_zip.indices, C_ref.indices)
 
 
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("n_threads", [1, 2])
+def test_zip_accumulator(rng, dtype, n_threads):
+    A = sparse.random(100, 2000, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(600, 2000, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    Bs = [B[:100], B[100:300], B[300:]]
+    Cs = [sp_matmul_topn(A, Bi.T, top_n=10, threshold=0.01, sort=True) for Bi in Bs]
+    C_ref = zip_sp_matmul_topn(top_n=10, C_mats=Cs)
+
+    acc = ZipAccumulator(top_n=10, nrows=A.shape[0], n_threads=n_threads)
+    for C_i in Cs:
+        acc.add(C_i)
+    assert acc.ncols == B.shape[0]
+    C_zip = acc.finalize()
+
+    assert C_zip.shape == C_ref.shape
+    # the result is exactly sized
+    assert C_zip.data.size == C_zip.indices.size == C_zip.indptr[-1]
+    _assert_array_equal(C_zip.indptr, C_ref.indptr)
+    _assert_array_equal(C_zip.data, C_ref.data)
+    _assert_array_equal(C_zip.indices, C_ref.indices)
+
+    with pytest.raises(ValueError):
+        acc.add(Cs[0])
+    with pytest.raises(ValueError):
+        ZipAccumulator(top_n=10, nrows=A.shape[0] + 1).add(Cs[0])
+
+
+def test_zip_accumulator_concurrent(rng):
+    A = sparse.random(100, 2000, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(800, 2000, density=0.1, format="csr", random_state=rng)
+    Cs = [sp_matmul_topn(A, B[i : i + 100].T, top_n=10, sort=True) for i in range(0, 800, 100)]
+    C_ref = zip_sp_matmul_topn(top_n=10, C_mats=Cs)
+
+    acc = ZipAccumulator(top_n=10, nrows=A.shape[0])
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        list(pool.map(acc.add, Cs))
+    assert acc.ncols == B.shape[0]
+    C_zip = acc.finalize()
+
+    # the column offsets follow the order in which the sub-matrices were merged, the values do not
+    _assert_array_equal(C_zip.indptr, C_ref.indptr)
+    _assert_array_equal(C_zip.data, C_ref.data)
+
+
+@pytest.mark.parametrize("idx_dtype", [np.int32, np.int64])
+def test_zip_accumulator_idx_dtype(rng, idx_dtype):
+    A = sparse.random(100, 2000, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(600, 2000, density=0.1, format="csr", random_state=rng)
+    Cs = [sp_matmul_topn(A, Bi.T, top_n=10, sort=True) for Bi in (B[:100], B[100:])]
+    C_ref = zip_sp_matmul_topn(top_n=10, C_mats=Cs)
+
+    acc = ZipAccumulator(top_n=10, nrows=A.shape[0], idx_dtype=idx_dtype)
+    for C_i in Cs:
+        acc.add(C_i)
+    C_zip = acc.finalize()
+    _assert_smat_equal(C_zip, C_ref)
+
+
 @pytest.mark.skipif(sys.version_info < (3, 9), reason="not all dtypes supported in scipy vstack for python 3.8")
 @pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
 def test_stack_zip_sp_matmul_topn(rng, dtype):
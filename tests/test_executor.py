@@ -0,0 +1,46 @@
+import multiprocessing
+
+import numpy as np
+import pytest
+from scipy import sparse
+from sparse_dot_topn import sp_matmul_topn
+from sparse_dot_topn.executor import sp_matmul_topn_mp
+
+from ._resources import _assert_smat_equal
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+def test_sp_matmul_topn_mp(rng, dtype):
+    A = sparse.random(200, 100, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(100, 300, density=0.1, format="csr", dtype=dtype, random_state=rng)
+
+    C_ref = sp_matmul_topn(A, B, top_n=10)
+    C = sp_matmul_topn_mp(A, B, top_n=10, n_workers=2, block_size=33)
+    _assert_smat_equal(C, C_ref)
+
+
+@pytest.mark.parametrize("start_method", multiprocessing.get_all_start_methods())
+def test_sp_matmul_topn_mp_sorted(rng, start_method):
+    A = sparse.random(200, 100, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(300, 100, density=0.1, format="csr", random_state=rng)
+
+    C_ref = sp_matmul_topn(A, B, top_n=10, threshold=0.1, sort=True)
+    C = sp_matmul_topn_mp(
+        A, B, top_n=10, threshold=0.1, sort=True, n_workers=2, mp_context=multiprocessing.get_context(start_method)
+    )
+    _assert_smat_equal(C, C_ref)
+
+
+@pytest.mark.parametrize("idx_dtype", [None, np.int32, np.int64])
+def test_sp_matmul_topn_mp_idx_dtype(rng, idx_dtype):
+    A = sparse.random(200, 100, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(100, 300, density=0.1, format="csr", random_state=rng)
+    for M in (A, B):
+        M.indptr = M.indptr.astype(np.int64)
+        M.indices = M.indices.astype(np.int64)
+
+    C_ref = sp_matmul_topn(A, B, top_n=10, idx_dtype=idx_dtype)
+    C = sp_matmul_topn_mp(A, B, top_n=10, n_workers=2, block_size=33, idx_dtype=idx_dtype)
+    assert C.indptr.dtype == C_ref.indptr.dtype
+    assert C.indices.dtype == C_ref.indices.dtype
+    _assert_smat_equal(C, C_ref)
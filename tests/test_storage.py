@@ -0,0 +1,116 @@
+import numpy as np
+import pytest
+from scipy import sparse
+from sparse_dot_topn import api, sp_matmul_topn, sp_matmul_topn_chunked, sp_matmul_topn_sharded
+from sparse_dot_topn.storage import CSRWriter, load_csr, load_csr_shards, save_csr, save_csr_shards
+
+from ._resources import _assert_array_equal, _assert_smat_equal
+
+
+@pytest.mark.parametrize("mmap", [True, False])
+def test_save_load_csr(rng, tmp_path, mmap):
+    M = sparse.random(100, 200, density=0.1, format="csr", random_state=rng)
+    save_csr(tmp_path / "M", M)
+    _assert_smat_equal(load_csr(tmp_path / "M", mmap=mmap), M)
+    # the members are compatible with `scipy.sparse.save_npz`
+    assert set(p.name for p in (tmp_path / "M").iterdir()) == {
+        "data.npy",
+        "indices.npy",
+        "indptr.npy",
+        "format.npy",
+        "shape.npy",
+    }
+
+
+def test_save_csr_shards(rng, tmp_path):
+    B = sparse.random(250, 100, density=0.1, format="csr", random_state=rng)
+    save_csr_shards(B, tmp_path, shard_size=100)
+    shards = list(load_csr_shards(tmp_path))
+    assert [offset for offset, _ in shards] == [0, 100, 200]
+    for offset, B_j_T in shards:
+        _assert_smat_equal(B_j_T, B[offset : offset + 100].transpose().tocsr())
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("mmap", [True, False])
+def test_sp_matmul_topn_sharded(rng, tmp_path, dtype, mmap):
+    A = sparse.random(100, 2000, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(600, 2000, density=0.1, format="csr", dtype=dtype, random_state=rng)
+
+    C_ref = sp_matmul_topn(A, B.T, top_n=10, threshold=0.01, sort=True)
+
+    save_csr_shards(B, tmp_path, shard_size=250)
+    C = sp_matmul_topn_sharded(A, tmp_path, top_n=10, threshold=0.01, mmap=mmap)
+    assert C.shape == C_ref.shape
+    _assert_array_equal(C.indptr, C_ref.indptr)
+    _assert_array_equal(C.data, C_ref.data)
+    _assert_array_equal(C.indices, C_ref.indices)
+
+
+@pytest.mark.parametrize("idx_dtype", [np.int32, np.int64])
+def test_sp_matmul_topn_sharded_idx_dtype(rng, tmp_path, idx_dtype):
+    A = sparse.random(100, 2000, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(600, 2000, density=0.1, format="csr", random_state=rng)
+
+    C_ref = sp_matmul_topn(A, B.T, top_n=10, threshold=0.01, sort=True, idx_dtype=idx_dtype)
+
+    save_csr_shards(B, tmp_path, shard_size=250)
+    C = sp_matmul_topn_sharded(A, tmp_path, top_n=10, threshold=0.01, idx_dtype=idx_dtype)
+    _assert_smat_equal(C, C_ref)
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64, np.int32, np.int64])
+@pytest.mark.parametrize("n_threads", [None, 2])
+def test_sp_matmul_topn_chunked_callback(rng, dtype, n_threads):
+    A = sparse.random(250, 100, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    B = sparse.random(100, 300, density=0.1, format="csr", dtype=dtype, random_state=rng)
+    C_ref = sp_matmul_topn(A, B, top_n=10, n_threads=n_threads)
+
+    blocks = []
+
+    def sink(start, data, indices, indptr):
+        blocks.append(sparse.csr_matrix((data, indices, indptr), shape=(indptr.size - 1, B.shape[1])))
+        assert start == sum(block.shape[0] for block in blocks[:-1])
+
+    assert sp_matmul_topn_chunked(A, B, top_n=10, sink=sink, block_size=100, n_threads=n_threads) is None
+    assert [block.shape[0] for block in blocks] == [100, 100, 50]
+    _assert_smat_equal(sparse.vstack(blocks, format="csr"), C_ref)
+
+
+@pytest.mark.parametrize("sort", [True, False])
+def test_sp_matmul_topn_chunked_disk(rng, tmp_path, sort):
+    A = sparse.random(250, 100, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(100, 300, density=0.1, format="csr", random_state=rng)
+    C_ref = sp_matmul_topn(A, B, top_n=10, threshold=0.1, sort=sort)
+
+    path = sp_matmul_topn_chunked(A, B, top_n=10, sink=tmp_path / "C", block_size=64, threshold=0.1, sort=sort)
+    C = load_csr(path)
+    assert C.shape == C_ref.shape
+    _assert_smat_equal(C, C_ref)
+    # the stored arrays are regular `.npy` files
+    _assert_array_equal(np.load(path / "data.npy"), C_ref.data)
+
+
+def test_sp_matmul_topn_chunked_disk_error(rng, tmp_path, monkeypatch):
+    A = sparse.random(250, 100, density=0.1, format="csr", random_state=rng)
+    B = sparse.random(100, 300, density=0.1, format="csr", random_state=rng)
+
+    func = api._core.sp_matmul_topn
+    calls = []
+
+    def failing(**kwargs):
+        calls.append(None)
+        if len(calls) > 1:
+            raise MemoryError
+        return func(**kwargs)
+
+    monkeypatch.setattr(api._core, "sp_matmul_topn", failing)
+    with pytest.raises(MemoryError):
+        sp_matmul_topn_chunked(A, B, top_n=10, sink=tmp_path / "C", block_size=64)
+    # a partial result is discarded rather than finalised
+    assert not (tmp_path / "C").exists()
+
+
+def test_csr_writer_order(tmp_path):
+    with CSRWriter(tmp_path, ncols=10, dtype=np.float64) as writer, pytest.raises(ValueError):
+        writer(5, np.zeros(0), np.zeros(0, dtype=np.int64), np.zeros(2, dtype=np.int64))
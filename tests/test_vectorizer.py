@@ -0,0 +1,90 @@
+import math
+from collections import Counter
+
+import numpy as np
+import pytest
+from scipy import sparse
+from sparse_dot_topn import NgramTfidfVectorizer
+from sparse_dot_topn.lib import _sparse_dot_topn_core as _core
+
+from ._resources import _assert_smat_equal
+
+NAMES = [
+    "ing bank",
+    "ing bank n.v.",
+    "Bank of Ireland",
+    "société générale",
+    "societe generale",
+    "ab",
+    "",
+    "北京银行",
+]
+
+
+def _reference_tfidf(docs, n, sublinear_tf):
+    """TF-IDF as `TfidfVectorizer(analyzer="char", ngram_range=(n, n))` with the default smoothing and norm."""
+    grams = [[doc[k : k + n] for k in range(len(doc) - n + 1)] for doc in docs]
+    vocab = sorted({g for gs in grams for g in gs})
+    columns = {g: k for k, g in enumerate(vocab)}
+    df = Counter(g for gs in grams for g in set(gs))
+    M = sparse.lil_matrix((len(docs), len(vocab)))
+    for i, gs in enumerate(grams):
+        row = {}
+        for g, tf in Counter(gs).items():
+            tf = 1 + math.log(tf) if sublinear_tf else tf
+            row[columns[g]] = tf * (math.log((1 + len(docs)) / (1 + df[g])) + 1)
+        norm = math.sqrt(sum(v * v for v in row.values()))
+        for k, v in row.items():
+            M[i, k] = v / norm
+    return vocab, M.tocsr()
+
+
+@pytest.mark.parametrize("n", [1, 3])
+@pytest.mark.parametrize("n_threads", [1, 2])
+@pytest.mark.parametrize("sublinear_tf", [False, True])
+def test_ngram_tfidf_vectorizer(n, n_threads, sublinear_tf):
+    vectorizer = NgramTfidfVectorizer(n=n, sublinear_tf=sublinear_tf, n_threads=n_threads)
+    A = vectorizer.fit_transform(NAMES)
+    vocab, A_ref = _reference_tfidf([name.lower() for name in NAMES], n, sublinear_tf)
+
+    assert list(vectorizer.get_feature_names_out()) == vocab
+    assert A.shape == A_ref.shape
+    assert A.indices.dtype == np.int32
+    assert A.has_canonical_format
+    A_ref.sort_indices()
+    _assert_smat_equal(A, A_ref)
+
+    # n-grams outside the vocabulary are ignored
+    B = vectorizer.transform(["ing bank", "zzzz"])
+    _assert_smat_equal(B[0], A[0])
+    assert B[1].nnz == 0
+
+
+@pytest.mark.parametrize("dtype", [np.float32, np.float64])
+def test_ngram_tfidf_vectorizer_hashed(dtype):
+    vectorizer = NgramTfidfVectorizer(n=3, n_features=2**10, use_idf=False, dtype=dtype, idx_dtype=np.int64)
+    A = vectorizer.transform(NAMES)
+    assert A.shape == (len(NAMES), 2**10)
+    assert A.dtype == dtype
+    # the rows with n-grams have unit norm
+    norms = np.sqrt(np.asarray(A.multiply(A).sum(axis=1))).ravel()
+    np.testing.assert_allclose(norms[np.diff(A.indptr) > 0], 1.0, rtol=1e-5)
+
+
+@pytest.mark.parametrize("idx_dtype", [None, np.int32])
+def test_ngram_tfidf_vectorizer_widen_indptr(idx_dtype):
+    vectorizer = NgramTfidfVectorizer(n=3, idx_dtype=idx_dtype)
+    assert vectorizer._core_func(100) is _core.ngram_tfidf_float64_int32_int32
+    # the index pointers are widened when the number of n-grams can exceed the range of the indices
+    assert vectorizer._core_func(np.iinfo(np.int32).max + 1) is _core.ngram_tfidf_float64_int32_int64
+
+
+def test_ngram_tfidf_vectorizer_invalid():
+    with pytest.raises(ValueError):
+        NgramTfidfVectorizer(n=0)
+    with pytest.raises(ValueError):
+        NgramTfidfVectorizer(norm="l1")
+    with pytest.raises(TypeError):
+        NgramTfidfVectorizer(dtype=np.int32)
+    with pytest.raises(ValueError):
+        NgramTfidfVectorizer().transform(NAMES)